@@ -1,10 +1,13 @@
 #ifndef ANIMATIONCAR_H
 #define ANIMATIONCAR_H
 #include "car.h"
+#include "frustum.h"
 #include <cstdlib>
 #include <ctime>
+#include "renderstate.h"
+#include "renderqueue.h"
 
-class AnimationCar {
+class AnimationCar : public Drawable {
 private:
     static const int NUM_CARS = 7;
     Car cars[NUM_CARS];
@@ -31,6 +34,12 @@ private:
     // Colores para diferenciar los carros
     float carColors[NUM_CARS][3];
     
+    // Detalle de las ruedas de cada carro segn lo grandes que se ven
+    LevelOfDetail carLod[NUM_CARS];
+    
+    // Carros fuera de la cmara en el ltimo draw()
+    int culledCount;
+    
     // Funcin helper para generar nmeros aleatorios
     float randomFloat(float min, float max) {
         return min + (float(rand()) / float(RAND_MAX)) * (max - min);
@@ -47,6 +56,7 @@ public:
         srand(static_cast<unsigned int>(time(0)));
         
         autoMove = true;
+        culledCount = 0;
         squareSize = 60.0f;
         baseMoveSpeed = 0.05f;
         minSeparation = 55.0f;   // Separacin mnima inicial ms grande
@@ -93,6 +103,7 @@ public:
         srand(static_cast<unsigned int>(time(0)));
         
         autoMove = true;
+        culledCount = 0;
         squareSize = size;
         baseMoveSpeed = speed;
         minSeparation = 20.0f;   // Separacin mnima inicial ms grande
@@ -292,19 +303,39 @@ public:
         }
     }
     
-    // Funcin para dibujar todos los carros con animacin
+    // Funcin para dibujar todos los carros con animacin: una sola tanda
+    // para los que estn en cmara, cada uno con su posicin, su color y el
+    // giro de sus ruedas
     void draw() {
+        // Con la misma matriz con la que se dibujan, as los planos quedan en coordenadas de la pista
+        Frustum frustum;
+        ScreenProjection screen;
+        CarInstance instances[NUM_CARS];
+        int count = 0;
+        culledCount = 0;
         for(int i = 0; i < NUM_CARS; i++) {
-            glPushMatrix();
-            
-            // Aplicar color especfico para cada carro
-            glColor3f(carColors[i][0], carColors[i][1], carColors[i][2]);
-            
-            // Dibujar el carro en su posicin
-            cars[i].drawAt(carPosX[i], 0, carPosZ[i], carAngle[i]);
-            
-            glPopMatrix();
+            if (!frustum.sphereVisible(carPosX[i], 0.0f, carPosZ[i], Car::BOUNDING_RADIUS)) {
+                culledCount++;
+                continue;
+            }
+            CarInstance& instance = instances[count++];
+            instance.x = carPosX[i];
+            instance.y = 0.0f;
+            instance.z = carPosZ[i];
+            instance.angle = carAngle[i];
+            instance.color[0] = carColors[i][0];
+            instance.color[1] = carColors[i][1];
+            instance.color[2] = carColors[i][2];
+            instance.wheelRotation = cars[i].getWheelRotation();
+            instance.wheelDetail = carLod[i].select(
+                screen.pixelRadius(carPosX[i], 0.0f, carPosZ[i], Car::BOUNDING_RADIUS));
         }
+        Car::drawInstances(instances, count);
+    }
+
+    // Para la cola de dibujo: todos los carros son una sola pieza
+    virtual void drawPart(int part) {
+        draw();
     }
     
     // Funcin para pausar/reanudar la animacin
@@ -359,6 +390,7 @@ public:
     
     // Getters existentes
     bool isAnimating() const { return autoMove; }
+    int getCulledCount() const { return culledCount; }
     int getNumCars() const { return NUM_CARS; }
     float getSquareSize() const { return squareSize; }
     float getMoveSpeed() const { return baseMoveSpeed; }
@@ -410,7 +442,7 @@ public:
     
     // Funcin para dibujar las lneas de la ruta
     void drawPath() {
-        glColor3f(1.0f, 1.0f, 1.0f);
+        RenderState::color(1.0f, 1.0f, 1.0f);
         glLineWidth(2.0f);
         glBegin(GL_LINE_LOOP);
         glVertex3f(-squareSize, -0.01f, -squareSize);
@@ -7,11 +7,15 @@
 #include <cmath>
 #include <iostream>
 #include "texture.h"
+#include "textureatlas.h"
+#include "primitivecache.h"
+#include "renderstate.h"
+#include "renderqueue.h"
 
 // Barrel Class - Simplified and focused on geometry
-class Barril {
+class Barril : public Drawable {
 private:
-    GLuint textureID;
+    AtlasRegion texture;   // Its rectangle in the prop atlas, or a texture of its own
     float height;
     float baseRadius;
     float midRadius;
@@ -34,7 +38,7 @@ private:
 
     // Reset OpenGL state to neutral
     void resetGLState() {
-        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+        RenderState::color(1.0f, 1.0f, 1.0f, 1.0f);
         
         GLfloat white[4] = {1.0f, 1.0f, 1.0f, 1.0f};
         GLfloat black[4] = {0.0f, 0.0f, 0.0f, 1.0f};
@@ -49,39 +53,21 @@ private:
 
     // Draws a circle on the XZ plane with normals for shading
     void drawCircle(float radius, float y, int segments, bool top) {
-        glBegin(GL_TRIANGLE_FAN);
-        if (top) {
-            glNormal3f(0.0f, 1.0f, 0.0f);
-            if (textureLoaded) {
-                glTexCoord2f(0.5f, 0.5f);
-            }
-            glVertex3f(0.0f, y, 0.0f);
-        } else {
-            glNormal3f(0.0f, -1.0f, 0.0f);
-            if (textureLoaded) {
-                glTexCoord2f(0.5f, 0.5f);
-            }
-            glVertex3f(0.0f, y, 0.0f);
-        }
-
-        for (int i = 0; i <= segments; i++) {
-            float angle = 2.0f * static_cast<float>(M_PI) * i / segments;
-            float x = radius * cos(angle);
-            float z = radius * sin(angle);
-            
-            if (textureLoaded) {
-                glTexCoord2f(0.5f + 0.5f * (x / radius), 0.5f + 0.5f * (z / radius));
-            }
-            glVertex3f(x, y, z);
+        glPushMatrix();
+        glTranslatef(0.0f, y, 0.0f);
+        if (!top) {
+            // Misma malla con la normal hacia abajo
+            glScalef(1.0f, -1.0f, 1.0f);
         }
-        glEnd();
+        PrimitiveCache::drawDisk(radius, segments);
+        glPopMatrix();
     }
 
     // Draws the curved body of the barrel
     void drawBody() {
         if (textureLoaded) {
-            TextureManager::bindTexture(textureID);
-            glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+            texture.bind();
+            RenderState::color(1.0f, 1.0f, 1.0f, 1.0f);
             resetGLState();
         } else {
             TextureManager::unbindTexture();
@@ -117,7 +103,7 @@ private:
 
     // Draws the metallic bands of the barrel
     void drawBands() {
-        TextureManager::unbindTexture();
+        texture.unbind();
         
         // Set metallic material properties
         setMaterial(0.4f, 0.4f, 0.4f, 0.5f, 0.5f, 0.5f, 50.0f);
@@ -148,8 +134,8 @@ private:
     // Draws the top and bottom caps of the barrel
     void drawCaps() {
         if (textureLoaded) {
-            TextureManager::bindTexture(textureID);
-            glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+            texture.bind();
+            RenderState::color(1.0f, 1.0f, 1.0f, 1.0f);
             resetGLState();
         } else {
             TextureManager::unbindTexture();
@@ -166,23 +152,21 @@ private:
 
 public:
     // Constructor with automatic texture loading
-    Barril() : textureID(0), height(2.0f), baseRadius(0.6f), midRadius(0.8f), segments(32), rings(20), textureLoaded(false) {
+    Barril() : height(2.0f), baseRadius(0.6f), midRadius(0.8f), segments(32), rings(20), textureLoaded(false) {
         loadTexture("barriltexture.bmp");
     }
 
     // Constructor with custom texture path
-    Barril(const char* texturePath) : textureID(0), height(2.0f), baseRadius(0.6f), midRadius(0.8f), segments(32), rings(20), textureLoaded(false) {
+    Barril(const char* texturePath) : height(2.0f), baseRadius(0.6f), midRadius(0.8f), segments(32), rings(20), textureLoaded(false) {
         loadTexture(texturePath);
     }
 
     // Load texture method
     void loadTexture(const char* texturePath) {
-        if (textureID != 0) {
-            TextureManager::deleteTexture(textureID);
-        }
+        PropAtlas::unload(texture);
         
-        textureID = TextureManager::loadTexture(texturePath);
-        textureLoaded = (textureID != 0);
+        texture = PropAtlas::load(texturePath);
+        textureLoaded = (texture.texture != 0);
         
         if (!textureLoaded) {
             std::cerr << "Failed to load barrel texture: " << texturePath << std::endl;
@@ -200,6 +184,11 @@ public:
         return textureLoaded;
     }
 
+    // Texture used by render(), 0 if none (sort key for the render queue)
+    GLuint getTextureID() const {
+        return textureLoaded ? texture.texture : 0;
+    }
+
     // Setters for customization
     void setDimensions(float h, float baseR, float midR) {
         height = h;
@@ -214,7 +203,7 @@ public:
 
     // Render the complete barrel
     void render() {
-        glPushAttrib(GL_ALL_ATTRIB_BITS);
+        RenderState::pushAttrib(GL_ALL_ATTRIB_BITS);
         glPushMatrix();
 
         resetGLState();
@@ -224,12 +213,17 @@ public:
         drawBands();
 
         glPopMatrix();
-        glPopAttrib();
+        RenderState::popAttrib();
+    }
+
+    // Render queue entry point: the whole object is a single part
+    virtual void drawPart(int part) {
+        render();
     }
 
     // Destructor to clean up OpenGL resources
     ~Barril() {
-        TextureManager::deleteTexture(textureID);
+        PropAtlas::unload(texture);
     }
 };
 
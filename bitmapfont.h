@@ -0,0 +1,383 @@
+#ifndef BITMAPFONT_H
+#define BITMAPFONT_H
+
+#include <GL/glut.h>
+#include <GL/freeglut.h>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include "glextensions.h"
+#include "renderstate.h"
+
+// Texto con las fuentes bitmap de GLUT, pero dibujado con una textura: cada
+// fuente se copia una vez a un atlas de 16x16 celdas (una por carcter) y un
+// texto es un solo glDrawArrays de quads en lugar de un glBitmap por letra.
+// Los quads de cada texto se arman una vez y quedan guardados, as un texto
+// que no cambia (los controles, el men) no se vuelve a armar. Cuando el
+// cach de una fuente se llena se descarta el texto usado hace ms tiempo,
+// que es el que cambia cada frame (la posicin del HUD), no los fijos.
+//
+// Las coordenadas son las de glRasterPos: (x, y) es el inicio de la lnea
+// base, con una proyeccin ortogrfica de un pixel por unidad. Sirve tanto
+// con el eje Y hacia arriba como hacia abajo.
+class BitmapFont {
+private:
+    static const int PADDING = 2;       // Margen de cada celda para lo que se sale del avance
+    static const int COLUMNS = 16;
+    static const int FIRST_CHAR = 32;   // Antes del espacio no hay nada que dibujar
+    static const size_t MAX_CACHED = 64;
+    static const int GLYPH_TARGET_SIZE = 128;   // Framebuffer fuera de pantalla donde se dibuja cada carcter
+
+    // Quads de un texto: x, y, u, v por vrtice, con la lnea base en y = 0
+    struct Layout {
+        int width;
+        unsigned int lastUsed;          // Reloj del atlas en el ltimo uso
+        std::vector<GLfloat> vertices;
+    };
+
+    struct Atlas {
+        void* font;
+        GLuint texture;
+        int cellWidth;
+        int cellHeight;
+        int baseline;                   // Altura de la lnea base dentro de la celda
+        int textureWidth;
+        int textureHeight;
+        int advance[256];
+        std::map<std::string, Layout> layouts;
+        unsigned int clock;             // Avanza con cada texto pedido
+    };
+
+    static std::vector<Atlas> atlases;
+    static bool prepared;
+
+    static int nextPowerOfTwo(int value) {
+        int result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    static Atlas* findAtlas(void* font) {
+        for (size_t i = 0; i < atlases.size(); i++) {
+            if (atlases[i].font == font) return &atlases[i];
+        }
+        return NULL;
+    }
+
+    // Dibujar cada carcter en la esquina del framebuffer enlazado y copiarlo a su celda
+    static void buildAtlas(Atlas& atlas, int viewportWidth, int viewportHeight) {
+        atlas.texture = 0;
+
+        int height = glutBitmapHeight(atlas.font);
+        int descent = (height + 3) / 4;
+        int maxAdvance = 0;
+        for (int c = 0; c < 256; c++) {
+            atlas.advance[c] = glutBitmapWidth(atlas.font, c);
+            if (atlas.advance[c] > maxAdvance) maxAdvance = atlas.advance[c];
+        }
+
+        atlas.cellWidth = maxAdvance + 2 * PADDING;
+        atlas.cellHeight = height + 2 * PADDING;
+        atlas.baseline = PADDING + descent;
+        atlas.textureWidth = nextPowerOfTwo(COLUMNS * atlas.cellWidth);
+        atlas.textureHeight = nextPowerOfTwo((256 / COLUMNS) * atlas.cellHeight);
+
+        if (height <= 0 || atlas.cellWidth > viewportWidth || atlas.cellHeight > viewportHeight) {
+            printf("Error: No se pudo armar el atlas de la fuente (celda de %dx%d)\n",
+                   atlas.cellWidth, atlas.cellHeight);
+            return;
+        }
+
+        glGenTextures(1, &atlas.texture);
+        RenderState::bindTexture(atlas.texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+
+        std::vector<GLubyte> empty(atlas.textureWidth * atlas.textureHeight, 0);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_INTENSITY, atlas.textureWidth, atlas.textureHeight, 0,
+                     GL_LUMINANCE, GL_UNSIGNED_BYTE, &empty[0]);
+
+        glScissor(0, 0, atlas.cellWidth, atlas.cellHeight);
+        for (int c = FIRST_CHAR; c < 256; c++) {
+            if (atlas.advance[c] <= 0) continue;
+
+            glClear(GL_COLOR_BUFFER_BIT);
+            glRasterPos2i(PADDING, atlas.baseline);
+            glutBitmapCharacter(atlas.font, c);
+
+            int column = c % COLUMNS;
+            int row = c / COLUMNS;
+            glCopyTexSubImage2D(GL_TEXTURE_2D, 0, column * atlas.cellWidth, row * atlas.cellHeight,
+                                0, 0, atlas.cellWidth, atlas.cellHeight);
+        }
+    }
+
+    // Una ventana tapada o que todava no se muestra puede no guardar lo que se
+    // dibuja en ella (prueba de pertenencia de pixels) y dejar basura en las
+    // celdas. Cada carcter visible de ASCII tiene que haber dejado algo y el
+    // espacio nada; si no, el atlas no sirve.
+    static bool checkAtlas(const Atlas& atlas) {
+        std::vector<GLubyte> pixels(atlas.textureWidth * atlas.textureHeight);
+        RenderState::bindTexture(atlas.texture);
+        glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, &pixels[0]);
+        glPopClientAttrib();
+
+        for (int c = FIRST_CHAR; c < 127; c++) {
+            if (atlas.advance[c] <= 0) continue;
+
+            bool ink = false;
+            int left = (c % COLUMNS) * atlas.cellWidth;
+            int bottom = (c / COLUMNS) * atlas.cellHeight;
+            for (int y = bottom; y < bottom + atlas.cellHeight && !ink; y++) {
+                for (int x = left; x < left + atlas.cellWidth; x++) {
+                    if (pixels[y * atlas.textureWidth + x] != 0) {
+                        ink = true;
+                        break;
+                    }
+                }
+            }
+            if (ink != (c != ' ')) return false;
+        }
+        return true;
+    }
+
+    // Framebuffer propio para armar los atlas sin depender de la ventana; 0 si
+    // el driver no tiene framebuffer objects
+    static GLuint createGlyphTarget(GLuint& renderbuffer) {
+        renderbuffer = 0;
+        GLExtensions::load();
+        if (!GLExtensions::hasFramebuffers()) return 0;
+
+        GLuint framebuffer = 0;
+        GLExtensions::genFramebuffers(1, &framebuffer);
+        GLExtensions::genRenderbuffers(1, &renderbuffer);
+        GLExtensions::bindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+        GLExtensions::renderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, GLYPH_TARGET_SIZE, GLYPH_TARGET_SIZE);
+        GLExtensions::bindRenderbuffer(GL_RENDERBUFFER, 0);
+        GLExtensions::bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        GLExtensions::framebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffer);
+
+        if (GLExtensions::checkFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            destroyGlyphTarget(framebuffer, renderbuffer);
+            return 0;
+        }
+        return framebuffer;
+    }
+
+    static void destroyGlyphTarget(GLuint& framebuffer, GLuint& renderbuffer) {
+        GLExtensions::bindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLExtensions::deleteFramebuffers(1, &framebuffer);
+        GLExtensions::deleteRenderbuffers(1, &renderbuffer);
+        framebuffer = renderbuffer = 0;
+    }
+
+    static const Layout& getLayout(Atlas& atlas, const char* text) {
+        atlas.clock++;
+        std::map<std::string, Layout>::iterator found = atlas.layouts.find(text);
+        if (found != atlas.layouts.end()) {
+            found->second.lastUsed = atlas.clock;
+            return found->second;
+        }
+
+        // Los textos que cambian cada frame no deben juntarse para siempre
+        if (atlas.layouts.size() >= MAX_CACHED) {
+            std::map<std::string, Layout>::iterator oldest = atlas.layouts.begin();
+            for (std::map<std::string, Layout>::iterator it = atlas.layouts.begin(); it != atlas.layouts.end(); ++it) {
+                if (it->second.lastUsed < oldest->second.lastUsed) oldest = it;
+            }
+            atlas.layouts.erase(oldest);
+        }
+
+        Layout& layout = atlas.layouts[text];
+        layout.lastUsed = atlas.clock;
+        float texelU = 1.0f / atlas.textureWidth;
+        float texelV = 1.0f / atlas.textureHeight;
+        float bottom = (float)-atlas.baseline;
+        float top = bottom + atlas.cellHeight;
+
+        int pen = 0;
+        for (const char* p = text; *p != '\0'; p++) {
+            unsigned char c = (unsigned char)*p;
+            if (c > FIRST_CHAR) {
+                float left = (float)(pen - PADDING);
+                float right = left + atlas.cellWidth;
+                float u0 = (c % COLUMNS) * atlas.cellWidth * texelU;
+                float v0 = (c / COLUMNS) * atlas.cellHeight * texelV;
+                float u1 = u0 + atlas.cellWidth * texelU;
+                float v1 = v0 + atlas.cellHeight * texelV;
+
+                GLfloat quad[16] = {
+                    left,  bottom, u0, v0,
+                    right, bottom, u1, v0,
+                    right, top,    u1, v1,
+                    left,  top,    u0, v1
+                };
+                layout.vertices.insert(layout.vertices.end(), quad, quad + 16);
+            }
+            pen += atlas.advance[c];
+        }
+        layout.width = pen;
+        return layout;
+    }
+
+public:
+    // Armar los atlas de todas las fuentes bitmap de GLUT. Se dibuja en un
+    // framebuffer propio si el driver lo tiene; si no, pisa una esquina del
+    // color buffer: llamarla al empezar el frame, antes del glClear. Una
+    // fuente cuyo atlas sali mal se sigue dibujando con glBitmap.
+    static void prepare() {
+        if (prepared) return;
+        prepared = true;
+
+        void* fonts[] = {
+            GLUT_BITMAP_8_BY_13, GLUT_BITMAP_9_BY_15,
+            GLUT_BITMAP_TIMES_ROMAN_10, GLUT_BITMAP_TIMES_ROMAN_24,
+            GLUT_BITMAP_HELVETICA_10, GLUT_BITMAP_HELVETICA_12, GLUT_BITMAP_HELVETICA_18
+        };
+        int fontCount = sizeof(fonts) / sizeof(fonts[0]);
+
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        GLfloat clearColor[4];
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+
+        RenderState::pushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_TEXTURE_BIT | GL_SCISSOR_BIT |
+                                GL_VIEWPORT_BIT);
+        GLuint renderbuffer = 0;
+        GLuint framebuffer = createGlyphTarget(renderbuffer);
+        int targetWidth = viewport[2];
+        int targetHeight = viewport[3];
+        if (framebuffer != 0) {
+            targetWidth = targetHeight = GLYPH_TARGET_SIZE;
+            glViewport(0, 0, targetWidth, targetHeight);
+        }
+
+        RenderState::disable(GL_LIGHTING);
+        RenderState::disable(GL_TEXTURE_2D);
+        RenderState::disable(GL_DEPTH_TEST);
+        RenderState::disable(GL_BLEND);
+        RenderState::enable(GL_SCISSOR_TEST);
+        RenderState::color(1.0f, 1.0f, 1.0f);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+        glMatrixMode(GL_PROJECTION);
+        glPushMatrix();
+        glLoadIdentity();
+        glOrtho(0, targetWidth, 0, targetHeight, -1, 1);
+        glMatrixMode(GL_MODELVIEW);
+        glPushMatrix();
+        glLoadIdentity();
+
+        atlases.resize(fontCount);
+        for (int i = 0; i < fontCount; i++) {
+            atlases[i].font = fonts[i];
+            atlases[i].clock = 0;
+            buildAtlas(atlases[i], targetWidth, targetHeight);
+        }
+        if (framebuffer != 0) {
+            destroyGlyphTarget(framebuffer, renderbuffer);
+        }
+
+        for (int i = 0; i < fontCount; i++) {
+            if (atlases[i].texture != 0 && !checkAtlas(atlases[i])) {
+                printf("Aviso: El atlas de una fuente salio mal, se dibujara con glBitmap\n");
+                RenderState::deleteTextures(1, &atlases[i].texture);
+                atlases[i].texture = 0;
+            }
+        }
+
+        glPopMatrix();
+        glMatrixMode(GL_PROJECTION);
+        glPopMatrix();
+        glMatrixMode(GL_MODELVIEW);
+
+        glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+        RenderState::popAttrib();
+    }
+
+    static void release() {
+        for (size_t i = 0; i < atlases.size(); i++) {
+            if (atlases[i].texture != 0) {
+                RenderState::deleteTextures(1, &atlases[i].texture);
+            }
+        }
+        atlases.clear();
+        prepared = false;
+    }
+
+    // Ancho en pixels, como la suma de glutBitmapWidth
+    static int getTextWidth(void* font, const char* text) {
+        Atlas* atlas = findAtlas(font);
+        if (atlas == NULL) {
+            int width = 0;
+            for (const char* c = text; *c != '\0'; c++) {
+                width += glutBitmapWidth(font, (unsigned char)*c);
+            }
+            return width;
+        }
+        return getLayout(*atlas, text).width;
+    }
+
+    // Dibujar con el color actual. Sin atlas (antes de prepare()) usa glBitmap.
+    static void drawText(void* font, float x, float y, const char* text) {
+        Atlas* atlas = findAtlas(font);
+        if (atlas == NULL || atlas->texture == 0) {
+            glRasterPos2f(x, y);
+            for (const char* c = text; *c != '\0'; c++) {
+                glutBitmapCharacter(font, (unsigned char)*c);
+            }
+            return;
+        }
+
+        const Layout& layout = getLayout(*atlas, text);
+        if (layout.vertices.empty()) return;
+
+        // Con el eje Y hacia abajo los quads se dan vuelta: glBitmap siempre dibuja derecho
+        GLfloat projection[16];
+        glGetFloatv(GL_PROJECTION_MATRIX, projection);
+
+        RenderState::pushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_COLOR_BUFFER_BIT);
+        glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+        RenderState::disable(GL_LIGHTING);
+        RenderState::enable(GL_TEXTURE_2D);
+        RenderState::bindTexture(atlas->texture);
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+        RenderState::enable(GL_BLEND);
+        RenderState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        // Al pixel que elegira glBitmap, as cada texel cae justo en un pixel
+        bool flipped = projection[5] < 0.0f;
+        x = floorf(x);
+        y = flipped ? ceilf(y) : floorf(y);
+
+        glMatrixMode(GL_MODELVIEW);
+        glPushMatrix();
+        glTranslatef(x, y, 0.0f);
+        if (flipped) {
+            glScalef(1.0f, -1.0f, 1.0f);
+        }
+
+        glDisableClientState(GL_NORMAL_ARRAY);
+        glDisableClientState(GL_COLOR_ARRAY);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glVertexPointer(2, GL_FLOAT, 4 * sizeof(GLfloat), &layout.vertices[0]);
+        glTexCoordPointer(2, GL_FLOAT, 4 * sizeof(GLfloat), &layout.vertices[2]);
+        glDrawArrays(GL_QUADS, 0, (GLsizei)(layout.vertices.size() / 4));
+
+        glPopMatrix();
+        glPopClientAttrib();
+        RenderState::popAttrib();
+    }
+};
+
+std::vector<BitmapFont::Atlas> BitmapFont::atlases;
+bool BitmapFont::prepared = false;
+
+#endif // BITMAPFONT_H
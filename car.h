@@ -6,313 +6,311 @@
 #include <GL/glu.h>
 #include <GL/glut.h>
 #include <cmath>
+#include "meshbuilder.h"
+#include "meshbuffer.h"
+#include "levelofdetail.h"
+#include "lightingshader.h"
+#include "renderstate.h"
+
+// Lo que cambia de un carro a otro; la geometra es la misma para todos
+struct CarInstance {
+    float x, y, z;
+    float angle;         // Giro sobre Y, en grados
+    float color[3];      // Color de la carrocera
+    float wheelRotation; // En grados
+    int wheelDetail;     // Nivel de detalle de las ruedas (0 = completo)
+};
 
 class Car {
+public:
+    // Teselaciones de rueda, una por nivel de LevelOfDetail
+    static const int WHEEL_LEVELS = 4;
+
+    // Radio de una esfera que contiene al carro, para medirlo en pantalla
+    static const float BOUNDING_RADIUS;
+
 private:
     float wheelRotation;
-    
+
+    // Mallas compartidas por todos los carros, se arman la primera vez que se dibuja
+    static MeshBuffer paintMesh;  // Carrocera, sin color propio: usa el de la instancia
+    static MeshBuffer trimMesh;   // Lnea de cintura, un tono ms oscuro que la carrocera
+    static MeshBuffer detailMesh; // Todo lo que tiene color fijo
+    static MeshBuffer glassMesh;  // Cristales, se dibujan al final con transparencia
+    static MeshBuffer wheelMesh[WHEEL_LEVELS]; // Una rueda por nivel; cuatro por carro
+
     // Funcin para dibujar un cubo suavizado
-    void drawSmoothCube(float width, float height, float depth) {
-        glBegin(GL_QUADS);
-        
+    static void buildSmoothCube(MeshBuilder& mesh, float width, float height, float depth) {
+        mesh.begin(GL_QUADS);
+
         // Front face
-        glNormal3f(0.0f, 0.0f, 1.0f);
-        glVertex3f(-width/2, -height/2, depth/2);
-        glVertex3f(width/2, -height/2, depth/2);
-        glVertex3f(width/2, height/2, depth/2);
-        glVertex3f(-width/2, height/2, depth/2);
-        
+        mesh.normal(0.0f, 0.0f, 1.0f);
+        mesh.vertex(-width/2, -height/2, depth/2);
+        mesh.vertex(width/2, -height/2, depth/2);
+        mesh.vertex(width/2, height/2, depth/2);
+        mesh.vertex(-width/2, height/2, depth/2);
+
         // Back face
-        glNormal3f(0.0f, 0.0f, -1.0f);
-        glVertex3f(-width/2, -height/2, -depth/2);
-        glVertex3f(-width/2, height/2, -depth/2);
-        glVertex3f(width/2, height/2, -depth/2);
-        glVertex3f(width/2, -height/2, -depth/2);
-        
+        mesh.normal(0.0f, 0.0f, -1.0f);
+        mesh.vertex(-width/2, -height/2, -depth/2);
+        mesh.vertex(-width/2, height/2, -depth/2);
+        mesh.vertex(width/2, height/2, -depth/2);
+        mesh.vertex(width/2, -height/2, -depth/2);
+
         // Top face
-        glNormal3f(0.0f, 1.0f, 0.0f);
-        glVertex3f(-width/2, height/2, -depth/2);
-        glVertex3f(-width/2, height/2, depth/2);
-        glVertex3f(width/2, height/2, depth/2);
-        glVertex3f(width/2, height/2, -depth/2);
-        
+        mesh.normal(0.0f, 1.0f, 0.0f);
+        mesh.vertex(-width/2, height/2, -depth/2);
+        mesh.vertex(-width/2, height/2, depth/2);
+        mesh.vertex(width/2, height/2, depth/2);
+        mesh.vertex(width/2, height/2, -depth/2);
+
         // Bottom face
-        glNormal3f(0.0f, -1.0f, 0.0f);
-        glVertex3f(-width/2, -height/2, -depth/2);
-        glVertex3f(width/2, -height/2, -depth/2);
-        glVertex3f(width/2, -height/2, depth/2);
-        glVertex3f(-width/2, -height/2, depth/2);
-        
+        mesh.normal(0.0f, -1.0f, 0.0f);
+        mesh.vertex(-width/2, -height/2, -depth/2);
+        mesh.vertex(width/2, -height/2, -depth/2);
+        mesh.vertex(width/2, -height/2, depth/2);
+        mesh.vertex(-width/2, -height/2, depth/2);
+
         // Right face
-        glNormal3f(1.0f, 0.0f, 0.0f);
-        glVertex3f(width/2, -height/2, -depth/2);
-        glVertex3f(width/2, height/2, -depth/2);
-        glVertex3f(width/2, height/2, depth/2);
-        glVertex3f(width/2, -height/2, depth/2);
-        
+        mesh.normal(1.0f, 0.0f, 0.0f);
+        mesh.vertex(width/2, -height/2, -depth/2);
+        mesh.vertex(width/2, height/2, -depth/2);
+        mesh.vertex(width/2, height/2, depth/2);
+        mesh.vertex(width/2, -height/2, depth/2);
+
         // Left face
-        glNormal3f(-1.0f, 0.0f, 0.0f);
-        glVertex3f(-width/2, -height/2, -depth/2);
-        glVertex3f(-width/2, -height/2, depth/2);
-        glVertex3f(-width/2, height/2, depth/2);
-        glVertex3f(-width/2, height/2, -depth/2);
-        
-        glEnd();
+        mesh.normal(-1.0f, 0.0f, 0.0f);
+        mesh.vertex(-width/2, -height/2, -depth/2);
+        mesh.vertex(-width/2, -height/2, depth/2);
+        mesh.vertex(-width/2, height/2, depth/2);
+        mesh.vertex(-width/2, height/2, -depth/2);
+
+        mesh.end();
+    }
+
+    // Cubo unitario trasladado y escalado, el patrn de casi todas las piezas
+    static void buildBox(MeshBuilder& mesh, float x, float y, float z, float sx, float sy, float sz) {
+        mesh.pushMatrix();
+        mesh.translate(x, y, z);
+        mesh.scale(sx, sy, sz);
+        buildSmoothCube(mesh, 1, 1, 1);
+        mesh.popMatrix();
     }
-    
-    // Funcin para dibujar una rueda ms detallada
-    void drawWheel(float radius, float width) {
-        glPushMatrix();
-        
+
+    static void buildSphere(MeshBuilder& mesh, float x, float y, float z, float radius, int slices) {
+        mesh.pushMatrix();
+        mesh.translate(x, y, z);
+        mesh.solidSphere(radius, slices, slices);
+        mesh.popMatrix();
+    }
+
+    // Funcin para dibujar una rueda ms detallada ('level' 0 = la ms fina)
+    static void buildWheel(MeshBuilder& mesh, float radius, float width, int level) {
+        int slices = LevelOfDetail::scaleDetail(24, level, 4);
+        int spokeSlices = LevelOfDetail::scaleDetail(8, level, 4);
+        int centerSlices = LevelOfDetail::scaleDetail(12, level, 4);
+
+        mesh.pushMatrix();
+
         // Llanta exterior (negra)
-        glColor3f(0.05f, 0.05f, 0.05f);
-        GLUquadricObj* quadric = gluNewQuadric();
-        gluQuadricNormals(quadric, GLU_SMOOTH);
-        gluCylinder(quadric, radius, radius, width, 24, 1);
-        
+        mesh.color(0.05f, 0.05f, 0.05f);
+        mesh.solidCylinder(radius, radius, width, slices, 1);
+
         // Rin interior (plateado brillante)
-        glColor3f(0.9f, 0.9f, 0.95f);
-        gluDisk(quadric, 0, radius * 0.75f, 24, 1);
-        
-        glTranslatef(0, 0, width);
-        gluDisk(quadric, 0, radius * 0.75f, 24, 1);
-        
+        mesh.color(0.9f, 0.9f, 0.95f);
+        mesh.solidDisk(0, radius * 0.75f, slices, 1);
+
+        mesh.translate(0, 0, width);
+        mesh.solidDisk(0, radius * 0.75f, slices, 1);
+
         // Detalles del rin
-        glColor3f(0.7f, 0.7f, 0.8f);
-        glTranslatef(0, 0, -width/2);
-        
+        mesh.color(0.7f, 0.7f, 0.8f);
+        mesh.translate(0, 0, -width/2);
+
         // Rayos del rin
         for(int i = 0; i < 5; i++) {
-            glPushMatrix();
-            glRotatef(i * 72.0f, 0, 0, 1);
-            glTranslatef(0, radius * 0.4f, 0);
-            glutSolidSphere(0.02f, 8, 8);
-            glPopMatrix();
+            mesh.pushMatrix();
+            mesh.rotate(i * 72.0f, 0, 0, 1);
+            mesh.translate(0, radius * 0.4f, 0);
+            mesh.solidSphere(0.02f, spokeSlices, spokeSlices);
+            mesh.popMatrix();
         }
-        
+
         // Centro del rin
-        glColor3f(0.6f, 0.6f, 0.7f);
-        glutSolidSphere(0.08f, 12, 12);
-        
-        gluDeleteQuadric(quadric);
-        glPopMatrix();
+        mesh.color(0.6f, 0.6f, 0.7f);
+        mesh.solidSphere(0.08f, centerSlices, centerSlices);
+
+        mesh.popMatrix();
     }
-    
-    // Funcin para dibujar ventanas con marco
-    void drawWindows() {
-        // Marco de ventanas (negro)
-        glColor3f(0.1f, 0.1f, 0.1f);
-        
+
+    // Marcos de las ventanas (negros)
+    static void buildWindowFrames(MeshBuilder& mesh) {
+        mesh.color(0.1f, 0.1f, 0.1f);
+
         // Parabrisas delantero
-        glPushMatrix();
-        glTranslatef(0, 0.35f, 1.45f);
-        glRotatef(-15, 1, 0, 0);
-        glScalef(1.5f, 0.7f, 0.05f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        // Cristal del parabrisas
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glColor4f(0.7f, 0.9f, 1.0f, 0.3f);
-        
-        glPushMatrix();
-        glTranslatef(0, 0.35f, 1.48f);
-        glRotatef(-15, 1, 0, 0);
-        glScalef(1.4f, 0.65f, 0.02f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
+        mesh.pushMatrix();
+        mesh.translate(0, 0.35f, 1.45f);
+        mesh.rotate(-15, 1, 0, 0);
+        mesh.scale(1.5f, 0.7f, 0.05f);
+        buildSmoothCube(mesh, 1, 1, 1);
+        mesh.popMatrix();
+
         // Ventana trasera
-        glColor3f(0.1f, 0.1f, 0.1f);
-        glPushMatrix();
-        glTranslatef(0, 0.35f, -1.45f);
-        glRotatef(20, 1, 0, 0);
-        glScalef(1.5f, 0.7f, 0.05f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        glColor4f(0.7f, 0.9f, 1.0f, 0.3f);
-        glPushMatrix();
-        glTranslatef(0, 0.35f, -1.48f);
-        glRotatef(20, 1, 0, 0);
-        glScalef(1.4f, 0.65f, 0.02f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
+        mesh.pushMatrix();
+        mesh.translate(0, 0.35f, -1.45f);
+        mesh.rotate(20, 1, 0, 0);
+        mesh.scale(1.5f, 0.7f, 0.05f);
+        buildSmoothCube(mesh, 1, 1, 1);
+        mesh.popMatrix();
+
         // Ventanas laterales
-        glColor3f(0.1f, 0.1f, 0.1f);
-        glPushMatrix();
-        glTranslatef(0.82f, 0.35f, 0);
-        glScalef(0.05f, 0.7f, 2.2f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        glColor4f(0.7f, 0.9f, 1.0f, 0.3f);
-        glPushMatrix();
-        glTranslatef(0.85f, 0.35f, 0);
-        glScalef(0.02f, 0.65f, 2.1f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        glColor3f(0.1f, 0.1f, 0.1f);
-        glPushMatrix();
-        glTranslatef(-0.82f, 0.35f, 0);
-        glScalef(0.05f, 0.7f, 2.2f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        glColor4f(0.7f, 0.9f, 1.0f, 0.3f);
-        glPushMatrix();
-        glTranslatef(-0.85f, 0.35f, 0);
-        glScalef(0.02f, 0.65f, 2.1f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        glDisable(GL_BLEND);
+        buildBox(mesh, 0.82f, 0.35f, 0, 0.05f, 0.7f, 2.2f);
+        buildBox(mesh, -0.82f, 0.35f, 0, 0.05f, 0.7f, 2.2f);
     }
-    
-    // Funcin para dibujar detalles de la carrocera
-    void drawCarBody() {
-        // Color principal amarillo Brasilia
-        glColor3f(1.0f, 0.85f, 0.0f);
-        
-        // Carrocera principal
-        glPushMatrix();
-        glTranslatef(0, -0.15f, 0);
-        glScalef(1.7f, 0.7f, 2.8f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        // Techo
-        glPushMatrix();
-        glTranslatef(0, 0.55f, 0);
-        glScalef(1.5f, 0.5f, 2.4f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        // Cap
-        glPushMatrix();
-        glTranslatef(0, 0.05f, 1.6f);
-        glScalef(1.7f, 0.35f, 0.5f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        // Parte trasera
-        glPushMatrix();
-        glTranslatef(0, 0.05f, -1.6f);
-        glScalef(1.7f, 0.35f, 0.5f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        // Lnea de cintura
-        glColor3f(0.8f, 0.7f, 0.0f);
-        glPushMatrix();
-        glTranslatef(0, 0.0f, 0);
-        glScalef(1.72f, 0.05f, 2.82f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        // Rejilla delantera
-        glColor3f(0.2f, 0.2f, 0.2f);
-        glPushMatrix();
-        glTranslatef(0, -0.1f, 1.88f);
-        glScalef(0.8f, 0.3f, 0.05f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        // Lneas de la rejilla
-        glColor3f(0.9f, 0.9f, 0.9f);
+
+    // Cristales (semitransparentes)
+    static void buildWindowGlass(MeshBuilder& mesh) {
+        mesh.color(0.7f, 0.9f, 1.0f, 0.3f);
+
+        // Cristal del parabrisas
+        mesh.pushMatrix();
+        mesh.translate(0, 0.35f, 1.48f);
+        mesh.rotate(-15, 1, 0, 0);
+        mesh.scale(1.4f, 0.65f, 0.02f);
+        buildSmoothCube(mesh, 1, 1, 1);
+        mesh.popMatrix();
+
+        mesh.pushMatrix();
+        mesh.translate(0, 0.35f, -1.48f);
+        mesh.rotate(20, 1, 0, 0);
+        mesh.scale(1.4f, 0.65f, 0.02f);
+        buildSmoothCube(mesh, 1, 1, 1);
+        mesh.popMatrix();
+
+        buildBox(mesh, 0.85f, 0.35f, 0, 0.02f, 0.65f, 2.1f);
+        buildBox(mesh, -0.85f, 0.35f, 0, 0.02f, 0.65f, 2.1f);
+    }
+
+    // Carrocera principal, techo, cap y parte trasera
+    static void buildCarBody(MeshBuilder& mesh) {
+        buildBox(mesh, 0, -0.15f, 0, 1.7f, 0.7f, 2.8f);
+        buildBox(mesh, 0, 0.55f, 0, 1.5f, 0.5f, 2.4f);
+        buildBox(mesh, 0, 0.05f, 1.6f, 1.7f, 0.35f, 0.5f);
+        buildBox(mesh, 0, 0.05f, -1.6f, 1.7f, 0.35f, 0.5f);
+    }
+
+    // Lnea de cintura
+    static void buildTrim(MeshBuilder& mesh) {
+        buildBox(mesh, 0, 0.0f, 0, 1.72f, 0.05f, 2.82f);
+    }
+
+    // Rejilla delantera con sus lneas
+    static void buildGrille(MeshBuilder& mesh) {
+        mesh.color(0.2f, 0.2f, 0.2f);
+        buildBox(mesh, 0, -0.1f, 1.88f, 0.8f, 0.3f, 0.05f);
+
+        mesh.color(0.9f, 0.9f, 0.9f);
         for(int i = -2; i <= 2; i++) {
-            glPushMatrix();
-            glTranslatef(i * 0.15f, -0.1f, 1.9f);
-            glScalef(0.02f, 0.25f, 0.02f);
-            drawSmoothCube(1, 1, 1);
-            glPopMatrix();
+            buildBox(mesh, i * 0.15f, -0.1f, 1.9f, 0.02f, 0.25f, 0.02f);
         }
     }
-    
+
     // Funcin para dibujar parachoques
-    void drawBumpers() {
-        // Parachoques delantero
-        glColor3f(0.15f, 0.15f, 0.15f);
-        glPushMatrix();
-        glTranslatef(0, -0.45f, 2.0f);
-        glScalef(1.8f, 0.15f, 0.15f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        // Parachoques trasero
-        glPushMatrix();
-        glTranslatef(0, -0.45f, -2.0f);
-        glScalef(1.8f, 0.15f, 0.15f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
+    static void buildBumpers(MeshBuilder& mesh) {
+        // Parachoques delantero y trasero
+        mesh.color(0.15f, 0.15f, 0.15f);
+        buildBox(mesh, 0, -0.45f, 2.0f, 1.8f, 0.15f, 0.15f);
+        buildBox(mesh, 0, -0.45f, -2.0f, 1.8f, 0.15f, 0.15f);
+
         // Detalles cromados
-        glColor3f(0.8f, 0.8f, 0.9f);
-        glPushMatrix();
-        glTranslatef(0, -0.45f, 2.02f);
-        glScalef(1.6f, 0.08f, 0.08f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        glPushMatrix();
-        glTranslatef(0, -0.45f, -2.02f);
-        glScalef(1.6f, 0.08f, 0.08f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
+        mesh.color(0.8f, 0.8f, 0.9f);
+        buildBox(mesh, 0, -0.45f, 2.02f, 1.6f, 0.08f, 0.08f);
+        buildBox(mesh, 0, -0.45f, -2.02f, 1.6f, 0.08f, 0.08f);
     }
-    
+
     // Funcin para dibujar faros
-    void drawLights() {
+    static void buildLights(MeshBuilder& mesh) {
         // Faros delanteros
-        glColor3f(1.0f, 1.0f, 0.95f);
-        glPushMatrix();
-        glTranslatef(-0.6f, 0.0f, 1.92f);
-        glutSolidSphere(0.16f, 16, 16);
-        glPopMatrix();
-        
-        glPushMatrix();
-        glTranslatef(0.6f, 0.0f, 1.92f);
-        glutSolidSphere(0.16f, 16, 16);
-        glPopMatrix();
-        
+        mesh.color(1.0f, 1.0f, 0.95f);
+        buildSphere(mesh, -0.6f, 0.0f, 1.92f, 0.16f, 16);
+        buildSphere(mesh, 0.6f, 0.0f, 1.92f, 0.16f, 16);
+
         // Reflectores de los faros
-        glColor3f(0.9f, 0.9f, 0.9f);
-        glPushMatrix();
-        glTranslatef(-0.6f, 0.0f, 1.9f);
-        glutSolidSphere(0.1f, 12, 12);
-        glPopMatrix();
-        
-        glPushMatrix();
-        glTranslatef(0.6f, 0.0f, 1.9f);
-        glutSolidSphere(0.1f, 12, 12);
-        glPopMatrix();
-        
+        mesh.color(0.9f, 0.9f, 0.9f);
+        buildSphere(mesh, -0.6f, 0.0f, 1.9f, 0.1f, 12);
+        buildSphere(mesh, 0.6f, 0.0f, 1.9f, 0.1f, 12);
+
         // Luces traseras
-        glColor3f(0.8f, 0.1f, 0.1f);
-        glPushMatrix();
-        glTranslatef(-0.6f, 0.0f, -1.92f);
-        glutSolidSphere(0.1f, 12, 12);
-        glPopMatrix();
-        
-        glPushMatrix();
-        glTranslatef(0.6f, 0.0f, -1.92f);
-        glutSolidSphere(0.1f, 12, 12);
-        glPopMatrix();
-        
+        mesh.color(0.8f, 0.1f, 0.1f);
+        buildSphere(mesh, -0.6f, 0.0f, -1.92f, 0.1f, 12);
+        buildSphere(mesh, 0.6f, 0.0f, -1.92f, 0.1f, 12);
+
         // Luces de freno
-        glColor3f(1.0f, 0.2f, 0.2f);
-        glPushMatrix();
-        glTranslatef(-0.4f, 0.0f, -1.95f);
-        glutSolidSphere(0.06f, 10, 10);
-        glPopMatrix();
-        
-        glPushMatrix();
-        glTranslatef(0.4f, 0.0f, -1.95f);
-        glutSolidSphere(0.06f, 10, 10);
-        glPopMatrix();
+        mesh.color(1.0f, 0.2f, 0.2f);
+        buildSphere(mesh, -0.4f, 0.0f, -1.95f, 0.06f, 10);
+        buildSphere(mesh, 0.4f, 0.0f, -1.95f, 0.06f, 10);
+    }
+
+    // Manijas de puertas y espejos laterales
+    static void buildHandlesAndMirrors(MeshBuilder& mesh) {
+        mesh.color(0.8f, 0.8f, 0.9f);
+        buildBox(mesh, 0.85f, 0.0f, 0.5f, 0.02f, 0.05f, 0.15f);
+        buildBox(mesh, -0.85f, 0.0f, 0.5f, 0.02f, 0.05f, 0.15f);
+
+        mesh.color(0.1f, 0.1f, 0.1f);
+        buildSphere(mesh, 0.92f, 0.3f, 1.0f, 0.06f, 8);
+        buildSphere(mesh, -0.92f, 0.3f, 1.0f, 0.06f, 8);
+    }
+
+    static void buildMeshes() {
+        MeshBuilder paint;
+        buildCarBody(paint);
+        paintMesh.build(paint, false);
+
+        MeshBuilder trim;
+        buildTrim(trim);
+        trimMesh.build(trim, false);
+
+        MeshBuilder details;
+        buildGrille(details);
+        buildBumpers(details);
+        buildWindowFrames(details);
+        buildLights(details);
+        buildHandlesAndMirrors(details);
+        detailMesh.build(details, true);
+
+        MeshBuilder glass;
+        buildWindowGlass(glass);
+        glassMesh.build(glass, true);
+
+        for (int level = 0; level < WHEEL_LEVELS; level++) {
+            MeshBuilder wheel;
+            buildWheel(wheel, 0.35f, 0.18f, level);
+            wheelMesh[level].build(wheel, true);
+        }
+    }
+
+    static int wheelLevel(const CarInstance& car) {
+        if (car.wheelDetail < 0) return 0;
+        if (car.wheelDetail >= WHEEL_LEVELS) return WHEEL_LEVELS - 1;
+        return car.wheelDetail;
+    }
+
+    static void applyTransform(const CarInstance& car) {
+        glTranslatef(car.x, car.y, car.z);
+        glRotatef(car.angle, 0, 1, 0);
+    }
+
+    // Dibujar 'mesh' una vez por carro
+    static void drawEach(const MeshBuffer& mesh, const CarInstance* cars, int count) {
+        mesh.bind();
+        for (int i = 0; i < count; i++) {
+            glPushMatrix();
+            applyTransform(cars[i]);
+            mesh.draw();
+            glPopMatrix();
+        }
+        mesh.unbind();
     }
 
 public:
@@ -320,99 +318,104 @@ public:
     Car() {
         wheelRotation = 0.0f;
     }
-    
+
     // Funcin para animar las ruedas
     void animateWheels() {
         wheelRotation += 3.0f;
         if(wheelRotation > 360.0f) wheelRotation -= 360.0f;
     }
-    
+
+    float getWheelRotation() const {
+        return wheelRotation;
+    }
+
+    // Dibujar varios carros de una vez. Cada malla se enlaza una sola vez y se
+    // dibuja con la matriz de cada carro, as agregar carros no agrega trabajo
+    // de CPU ms all de una matriz y un glDrawElements por pieza.
+    static void drawInstances(const CarInstance* cars, int count) {
+        if (count <= 0) return;
+        if (!paintMesh.isBuilt()) {
+            buildMeshes();
+        }
+
+        RenderState::pushAttrib(GL_CURRENT_BIT | GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT);
+        LightingShader::begin();
+
+        // Carrocera y lnea de cintura con el color de cada carro
+        paintMesh.bind();
+        for (int i = 0; i < count; i++) {
+            RenderState::color3v(cars[i].color);
+            glPushMatrix();
+            applyTransform(cars[i]);
+            paintMesh.draw();
+            glPopMatrix();
+        }
+        paintMesh.unbind();
+
+        trimMesh.bind();
+        for (int i = 0; i < count; i++) {
+            RenderState::color(cars[i].color[0] * 0.8f, cars[i].color[1] * 0.8f, cars[i].color[2] * 0.8f);
+            glPushMatrix();
+            applyTransform(cars[i]);
+            trimMesh.draw();
+            glPopMatrix();
+        }
+        trimMesh.unbind();
+
+        drawEach(detailMesh, cars, count);
+
+        // Ruedas: las izquierdas miran hacia afuera por -X, las derechas por +X
+        static const float wheelPositions[4][3] = {
+            {-0.9f, -0.65f, 1.2f}, {0.9f, -0.65f, 1.2f},
+            {-0.9f, -0.65f, -1.2f}, {0.9f, -0.65f, -1.2f}
+        };
+        for (int level = 0; level < WHEEL_LEVELS; level++) {
+            wheelMesh[level].bind();
+            for (int i = 0; i < count; i++) {
+                if (wheelLevel(cars[i]) != level) continue;
+                glPushMatrix();
+                applyTransform(cars[i]);
+                for (int w = 0; w < 4; w++) {
+                    float side = (wheelPositions[w][0] < 0.0f) ? 1.0f : -1.0f;
+                    glPushMatrix();
+                    glTranslatef(wheelPositions[w][0], wheelPositions[w][1], wheelPositions[w][2]);
+                    glRotatef(side * 90, 0, 1, 0);
+                    glRotatef(side * cars[i].wheelRotation, 0, 0, 1);
+                    wheelMesh[level].draw();
+                    glPopMatrix();
+                }
+                glPopMatrix();
+            }
+            wheelMesh[level].unbind();
+        }
+
+        // Cristales al final para que se vea lo de atrs
+        RenderState::enable(GL_BLEND);
+        RenderState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        drawEach(glassMesh, cars, count);
+
+        LightingShader::end();
+        RenderState::popAttrib();
+    }
+
     // Funcin para dibujar el carro completo
     void draw() {
-        glPushMatrix();
-        
-        // Cuerpo principal
-        drawCarBody();
-        
-        // Parachoques
-        drawBumpers();
-        
-        // Ventanas
-        drawWindows();
-        
-        // Faros y luces
-        drawLights();
-        
-        // Ruedas con animacin
-        // Rueda delantera izquierda
-        glPushMatrix();
-        glTranslatef(-0.9f, -0.65f, 1.2f);
-        glRotatef(90, 0, 1, 0);
-        glRotatef(wheelRotation, 0, 0, 1);
-        drawWheel(0.35f, 0.18f);
-        glPopMatrix();
-        
-        // Rueda delantera derecha
-        glPushMatrix();
-        glTranslatef(0.9f, -0.65f, 1.2f);
-        glRotatef(-90, 0, 1, 0);
-        glRotatef(-wheelRotation, 0, 0, 1);
-        drawWheel(0.35f, 0.18f);
-        glPopMatrix();
-        
-        // Rueda trasera izquierda
-        glPushMatrix();
-        glTranslatef(-0.9f, -0.65f, -1.2f);
-        glRotatef(90, 0, 1, 0);
-        glRotatef(wheelRotation, 0, 0, 1);
-        drawWheel(0.35f, 0.18f);
-        glPopMatrix();
-        
-        // Rueda trasera derecha
-        glPushMatrix();
-        glTranslatef(0.9f, -0.65f, -1.2f);
-        glRotatef(-90, 0, 1, 0);
-        glRotatef(-wheelRotation, 0, 0, 1);
-        drawWheel(0.35f, 0.18f);
-        glPopMatrix();
-        
-        // Manijas de puertas
-        glColor3f(0.8f, 0.8f, 0.9f);
-        glPushMatrix();
-        glTranslatef(0.85f, 0.0f, 0.5f);
-        glScalef(0.02f, 0.05f, 0.15f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        glPushMatrix();
-        glTranslatef(-0.85f, 0.0f, 0.5f);
-        glScalef(0.02f, 0.05f, 0.15f);
-        drawSmoothCube(1, 1, 1);
-        glPopMatrix();
-        
-        // Espejos laterales
-        glColor3f(0.1f, 0.1f, 0.1f);
-        glPushMatrix();
-        glTranslatef(0.92f, 0.3f, 1.0f);
-        glutSolidSphere(0.06f, 8, 8);
-        glPopMatrix();
-        
-        glPushMatrix();
-        glTranslatef(-0.92f, 0.3f, 1.0f);
-        glutSolidSphere(0.06f, 8, 8);
-        glPopMatrix();
-        
-        glPopMatrix();
+        drawAt(0, 0, 0, 0);
     }
-    
+
     // Funcin para dibujar el carro en una posicin especfica
     void drawAt(float x, float y, float z, float angle) {
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glRotatef(angle, 0, 1, 0);
-        draw();
-        glPopMatrix();
+        // Color principal amarillo Brasilia
+        CarInstance car = {x, y, z, angle, {1.0f, 0.85f, 0.0f}, wheelRotation, 0};
+        drawInstances(&car, 1);
     }
 };
 
+MeshBuffer Car::paintMesh;
+MeshBuffer Car::trimMesh;
+MeshBuffer Car::detailMesh;
+MeshBuffer Car::glassMesh;
+MeshBuffer Car::wheelMesh[Car::WHEEL_LEVELS];
+const float Car::BOUNDING_RADIUS = 2.4f;
+
 #endif // CAR_H
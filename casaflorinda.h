@@ -5,354 +5,356 @@
 #include <GL/gl.h>
 #include <GL/glu.h>
 #include <cmath>
+#include "meshbuilder.h"
+#include "renderstate.h"
 
 class FlorindaCasa {
 private:
-    void dibujarCubo(float ancho, float alto, float profundo) {
-        glBegin(GL_QUADS);
+    void dibujarCubo(MeshBuilder& mesh, float ancho, float alto, float profundo) {
+        mesh.begin(GL_QUADS);
         
         // Cara frontal
-        glNormal3f(0.0f, 0.0f, 1.0f);
-        glVertex3f(-ancho/2, -alto/2, profundo/2);
-        glVertex3f(ancho/2, -alto/2, profundo/2);
-        glVertex3f(ancho/2, alto/2, profundo/2);
-        glVertex3f(-ancho/2, alto/2, profundo/2);
+        mesh.normal(0.0f, 0.0f, 1.0f);
+        mesh.vertex(-ancho/2, -alto/2, profundo/2);
+        mesh.vertex(ancho/2, -alto/2, profundo/2);
+        mesh.vertex(ancho/2, alto/2, profundo/2);
+        mesh.vertex(-ancho/2, alto/2, profundo/2);
         
         // Cara trasera
-        glNormal3f(0.0f, 0.0f, -1.0f);
-        glVertex3f(-ancho/2, -alto/2, -profundo/2);
-        glVertex3f(-ancho/2, alto/2, -profundo/2);
-        glVertex3f(ancho/2, alto/2, -profundo/2);
-        glVertex3f(ancho/2, -alto/2, -profundo/2);
+        mesh.normal(0.0f, 0.0f, -1.0f);
+        mesh.vertex(-ancho/2, -alto/2, -profundo/2);
+        mesh.vertex(-ancho/2, alto/2, -profundo/2);
+        mesh.vertex(ancho/2, alto/2, -profundo/2);
+        mesh.vertex(ancho/2, -alto/2, -profundo/2);
         
         // Cara superior
-        glNormal3f(0.0f, 1.0f, 0.0f);
-        glVertex3f(-ancho/2, alto/2, -profundo/2);
-        glVertex3f(-ancho/2, alto/2, profundo/2);
-        glVertex3f(ancho/2, alto/2, profundo/2);
-        glVertex3f(ancho/2, alto/2, -profundo/2);
+        mesh.normal(0.0f, 1.0f, 0.0f);
+        mesh.vertex(-ancho/2, alto/2, -profundo/2);
+        mesh.vertex(-ancho/2, alto/2, profundo/2);
+        mesh.vertex(ancho/2, alto/2, profundo/2);
+        mesh.vertex(ancho/2, alto/2, -profundo/2);
         
         // Cara inferior
-        glNormal3f(0.0f, -1.0f, 0.0f);
-        glVertex3f(-ancho/2, -alto/2, -profundo/2);
-        glVertex3f(ancho/2, -alto/2, -profundo/2);
-        glVertex3f(ancho/2, -alto/2, profundo/2);
-        glVertex3f(-ancho/2, -alto/2, profundo/2);
+        mesh.normal(0.0f, -1.0f, 0.0f);
+        mesh.vertex(-ancho/2, -alto/2, -profundo/2);
+        mesh.vertex(ancho/2, -alto/2, -profundo/2);
+        mesh.vertex(ancho/2, -alto/2, profundo/2);
+        mesh.vertex(-ancho/2, -alto/2, profundo/2);
         
         // Cara derecha
-        glNormal3f(1.0f, 0.0f, 0.0f);
-        glVertex3f(ancho/2, -alto/2, -profundo/2);
-        glVertex3f(ancho/2, alto/2, -profundo/2);
-        glVertex3f(ancho/2, alto/2, profundo/2);
-        glVertex3f(ancho/2, -alto/2, profundo/2);
+        mesh.normal(1.0f, 0.0f, 0.0f);
+        mesh.vertex(ancho/2, -alto/2, -profundo/2);
+        mesh.vertex(ancho/2, alto/2, -profundo/2);
+        mesh.vertex(ancho/2, alto/2, profundo/2);
+        mesh.vertex(ancho/2, -alto/2, profundo/2);
         
         // Cara izquierda
-        glNormal3f(-1.0f, 0.0f, 0.0f);
-        glVertex3f(-ancho/2, -alto/2, -profundo/2);
-        glVertex3f(-ancho/2, -alto/2, profundo/2);
-        glVertex3f(-ancho/2, alto/2, profundo/2);
-        glVertex3f(-ancho/2, alto/2, -profundo/2);
+        mesh.normal(-1.0f, 0.0f, 0.0f);
+        mesh.vertex(-ancho/2, -alto/2, -profundo/2);
+        mesh.vertex(-ancho/2, -alto/2, profundo/2);
+        mesh.vertex(-ancho/2, alto/2, profundo/2);
+        mesh.vertex(-ancho/2, alto/2, -profundo/2);
         
-        glEnd();
+        mesh.end();
     }
     
-    void dibujarPiso() {
+    void dibujarPiso(MeshBuilder& mesh) {
         // Piso principal (beige)
-        glColor3f(0.9f, 0.8f, 0.6f);
-        glPushMatrix();
-        glTranslatef(0.0f, -3.0f, 0.0f);
-        dibujarCubo(12.0f, 0.2f, 8.0f);
-        glPopMatrix();
+        mesh.color(0.9f, 0.8f, 0.6f);
+        mesh.pushMatrix();
+        mesh.translate(0.0f, -3.0f, 0.0f);
+        dibujarCubo(mesh, 12.0f, 0.2f, 8.0f);
+        mesh.popMatrix();
         
         // Alfombra sala (amarilla)
-        glColor3f(0.9f, 0.8f, 0.2f);
-        glPushMatrix();
-        glTranslatef(-2.5f, -2.8f, -1.0f);
-        dibujarCubo(4.0f, 0.1f, 3.0f);
-        glPopMatrix();
+        mesh.color(0.9f, 0.8f, 0.2f);
+        mesh.pushMatrix();
+        mesh.translate(-2.5f, -2.8f, -1.0f);
+        dibujarCubo(mesh, 4.0f, 0.1f, 3.0f);
+        mesh.popMatrix();
         
         // Alfombra comedor (amarilla)
-        glColor3f(0.9f, 0.8f, 0.2f);
-        glPushMatrix();
-        glTranslatef(2.5f, -2.8f, 1.0f);
-        dibujarCubo(3.0f, 0.1f, 3.0f);
-        glPopMatrix();
+        mesh.color(0.9f, 0.8f, 0.2f);
+        mesh.pushMatrix();
+        mesh.translate(2.5f, -2.8f, 1.0f);
+        dibujarCubo(mesh, 3.0f, 0.1f, 3.0f);
+        mesh.popMatrix();
     }
     
-    void dibujarTecho() {
+    void dibujarTecho(MeshBuilder& mesh) {
         // Techo principal (color blanco/crema)
-        glColor3f(0.95f, 0.95f, 0.9f);
-        glPushMatrix();
-        glTranslatef(0.0f, 3.0f, 0.0f);
-        dibujarCubo(12.0f, 0.2f, 8.0f);
-        glPopMatrix();
+        mesh.color(0.95f, 0.95f, 0.9f);
+        mesh.pushMatrix();
+        mesh.translate(0.0f, 3.0f, 0.0f);
+        dibujarCubo(mesh, 12.0f, 0.2f, 8.0f);
+        mesh.popMatrix();
     }
     
-    void dibujarParedes() {
+    void dibujarParedes(MeshBuilder& mesh) {
         // Pared trasera
-        glColor3f(0.7f, 0.8f, 0.9f);
-        glPushMatrix();
-        glTranslatef(0.0f, 0.0f, -4.0f);
-        dibujarCubo(12.0f, 6.0f, 0.2f);
-        glPopMatrix();
+        mesh.color(0.7f, 0.8f, 0.9f);
+        mesh.pushMatrix();
+        mesh.translate(0.0f, 0.0f, -4.0f);
+        dibujarCubo(mesh, 12.0f, 6.0f, 0.2f);
+        mesh.popMatrix();
         
         // Pared izquierda
-        glColor3f(0.7f, 0.8f, 0.9f);
-        glPushMatrix();
-        glTranslatef(-6.0f, 0.0f, 0.0f);
-        dibujarCubo(0.2f, 6.0f, 8.0f);
-        glPopMatrix();
+        mesh.color(0.7f, 0.8f, 0.9f);
+        mesh.pushMatrix();
+        mesh.translate(-6.0f, 0.0f, 0.0f);
+        dibujarCubo(mesh, 0.2f, 6.0f, 8.0f);
+        mesh.popMatrix();
         
         // Pared derecha
-        glColor3f(0.7f, 0.8f, 0.9f);
-        glPushMatrix();
-        glTranslatef(6.0f, 0.0f, 0.0f);
-        dibujarCubo(0.2f, 6.0f, 8.0f);
-        glPopMatrix();
+        mesh.color(0.7f, 0.8f, 0.9f);
+        mesh.pushMatrix();
+        mesh.translate(6.0f, 0.0f, 0.0f);
+        dibujarCubo(mesh, 0.2f, 6.0f, 8.0f);
+        mesh.popMatrix();
         
         // Divisor central
-        glColor3f(0.7f, 0.8f, 0.9f);
-        glPushMatrix();
-        glTranslatef(0.0f, 0.0f, 0.5f);
-        dibujarCubo(0.2f, 6.0f, 1.0f);
-        glPopMatrix();
+        mesh.color(0.7f, 0.8f, 0.9f);
+        mesh.pushMatrix();
+        mesh.translate(0.0f, 0.0f, 0.5f);
+        dibujarCubo(mesh, 0.2f, 6.0f, 1.0f);
+        mesh.popMatrix();
     }
     
-    void dibujarParedFrontalConPuerta() {
+    void dibujarParedFrontalConPuerta(MeshBuilder& mesh) {
         // Pared frontal - lado izquierdo
-        glColor3f(0.7f, 0.8f, 0.9f);
-        glPushMatrix();
-        glTranslatef(-3.5f, 0.0f, 4.0f);
-        dibujarCubo(5.0f, 6.0f, 0.2f);
-        glPopMatrix();
+        mesh.color(0.7f, 0.8f, 0.9f);
+        mesh.pushMatrix();
+        mesh.translate(-3.5f, 0.0f, 4.0f);
+        dibujarCubo(mesh, 5.0f, 6.0f, 0.2f);
+        mesh.popMatrix();
         
         // Pared frontal - lado derecho
-        glColor3f(0.7f, 0.8f, 0.9f);
-        glPushMatrix();
-        glTranslatef(3.5f, 0.0f, 4.0f);
-        dibujarCubo(5.0f, 6.0f, 0.2f);
-        glPopMatrix();
+        mesh.color(0.7f, 0.8f, 0.9f);
+        mesh.pushMatrix();
+        mesh.translate(3.5f, 0.0f, 4.0f);
+        dibujarCubo(mesh, 5.0f, 6.0f, 0.2f);
+        mesh.popMatrix();
         
         // Pared frontal - parte superior de la puerta
-        glColor3f(0.7f, 0.8f, 0.9f);
-        glPushMatrix();
-        glTranslatef(0.0f, 1.5f, 4.0f);
-        dibujarCubo(2.0f, 3.0f, 0.2f);
-        glPopMatrix();
+        mesh.color(0.7f, 0.8f, 0.9f);
+        mesh.pushMatrix();
+        mesh.translate(0.0f, 1.5f, 4.0f);
+        dibujarCubo(mesh, 2.0f, 3.0f, 0.2f);
+        mesh.popMatrix();
         
         // Marco de la puerta
-        glColor3f(0.6f, 0.4f, 0.2f);
+        mesh.color(0.6f, 0.4f, 0.2f);
         
         // Marco izquierdo
-        glPushMatrix();
-        glTranslatef(-1.1f, -1.0f, 4.05f);
-        dibujarCubo(0.2f, 4.0f, 0.1f);
-        glPopMatrix();
+        mesh.pushMatrix();
+        mesh.translate(-1.1f, -1.0f, 4.05f);
+        dibujarCubo(mesh, 0.2f, 4.0f, 0.1f);
+        mesh.popMatrix();
         
         // Marco derecho
-        glPushMatrix();
-        glTranslatef(1.1f, -1.0f, 4.05f);
-        dibujarCubo(0.2f, 4.0f, 0.1f);
-        glPopMatrix();
+        mesh.pushMatrix();
+        mesh.translate(1.1f, -1.0f, 4.05f);
+        dibujarCubo(mesh, 0.2f, 4.0f, 0.1f);
+        mesh.popMatrix();
         
         // Marco superior
-        glPushMatrix();
-        glTranslatef(0.0f, 1.0f, 4.05f);
-        dibujarCubo(2.2f, 0.2f, 0.1f);
-        glPopMatrix();
+        mesh.pushMatrix();
+        mesh.translate(0.0f, 1.0f, 4.05f);
+        dibujarCubo(mesh, 2.2f, 0.2f, 0.1f);
+        mesh.popMatrix();
         
         // Puerta
-        glColor3f(0.5f, 0.3f, 0.1f);
-        glPushMatrix();
-        glTranslatef(0.0f, -1.0f, 4.1f);
-        dibujarCubo(1.8f, 4.0f, 0.15f);
-        glPopMatrix();
+        mesh.color(0.5f, 0.3f, 0.1f);
+        mesh.pushMatrix();
+        mesh.translate(0.0f, -1.0f, 4.1f);
+        dibujarCubo(mesh, 1.8f, 4.0f, 0.15f);
+        mesh.popMatrix();
         
         // Manija de la puerta
-        glColor3f(0.8f, 0.8f, 0.3f); // Color dorado
-        glPushMatrix();
-        glTranslatef(0.7f, -0.8f, 4.2f);
-        dibujarCubo(0.1f, 0.1f, 0.05f);
-        glPopMatrix();
+        mesh.color(0.8f, 0.8f, 0.3f); // Color dorado
+        mesh.pushMatrix();
+        mesh.translate(0.7f, -0.8f, 4.2f);
+        dibujarCubo(mesh, 0.1f, 0.1f, 0.05f);
+        mesh.popMatrix();
     }
     
-    void dibujarSofa() {
+    void dibujarSofa(MeshBuilder& mesh) {
         // Base del sof?
-        glColor3f(0.8f, 0.7f, 0.5f);
-        glPushMatrix();
-        glTranslatef(-3.5f, -2.0f, -2.0f);
-        dibujarCubo(2.5f, 0.6f, 1.2f);
-        glPopMatrix();
+        mesh.color(0.8f, 0.7f, 0.5f);
+        mesh.pushMatrix();
+        mesh.translate(-3.5f, -2.0f, -2.0f);
+        dibujarCubo(mesh, 2.5f, 0.6f, 1.2f);
+        mesh.popMatrix();
         
         // Respaldo del sof?
-        glColor3f(0.8f, 0.7f, 0.5f);
-        glPushMatrix();
-        glTranslatef(-3.5f, -1.4f, -2.5f);
-        dibujarCubo(2.5f, 1.2f, 0.3f);
-        glPopMatrix();
+        mesh.color(0.8f, 0.7f, 0.5f);
+        mesh.pushMatrix();
+        mesh.translate(-3.5f, -1.4f, -2.5f);
+        dibujarCubo(mesh, 2.5f, 1.2f, 0.3f);
+        mesh.popMatrix();
         
         // Brazo izquierdo
-        glColor3f(0.8f, 0.7f, 0.5f);
-        glPushMatrix();
-        glTranslatef(-4.6f, -1.6f, -2.0f);
-        dibujarCubo(0.3f, 0.8f, 1.2f);
-        glPopMatrix();
+        mesh.color(0.8f, 0.7f, 0.5f);
+        mesh.pushMatrix();
+        mesh.translate(-4.6f, -1.6f, -2.0f);
+        dibujarCubo(mesh, 0.3f, 0.8f, 1.2f);
+        mesh.popMatrix();
         
         // Brazo derecho
-        glColor3f(0.8f, 0.7f, 0.5f);
-        glPushMatrix();
-        glTranslatef(-2.4f, -1.6f, -2.0f);
-        dibujarCubo(0.3f, 0.8f, 1.2f);
-        glPopMatrix();
+        mesh.color(0.8f, 0.7f, 0.5f);
+        mesh.pushMatrix();
+        mesh.translate(-2.4f, -1.6f, -2.0f);
+        dibujarCubo(mesh, 0.3f, 0.8f, 1.2f);
+        mesh.popMatrix();
     }
     
-    void dibujarSillon() {
+    void dibujarSillon(MeshBuilder& mesh) {
         // Base del sill?n
-        glColor3f(0.8f, 0.7f, 0.5f);
-        glPushMatrix();
-        glTranslatef(-1.5f, -2.0f, -2.8f);
-        dibujarCubo(1.2f, 0.6f, 1.0f);
-        glPopMatrix();
+        mesh.color(0.8f, 0.7f, 0.5f);
+        mesh.pushMatrix();
+        mesh.translate(-1.5f, -2.0f, -2.8f);
+        dibujarCubo(mesh, 1.2f, 0.6f, 1.0f);
+        mesh.popMatrix();
         
         // Respaldo del sill?n
-        glColor3f(0.8f, 0.7f, 0.5f);
-        glPushMatrix();
-        glTranslatef(-1.5f, -1.4f, -3.2f);
-        dibujarCubo(1.2f, 1.2f, 0.2f);
-        glPopMatrix();
+        mesh.color(0.8f, 0.7f, 0.5f);
+        mesh.pushMatrix();
+        mesh.translate(-1.5f, -1.4f, -3.2f);
+        dibujarCubo(mesh, 1.2f, 1.2f, 0.2f);
+        mesh.popMatrix();
         
         // Brazos del sill?n
-        glColor3f(0.8f, 0.7f, 0.5f);
-        glPushMatrix();
-        glTranslatef(-2.0f, -1.6f, -2.8f);
-        dibujarCubo(0.2f, 0.8f, 1.0f);
-        glPopMatrix();
-        
-        glPushMatrix();
-        glTranslatef(-1.0f, -1.6f, -2.8f);
-        dibujarCubo(0.2f, 0.8f, 1.0f);
-        glPopMatrix();
+        mesh.color(0.8f, 0.7f, 0.5f);
+        mesh.pushMatrix();
+        mesh.translate(-2.0f, -1.6f, -2.8f);
+        dibujarCubo(mesh, 0.2f, 0.8f, 1.0f);
+        mesh.popMatrix();
+        
+        mesh.pushMatrix();
+        mesh.translate(-1.0f, -1.6f, -2.8f);
+        dibujarCubo(mesh, 0.2f, 0.8f, 1.0f);
+        mesh.popMatrix();
     }
     
-    void dibujarMesaCentro() {
+    void dibujarMesaCentro(MeshBuilder& mesh) {
         // Superficie
-        glColor3f(0.4f, 0.2f, 0.1f);
-        glPushMatrix();
-        glTranslatef(-2.5f, -1.8f, -0.5f);
-        dibujarCubo(1.5f, 0.1f, 0.8f);
-        glPopMatrix();
+        mesh.color(0.4f, 0.2f, 0.1f);
+        mesh.pushMatrix();
+        mesh.translate(-2.5f, -1.8f, -0.5f);
+        dibujarCubo(mesh, 1.5f, 0.1f, 0.8f);
+        mesh.popMatrix();
         
         // Patas
-        glColor3f(0.3f, 0.15f, 0.05f);
+        mesh.color(0.3f, 0.15f, 0.05f);
         float offsetX[] = {-0.6f, 0.6f, -0.6f, 0.6f};
         float offsetZ[] = {-0.3f, -0.3f, 0.3f, 0.3f};
         
         for(int i = 0; i < 4; i++) {
-            glPushMatrix();
-            glTranslatef(-2.5f + offsetX[i], -2.3f, -0.5f + offsetZ[i]);
-            dibujarCubo(0.1f, 1.0f, 0.1f);
-            glPopMatrix();
+            mesh.pushMatrix();
+            mesh.translate(-2.5f + offsetX[i], -2.3f, -0.5f + offsetZ[i]);
+            dibujarCubo(mesh, 0.1f, 1.0f, 0.1f);
+            mesh.popMatrix();
         }
     }
     
-    void dibujarMesaComedor() {
+    void dibujarMesaComedor(MeshBuilder& mesh) {
         // Superficie
-        glColor3f(0.6f, 0.4f, 0.2f);
-        glPushMatrix();
-        glTranslatef(3.0f, -1.6f, 1.0f);
-        dibujarCubo(2.2f, 0.15f, 1.5f);
-        glPopMatrix();
+        mesh.color(0.6f, 0.4f, 0.2f);
+        mesh.pushMatrix();
+        mesh.translate(3.0f, -1.6f, 1.0f);
+        dibujarCubo(mesh, 2.2f, 0.15f, 1.5f);
+        mesh.popMatrix();
         
         // Patas
-        glColor3f(0.5f, 0.3f, 0.1f);
+        mesh.color(0.5f, 0.3f, 0.1f);
         float mesaOffsetX[] = {-0.9f, 0.9f, -0.9f, 0.9f};
         float mesaOffsetZ[] = {-0.6f, -0.6f, 0.6f, 0.6f};
         
         for(int i = 0; i < 4; i++) {
-            glPushMatrix();
-            glTranslatef(3.0f + mesaOffsetX[i], -2.3f, 1.0f + mesaOffsetZ[i]);
-            dibujarCubo(0.12f, 1.4f, 0.12f);
-            glPopMatrix();
+            mesh.pushMatrix();
+            mesh.translate(3.0f + mesaOffsetX[i], -2.3f, 1.0f + mesaOffsetZ[i]);
+            dibujarCubo(mesh, 0.12f, 1.4f, 0.12f);
+            mesh.popMatrix();
         }
         
         // Mantel
-        glColor3f(1.0f, 0.9f, 0.9f);
-        glPushMatrix();
-        glTranslatef(3.0f, -1.5f, 1.0f);
-        dibujarCubo(2.4f, 0.05f, 1.7f);
-        glPopMatrix();
+        mesh.color(1.0f, 0.9f, 0.9f);
+        mesh.pushMatrix();
+        mesh.translate(3.0f, -1.5f, 1.0f);
+        dibujarCubo(mesh, 2.4f, 0.05f, 1.7f);
+        mesh.popMatrix();
     }
     
-    void dibujarSillas() {
+    void dibujarSillas(MeshBuilder& mesh) {
         float posicionesX[] = {2.2f, 3.8f, 2.2f, 3.8f};
         float posicionesZ[] = {0.3f, 0.3f, 1.7f, 1.7f};
         
         for(int i = 0; i < 4; i++) {
             // Asiento
-            glColor3f(0.5f, 0.3f, 0.1f);
-            glPushMatrix();
-            glTranslatef(posicionesX[i], -2.2f, posicionesZ[i]);
-            dibujarCubo(0.4f, 0.1f, 0.4f);
-            glPopMatrix();
+            mesh.color(0.5f, 0.3f, 0.1f);
+            mesh.pushMatrix();
+            mesh.translate(posicionesX[i], -2.2f, posicionesZ[i]);
+            dibujarCubo(mesh, 0.4f, 0.1f, 0.4f);
+            mesh.popMatrix();
             
             // Respaldo
-            glColor3f(0.5f, 0.3f, 0.1f);
-            glPushMatrix();
-            glTranslatef(posicionesX[i], -1.5f, posicionesZ[i] + (i < 2 ? -0.15f : 0.15f));
-            dibujarCubo(0.4f, 1.2f, 0.1f);
-            glPopMatrix();
+            mesh.color(0.5f, 0.3f, 0.1f);
+            mesh.pushMatrix();
+            mesh.translate(posicionesX[i], -1.5f, posicionesZ[i] + (i < 2 ? -0.15f : 0.15f));
+            dibujarCubo(mesh, 0.4f, 1.2f, 0.1f);
+            mesh.popMatrix();
             
             // Patas
-            glColor3f(0.4f, 0.25f, 0.05f);
+            mesh.color(0.4f, 0.25f, 0.05f);
             float sillaOffsetX[] = {-0.15f, 0.15f, -0.15f, 0.15f};
             float sillaOffsetZ[] = {-0.15f, -0.15f, 0.15f, 0.15f};
             
             for(int j = 0; j < 4; j++) {
-                glPushMatrix();
-                glTranslatef(posicionesX[i] + sillaOffsetX[j], -2.6f, posicionesZ[i] + sillaOffsetZ[j]);
-                dibujarCubo(0.05f, 0.8f, 0.05f);
-                glPopMatrix();
+                mesh.pushMatrix();
+                mesh.translate(posicionesX[i] + sillaOffsetX[j], -2.6f, posicionesZ[i] + sillaOffsetZ[j]);
+                dibujarCubo(mesh, 0.05f, 0.8f, 0.05f);
+                mesh.popMatrix();
             }
         }
     }
     
-    void dibujarMuebleTV() {
+    void dibujarMuebleTV(MeshBuilder& mesh) {
         // Mueble bajo
-        glColor3f(0.6f, 0.4f, 0.2f);
-        glPushMatrix();
-        glTranslatef(0.0f, -2.4f, -3.5f);
-        dibujarCubo(2.0f, 0.8f, 0.6f);
-        glPopMatrix();
+        mesh.color(0.6f, 0.4f, 0.2f);
+        mesh.pushMatrix();
+        mesh.translate(0.0f, -2.4f, -3.5f);
+        dibujarCubo(mesh, 2.0f, 0.8f, 0.6f);
+        mesh.popMatrix();
         
         // TV (pantalla negra)
-        glColor3f(0.1f, 0.1f, 0.1f);
-        glPushMatrix();
-        glTranslatef(0.0f, -1.2f, -3.8f);
-        dibujarCubo(1.5f, 0.9f, 0.1f);
-        glPopMatrix();
+        mesh.color(0.1f, 0.1f, 0.1f);
+        mesh.pushMatrix();
+        mesh.translate(0.0f, -1.2f, -3.8f);
+        dibujarCubo(mesh, 1.5f, 0.9f, 0.1f);
+        mesh.popMatrix();
         
         // Marco de TV
-        glColor3f(0.2f, 0.2f, 0.2f);
-        glPushMatrix();
-        glTranslatef(0.0f, -1.2f, -3.75f);
-        dibujarCubo(1.6f, 1.0f, 0.05f);
-        glPopMatrix();
+        mesh.color(0.2f, 0.2f, 0.2f);
+        mesh.pushMatrix();
+        mesh.translate(0.0f, -1.2f, -3.75f);
+        dibujarCubo(mesh, 1.6f, 1.0f, 0.05f);
+        mesh.popMatrix();
     }
     
-    void dibujarCuadro() {
+    void dibujarCuadro(MeshBuilder& mesh) {
         // Marco
-        glColor3f(0.8f, 0.7f, 0.5f);
-        glPushMatrix();
-        glTranslatef(-3.5f, 0.5f, -3.9f);
-        dibujarCubo(1.0f, 0.7f, 0.05f);
-        glPopMatrix();
+        mesh.color(0.8f, 0.7f, 0.5f);
+        mesh.pushMatrix();
+        mesh.translate(-3.5f, 0.5f, -3.9f);
+        dibujarCubo(mesh, 1.0f, 0.7f, 0.05f);
+        mesh.popMatrix();
         
         // Imagen (simulada con color oscuro)
-        glColor3f(0.3f, 0.4f, 0.3f);
-        glPushMatrix();
-        glTranslatef(-3.5f, 0.5f, -3.85f);
-        dibujarCubo(0.8f, 0.5f, 0.02f);
-        glPopMatrix();
+        mesh.color(0.3f, 0.4f, 0.3f);
+        mesh.pushMatrix();
+        mesh.translate(-3.5f, 0.5f, -3.85f);
+        dibujarCubo(mesh, 0.8f, 0.5f, 0.02f);
+        mesh.popMatrix();
     }
 
 public:
@@ -360,34 +362,12 @@ public:
     
     ~FlorindaCasa() {}
     
-    // M?todo principal para dibujar toda la casa
-    void render() {
-        // Guardar estado actual de la matriz
-        glPushMatrix();
-        
-        // Dibujar todos los elementos de la casa
-        dibujarPiso();
-        dibujarTecho();
-        dibujarParedes();
-        dibujarParedFrontalConPuerta();
-        dibujarSofa();
-        dibujarSillon();
-        dibujarMesaCentro();
-        dibujarMesaComedor();
-        dibujarSillas();
-        dibujarMuebleTV();
-        dibujarCuadro();
-        
-        // Restaurar estado de la matriz
-        glPopMatrix();
-    }
-    
     // M?todo para inicializar la iluminaci?n (opcional)
     void inicializarIluminacion() {
-        glEnable(GL_DEPTH_TEST);
-        glEnable(GL_LIGHTING);
-        glEnable(GL_LIGHT0);
-        glEnable(GL_COLOR_MATERIAL);
+        RenderState::enable(GL_DEPTH_TEST);
+        RenderState::enable(GL_LIGHTING);
+        RenderState::enable(GL_LIGHT0);
+        RenderState::enable(GL_COLOR_MATERIAL);
         glColorMaterial(GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
         
         // Configurar luz
@@ -400,42 +380,26 @@ public:
         glLightfv(GL_LIGHT0, GL_DIFFUSE, luzDif);
     }
     
-    // M?todo para dibujar la casa en una posici?n espec?fica
-    void dibujarEnPosicion(float x, float y, float z) {
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        render();
-        glPopMatrix();
-    }
-    
-    // M?todo para dibujar la casa con escala espec?fica
-    void dibujarConEscala(float escala) {
-        glPushMatrix();
-        glScalef(escala, escala, escala);
-        render();
-        glPopMatrix();
-    }
-    
-    // M?todo para dibujar la casa con rotaci?n
-    void dibujarConRotacion(float anguloX, float anguloY, float anguloZ) {
-        glPushMatrix();
-        glRotatef(anguloX, 1.0f, 0.0f, 0.0f);
-        glRotatef(anguloY, 0.0f, 1.0f, 0.0f);
-        glRotatef(anguloZ, 0.0f, 0.0f, 1.0f);
-        render();
-        glPopMatrix();
-    }
-    
-    // M?todo completo con transformaciones
-    void dibujarCompleto(float x, float y, float z, float escala, float rotX, float rotY, float rotZ) {
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glRotatef(rotX, 1.0f, 0.0f, 0.0f);
-        glRotatef(rotY, 0.0f, 1.0f, 0.0f);
-        glRotatef(rotZ, 0.0f, 0.0f, 1.0f);
-        glScalef(escala, escala, escala);
-        render();
-        glPopMatrix();
+    // Grabar todos los elementos en 'mesh' con la matriz actual del builder
+    void grabarGeometria(MeshBuilder& mesh) {
+        // Guardar estado actual de la matriz
+        mesh.pushMatrix();
+        
+        // Dibujar todos los elementos de la casa
+        dibujarPiso(mesh);
+        dibujarTecho(mesh);
+        dibujarParedes(mesh);
+        dibujarParedFrontalConPuerta(mesh);
+        dibujarSofa(mesh);
+        dibujarSillon(mesh);
+        dibujarMesaCentro(mesh);
+        dibujarMesaComedor(mesh);
+        dibujarSillas(mesh);
+        dibujarMuebleTV(mesh);
+        dibujarCuadro(mesh);
+        
+        // Restaurar estado de la matriz
+        mesh.popMatrix();
     }
 };
 
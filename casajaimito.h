@@ -3,231 +3,234 @@
 
 #include <GL/glut.h>
 #include <cmath>
+#include "meshbuilder.h"
 
 class CasaJaimito {
 private:
-    void drawBox(float width, float height, float depth) {
-        glBegin(GL_QUADS);
+    void drawBox(MeshBuilder& mesh, float width, float height, float depth) {
+        mesh.begin(GL_QUADS);
         
         // Front face
-        glNormal3f(0.0f, 0.0f, 1.0f);
-        glVertex3f(-width/2, -height/2, depth/2);
-        glVertex3f(width/2, -height/2, depth/2);
-        glVertex3f(width/2, height/2, depth/2);
-        glVertex3f(-width/2, height/2, depth/2);
+        mesh.normal(0.0f, 0.0f, 1.0f);
+        mesh.vertex(-width/2, -height/2, depth/2);
+        mesh.vertex(width/2, -height/2, depth/2);
+        mesh.vertex(width/2, height/2, depth/2);
+        mesh.vertex(-width/2, height/2, depth/2);
         
         // Back face
-        glNormal3f(0.0f, 0.0f, -1.0f);
-        glVertex3f(-width/2, -height/2, -depth/2);
-        glVertex3f(-width/2, height/2, -depth/2);
-        glVertex3f(width/2, height/2, -depth/2);
-        glVertex3f(width/2, -height/2, -depth/2);
+        mesh.normal(0.0f, 0.0f, -1.0f);
+        mesh.vertex(-width/2, -height/2, -depth/2);
+        mesh.vertex(-width/2, height/2, -depth/2);
+        mesh.vertex(width/2, height/2, -depth/2);
+        mesh.vertex(width/2, -height/2, -depth/2);
         
         // Top face
-        glNormal3f(0.0f, 1.0f, 0.0f);
-        glVertex3f(-width/2, height/2, -depth/2);
-        glVertex3f(-width/2, height/2, depth/2);
-        glVertex3f(width/2, height/2, depth/2);
-        glVertex3f(width/2, height/2, -depth/2);
+        mesh.normal(0.0f, 1.0f, 0.0f);
+        mesh.vertex(-width/2, height/2, -depth/2);
+        mesh.vertex(-width/2, height/2, depth/2);
+        mesh.vertex(width/2, height/2, depth/2);
+        mesh.vertex(width/2, height/2, -depth/2);
         
         // Bottom face
-        glNormal3f(0.0f, -1.0f, 0.0f);
-        glVertex3f(-width/2, -height/2, -depth/2);
-        glVertex3f(width/2, -height/2, -depth/2);
-        glVertex3f(width/2, -height/2, depth/2);
-        glVertex3f(-width/2, -height/2, depth/2);
+        mesh.normal(0.0f, -1.0f, 0.0f);
+        mesh.vertex(-width/2, -height/2, -depth/2);
+        mesh.vertex(width/2, -height/2, -depth/2);
+        mesh.vertex(width/2, -height/2, depth/2);
+        mesh.vertex(-width/2, -height/2, depth/2);
         
         // Right face
-        glNormal3f(1.0f, 0.0f, 0.0f);
-        glVertex3f(width/2, -height/2, -depth/2);
-        glVertex3f(width/2, height/2, -depth/2);
-        glVertex3f(width/2, height/2, depth/2);
-        glVertex3f(width/2, -height/2, depth/2);
+        mesh.normal(1.0f, 0.0f, 0.0f);
+        mesh.vertex(width/2, -height/2, -depth/2);
+        mesh.vertex(width/2, height/2, -depth/2);
+        mesh.vertex(width/2, height/2, depth/2);
+        mesh.vertex(width/2, -height/2, depth/2);
         
         // Left face
-        glNormal3f(-1.0f, 0.0f, 0.0f);
-        glVertex3f(-width/2, -height/2, -depth/2);
-        glVertex3f(-width/2, -height/2, depth/2);
-        glVertex3f(-width/2, height/2, depth/2);
-        glVertex3f(-width/2, height/2, -depth/2);
+        mesh.normal(-1.0f, 0.0f, 0.0f);
+        mesh.vertex(-width/2, -height/2, -depth/2);
+        mesh.vertex(-width/2, -height/2, depth/2);
+        mesh.vertex(-width/2, height/2, depth/2);
+        mesh.vertex(-width/2, height/2, -depth/2);
         
-        glEnd();
+        mesh.end();
     }
 
-    void setColor(float r, float g, float b) {
-        glColor3f(r, g, b);
+    void setColor(MeshBuilder& mesh, float r, float g, float b) {
+        mesh.color(r, g, b);
     }
 
-    void drawWall(float width, float height, float depth) {
-        this->drawBox(width, height, depth);
+    void drawWall(MeshBuilder& mesh, float width, float height, float depth) {
+        this->drawBox(mesh, width, height, depth);
     }
 
-    void drawDoor(float width, float height) {
+    void drawDoor(MeshBuilder& mesh, float width, float height) {
         // Door frame (dark brown)
-        setColor(0.4f, 0.2f, 0.1f);
-        glPushMatrix();
-        glTranslatef(0, 0, 0.02f);
-        this->drawWall(width + 0.2f, height + 0.2f, 0.05f);
-        glPopMatrix();
+        setColor(mesh, 0.4f, 0.2f, 0.1f);
+        mesh.pushMatrix();
+        mesh.translate(0, 0, 0.02f);
+        this->drawWall(mesh, width + 0.2f, height + 0.2f, 0.05f);
+        mesh.popMatrix();
         
         // Door (brown)
-        setColor(0.6f, 0.4f, 0.2f);
-        glPushMatrix();
-        glTranslatef(0, 0, 0.04f);
-        this->drawWall(width, height, 0.04f);
-        glPopMatrix();
+        setColor(mesh, 0.6f, 0.4f, 0.2f);
+        mesh.pushMatrix();
+        mesh.translate(0, 0, 0.04f);
+        this->drawWall(mesh, width, height, 0.04f);
+        mesh.popMatrix();
         
         // Door handle
-        setColor(0.8f, 0.8f, 0.2f);
-        glPushMatrix();
-        glTranslatef(width/3, 0, 0.06f);
-        glutSolidSphere(0.05f, 8, 8);
-        glPopMatrix();
+        setColor(mesh, 0.8f, 0.8f, 0.2f);
+        mesh.pushMatrix();
+        mesh.translate(width/3, 0, 0.06f);
+        mesh.solidSphere(0.05f, 8, 8);
+        mesh.popMatrix();
         
         // Door lines
-        setColor(0.3f, 0.2f, 0.1f);
-        glLineWidth(3.0f);
-        glBegin(GL_LINES);
-        glNormal3f(0.0f, 0.0f, 1.0f);
+        setColor(mesh, 0.3f, 0.2f, 0.1f);
+        mesh.lineWidth(3.0f);
+        mesh.begin(GL_LINES);
+        mesh.normal(0.0f, 0.0f, 1.0f);
         // Vertical center line
-        glVertex3f(0, -height/2 + 0.1f, 0.05f);
-        glVertex3f(0, height/2 - 0.1f, 0.05f);
+        mesh.vertex(0, -height/2 + 0.1f, 0.05f);
+        mesh.vertex(0, height/2 - 0.1f, 0.05f);
         // Horizontal center line
-        glVertex3f(-width/2 + 0.1f, 0, 0.05f);
-        glVertex3f(width/2 - 0.1f, 0, 0.05f);
-        glEnd();
+        mesh.vertex(-width/2 + 0.1f, 0, 0.05f);
+        mesh.vertex(width/2 - 0.1f, 0, 0.05f);
+        mesh.end();
     }
 
-    void drawWindow(float width, float height) {
+    void drawWindow(MeshBuilder& mesh, float width, float height) {
         // Window frame (brown)
-        setColor(0.4f, 0.2f, 0.1f);
-        glPushMatrix();
-        glTranslatef(0, 0, 0.02f);
-        this->drawWall(width + 0.1f, height + 0.1f, 0.05f);
-        glPopMatrix();
+        setColor(mesh, 0.4f, 0.2f, 0.1f);
+        mesh.pushMatrix();
+        mesh.translate(0, 0, 0.02f);
+        this->drawWall(mesh, width + 0.1f, height + 0.1f, 0.05f);
+        mesh.popMatrix();
         
         // Window glass (light blue)
-        setColor(0.7f, 0.9f, 1.0f);
-        glPushMatrix();
-        glTranslatef(0, 0, 0.04f);
-        this->drawWall(width, height, 0.02f);
-        glPopMatrix();
+        setColor(mesh, 0.7f, 0.9f, 1.0f);
+        mesh.pushMatrix();
+        mesh.translate(0, 0, 0.04f);
+        this->drawWall(mesh, width, height, 0.02f);
+        mesh.popMatrix();
         
         // Window divisions
-        setColor(0.4f, 0.2f, 0.1f);
-        glLineWidth(2.0f);
-        glBegin(GL_LINES);
-        glNormal3f(0.0f, 0.0f, 1.0f);
+        setColor(mesh, 0.4f, 0.2f, 0.1f);
+        mesh.lineWidth(2.0f);
+        mesh.begin(GL_LINES);
+        mesh.normal(0.0f, 0.0f, 1.0f);
         // Vertical lines
         for(int i = 1; i < 3; i++) {
             float x = -width/2 + (width/3) * i;
-            glVertex3f(x, -height/2, 0.05f);
-            glVertex3f(x, height/2, 0.05f);
+            mesh.vertex(x, -height/2, 0.05f);
+            mesh.vertex(x, height/2, 0.05f);
         }
         // Horizontal lines
         for(int i = 1; i < 3; i++) {
             float y = -height/2 + (height/3) * i;
-            glVertex3f(-width/2, y, 0.05f);
-            glVertex3f(width/2, y, 0.05f);
+            mesh.vertex(-width/2, y, 0.05f);
+            mesh.vertex(width/2, y, 0.05f);
         }
-        glEnd();
+        mesh.end();
     }
 
-    void drawRoof(float width, float depth, float height, float thickness) {
-        setColor(0.8f, 0.2f, 0.2f); // Red for the roof
-        glPushMatrix();
-        glTranslatef(0, height - thickness / 2.0f, 0);
-        this->drawBox(width, thickness, depth);
-        glPopMatrix();
+    void drawRoof(MeshBuilder& mesh, float width, float depth, float height, float thickness) {
+        setColor(mesh, 0.8f, 0.2f, 0.2f); // Red for the roof
+        mesh.pushMatrix();
+        mesh.translate(0, height - thickness / 2.0f, 0);
+        this->drawBox(mesh, width, thickness, depth);
+        mesh.popMatrix();
     }
 
 public:
     CasaJaimito() {}
     ~CasaJaimito() {}
 
-    void render() {
-        glPushMatrix();
+    // Grabar toda la casa en 'mesh' con la matriz actual del builder
+    // (el batch esttico de World sale de aqu)
+    void buildGeometry(MeshBuilder& mesh) {
+        mesh.pushMatrix();
         
         // Main wall (yellow) - Front
-        setColor(0.9f, 0.8f, 0.3f);
-        glPushMatrix();
-        glTranslatef(0, 1.5f, 1.5f);
-        this->drawWall(4.0f, 3.0f, 0.1f);
-        glPopMatrix();
+        setColor(mesh, 0.9f, 0.8f, 0.3f);
+        mesh.pushMatrix();
+        mesh.translate(0, 1.5f, 1.5f);
+        this->drawWall(mesh, 4.0f, 3.0f, 0.1f);
+        mesh.popMatrix();
         
         // Left wall (green)
-        setColor(0.4f, 0.7f, 0.3f);
-        glPushMatrix();
-        glTranslatef(-2.0f, 1.5f, 0.0f);
-        glRotatef(90, 0, 1, 0);
-        this->drawWall(3.0f, 3.0f, 0.1f);
-        glPopMatrix();
+        setColor(mesh, 0.4f, 0.7f, 0.3f);
+        mesh.pushMatrix();
+        mesh.translate(-2.0f, 1.5f, 0.0f);
+        mesh.rotate(90, 0, 1, 0);
+        this->drawWall(mesh, 3.0f, 3.0f, 0.1f);
+        mesh.popMatrix();
         
         // Right wall (pink)
-        setColor(0.9f, 0.5f, 0.7f);
-        glPushMatrix();
-        glTranslatef(2.0f, 1.5f, 0.0f);
-        glRotatef(-90, 0, 1, 0);
-        this->drawWall(3.0f, 3.0f, 0.1f);
-        glPopMatrix();
+        setColor(mesh, 0.9f, 0.5f, 0.7f);
+        mesh.pushMatrix();
+        mesh.translate(2.0f, 1.5f, 0.0f);
+        mesh.rotate(-90, 0, 1, 0);
+        this->drawWall(mesh, 3.0f, 3.0f, 0.1f);
+        mesh.popMatrix();
         
         // Back wall
-        setColor(0.8f, 0.6f, 0.4f);
-        glPushMatrix();
-        glTranslatef(0, 1.5f, -1.5f);
-        this->drawWall(4.0f, 3.0f, 0.1f);
-        glPopMatrix();
+        setColor(mesh, 0.8f, 0.6f, 0.4f);
+        mesh.pushMatrix();
+        mesh.translate(0, 1.5f, -1.5f);
+        this->drawWall(mesh, 4.0f, 3.0f, 0.1f);
+        mesh.popMatrix();
         
         // Main door (on the front wall)
-        glPushMatrix();
-        glTranslatef(0, 1.0f, 1.55f);
-        this->drawDoor(0.8f, 2.0f);
-        glPopMatrix();
+        mesh.pushMatrix();
+        mesh.translate(0, 1.0f, 1.55f);
+        this->drawDoor(mesh, 0.8f, 2.0f);
+        mesh.popMatrix();
 
         // Window on the left wall
-        glPushMatrix();
-        glTranslatef(-2.05f, 1.8f, 0.5f);
-        glRotatef(90, 0, 1, 0);
-        this->drawWindow(1.0f, 1.0f);
-        glPopMatrix();
+        mesh.pushMatrix();
+        mesh.translate(-2.05f, 1.8f, 0.5f);
+        mesh.rotate(90, 0, 1, 0);
+        this->drawWindow(mesh, 1.0f, 1.0f);
+        mesh.popMatrix();
 
         // Window on the right wall
-        glPushMatrix();
-        glTranslatef(2.05f, 1.8f, 0.5f);
-        glRotatef(-90, 0, 1, 0);
-        this->drawWindow(1.0f, 1.0f);
-        glPopMatrix();
+        mesh.pushMatrix();
+        mesh.translate(2.05f, 1.8f, 0.5f);
+        mesh.rotate(-90, 0, 1, 0);
+        this->drawWindow(mesh, 1.0f, 1.0f);
+        mesh.popMatrix();
         
         // Floor/base
-        setColor(0.5f, 0.5f, 0.5f);
-        glPushMatrix();
-        glTranslatef(0, -0.1f, 0.0f);
-        this->drawBox(4.2f, 0.2f, 3.2f);
-        glPopMatrix();
+        setColor(mesh, 0.5f, 0.5f, 0.5f);
+        mesh.pushMatrix();
+        mesh.translate(0, -0.1f, 0.0f);
+        this->drawBox(mesh, 4.2f, 0.2f, 3.2f);
+        mesh.popMatrix();
         
         // Flat roof
-        setColor(0.8f, 0.2f, 0.2f);
-        glPushMatrix();
-        glTranslatef(0, 3.0f, 0.0f);
-        this->drawRoof(4.2f, 3.2f, 0.2f, 0.2f);
-        glPopMatrix();
+        setColor(mesh, 0.8f, 0.2f, 0.2f);
+        mesh.pushMatrix();
+        mesh.translate(0, 3.0f, 0.0f);
+        this->drawRoof(mesh, 4.2f, 3.2f, 0.2f, 0.2f);
+        mesh.popMatrix();
         
         // Small decorative details
         // Pot next to the door
-        setColor(0.6f, 0.3f, 0.1f);
-        glPushMatrix();
-        glTranslatef(-1.8f, 0.3f, 1.6f);
-        glutSolidCube(0.3f);
-        glPopMatrix();
+        setColor(mesh, 0.6f, 0.3f, 0.1f);
+        mesh.pushMatrix();
+        mesh.translate(-1.8f, 0.3f, 1.6f);
+        mesh.solidCube(0.3f);
+        mesh.popMatrix();
         
         // Plant in the pot
-        setColor(0.2f, 0.8f, 0.2f);
-        glPushMatrix();
-        glTranslatef(-1.8f, 0.6f, 1.6f);
-        glutSolidSphere(0.15f, 8, 8);
-        glPopMatrix();
+        setColor(mesh, 0.2f, 0.8f, 0.2f);
+        mesh.pushMatrix();
+        mesh.translate(-1.8f, 0.6f, 1.6f);
+        mesh.solidSphere(0.15f, 8, 8);
+        mesh.popMatrix();
         
-        glPopMatrix();
+        mesh.popMatrix();
     }
 };
 
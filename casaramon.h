@@ -5,317 +5,319 @@
 #include <GL/glu.h>
 #include <GL/gl.h>
 #include <cmath>
+#include "meshbuilder.h"
+#include "renderstate.h"
 
 class CasaRamon {
 private:
     // Funcin auxiliar para dibujar un cubo con normales correctas para iluminacin
-    void drawCube(float x, float y, float z, float width, float height, float depth, float r, float g, float b) {
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glColor3f(r, g, b);
+    void drawCube(MeshBuilder& mesh, float x, float y, float z, float width, float height, float depth, float r, float g, float b) {
+        mesh.pushMatrix();
+        mesh.translate(x, y, z);
+        mesh.color(r, g, b);
 
-        glBegin(GL_QUADS);
+        mesh.begin(GL_QUADS);
         
         // Front face (Positive Z)
-        glNormal3f(0.0f, 0.0f, 1.0f);
-        glVertex3f(0, 0, depth);
-        glVertex3f(width, 0, depth);
-        glVertex3f(width, height, depth);
-        glVertex3f(0, height, depth);
+        mesh.normal(0.0f, 0.0f, 1.0f);
+        mesh.vertex(0, 0, depth);
+        mesh.vertex(width, 0, depth);
+        mesh.vertex(width, height, depth);
+        mesh.vertex(0, height, depth);
 
         // Back face (Negative Z)
-        glNormal3f(0.0f, 0.0f, -1.0f);
-        glVertex3f(width, 0, 0);
-        glVertex3f(0, 0, 0);
-        glVertex3f(0, height, 0);
-        glVertex3f(width, height, 0);
+        mesh.normal(0.0f, 0.0f, -1.0f);
+        mesh.vertex(width, 0, 0);
+        mesh.vertex(0, 0, 0);
+        mesh.vertex(0, height, 0);
+        mesh.vertex(width, height, 0);
 
         // Left face (Negative X)
-        glNormal3f(-1.0f, 0.0f, 0.0f);
-        glVertex3f(0, 0, 0);
-        glVertex3f(0, 0, depth);
-        glVertex3f(0, height, depth);
-        glVertex3f(0, height, 0);
+        mesh.normal(-1.0f, 0.0f, 0.0f);
+        mesh.vertex(0, 0, 0);
+        mesh.vertex(0, 0, depth);
+        mesh.vertex(0, height, depth);
+        mesh.vertex(0, height, 0);
 
         // Right face (Positive X)
-        glNormal3f(1.0f, 0.0f, 0.0f);
-        glVertex3f(width, 0, depth);
-        glVertex3f(width, 0, 0);
-        glVertex3f(width, height, 0);
-        glVertex3f(width, height, depth);
+        mesh.normal(1.0f, 0.0f, 0.0f);
+        mesh.vertex(width, 0, depth);
+        mesh.vertex(width, 0, 0);
+        mesh.vertex(width, height, 0);
+        mesh.vertex(width, height, depth);
 
         // Top face (Positive Y)
-        glNormal3f(0.0f, 1.0f, 0.0f);
-        glVertex3f(0, height, depth);
-        glVertex3f(width, height, depth);
-        glVertex3f(width, height, 0);
-        glVertex3f(0, height, 0);
+        mesh.normal(0.0f, 1.0f, 0.0f);
+        mesh.vertex(0, height, depth);
+        mesh.vertex(width, height, depth);
+        mesh.vertex(width, height, 0);
+        mesh.vertex(0, height, 0);
 
         // Bottom face (Negative Y)
-        glNormal3f(0.0f, -1.0f, 0.0f);
-        glVertex3f(0, 0, 0);
-        glVertex3f(width, 0, 0);
-        glVertex3f(width, 0, depth);
-        glVertex3f(0, 0, depth);
+        mesh.normal(0.0f, -1.0f, 0.0f);
+        mesh.vertex(0, 0, 0);
+        mesh.vertex(width, 0, 0);
+        mesh.vertex(width, 0, depth);
+        mesh.vertex(0, 0, depth);
         
-        glEnd();
-        glPopMatrix();
+        mesh.end();
+        mesh.popMatrix();
     }
 
     // Dibuja las paredes, el suelo y el techo de la habitacin
-    void drawRoom() {
+    void drawRoom(MeshBuilder& mesh) {
         // Pared trasera (en Z = -6) - Normal hacia adelante para verla desde adentro
-        glColor3f(0.6f, 0.8f, 0.9f);
-        glBegin(GL_QUADS);
-        glNormal3f(0.0f, 0.0f, 1.0f);
-        glVertex3f(-6, 0, -6);
-        glVertex3f(6, 0, -6);
-        glVertex3f(6, 5.5f, -6);
-        glVertex3f(-6, 5.5f, -6);
-        glEnd();
+        mesh.color(0.6f, 0.8f, 0.9f);
+        mesh.begin(GL_QUADS);
+        mesh.normal(0.0f, 0.0f, 1.0f);
+        mesh.vertex(-6, 0, -6);
+        mesh.vertex(6, 0, -6);
+        mesh.vertex(6, 5.5f, -6);
+        mesh.vertex(-6, 5.5f, -6);
+        mesh.end();
 
         // Pared izquierda (en X = -6) - Normal hacia la derecha para verla desde adentro
-        glColor3f(0.6f, 0.8f, 0.9f);
-        glBegin(GL_QUADS);
-        glNormal3f(1.0f, 0.0f, 0.0f);
-        glVertex3f(-6, 0, -6);
-        glVertex3f(-6, 0, 6);
-        glVertex3f(-6, 5.5f, 6);
-        glVertex3f(-6, 5.5f, -6);
-        glEnd();
+        mesh.color(0.6f, 0.8f, 0.9f);
+        mesh.begin(GL_QUADS);
+        mesh.normal(1.0f, 0.0f, 0.0f);
+        mesh.vertex(-6, 0, -6);
+        mesh.vertex(-6, 0, 6);
+        mesh.vertex(-6, 5.5f, 6);
+        mesh.vertex(-6, 5.5f, -6);
+        mesh.end();
 
         // Pared derecha (en X = 6) - Normal hacia la izquierda para verla desde adentro
-        glColor3f(0.6f, 0.8f, 0.9f);
-        glBegin(GL_QUADS);
-        glNormal3f(-1.0f, 0.0f, 0.0f);
-        glVertex3f(6, 0, 6);
-        glVertex3f(6, 0, -6);
-        glVertex3f(6, 5.5f, -6);
-        glVertex3f(6, 5.5f, 6);
-        glEnd();
+        mesh.color(0.6f, 0.8f, 0.9f);
+        mesh.begin(GL_QUADS);
+        mesh.normal(-1.0f, 0.0f, 0.0f);
+        mesh.vertex(6, 0, 6);
+        mesh.vertex(6, 0, -6);
+        mesh.vertex(6, 5.5f, -6);
+        mesh.vertex(6, 5.5f, 6);
+        mesh.end();
 
         // Pared frontal con ventana y puerta (en Z = 6) - Normal hacia atrs para verla desde adentro
-        glColor3f(0.6f, 0.8f, 0.9f);
-        glNormal3f(0.0f, 0.0f, -1.0f);
+        mesh.color(0.6f, 0.8f, 0.9f);
+        mesh.normal(0.0f, 0.0f, -1.0f);
 
         // Parte izquierda de la pared frontal
-        glBegin(GL_QUADS);
-        glVertex3f(-6, 0, 6);
-        glVertex3f(-4.0f, 0, 6);
-        glVertex3f(-4.0f, 5.5f, 6);
-        glVertex3f(-6, 5.5f, 6);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-6, 0, 6);
+        mesh.vertex(-4.0f, 0, 6);
+        mesh.vertex(-4.0f, 5.5f, 6);
+        mesh.vertex(-6, 5.5f, 6);
+        mesh.end();
 
         // Parte entre ventana y puerta
-        glBegin(GL_QUADS);
-        glVertex3f(-2.5f, 0, 6);
-        glVertex3f(-1.0f, 0, 6);
-        glVertex3f(-1.0f, 5.5f, 6);
-        glVertex3f(-2.5f, 5.5f, 6);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-2.5f, 0, 6);
+        mesh.vertex(-1.0f, 0, 6);
+        mesh.vertex(-1.0f, 5.5f, 6);
+        mesh.vertex(-2.5f, 5.5f, 6);
+        mesh.end();
 
         // Parte superior de la ventana
-        glBegin(GL_QUADS);
-        glVertex3f(-4.0f, 3.0f, 6);
-        glVertex3f(-2.5f, 3.0f, 6);
-        glVertex3f(-2.5f, 5.5f, 6);
-        glVertex3f(-4.0f, 5.5f, 6);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-4.0f, 3.0f, 6);
+        mesh.vertex(-2.5f, 3.0f, 6);
+        mesh.vertex(-2.5f, 5.5f, 6);
+        mesh.vertex(-4.0f, 5.5f, 6);
+        mesh.end();
 
         // Parte inferior de la ventana
-        glBegin(GL_QUADS);
-        glVertex3f(-4.0f, 0, 6);
-        glVertex3f(-2.5f, 0, 6);
-        glVertex3f(-2.5f, 1.0f, 6);
-        glVertex3f(-4.0f, 1.0f, 6);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-4.0f, 0, 6);
+        mesh.vertex(-2.5f, 0, 6);
+        mesh.vertex(-2.5f, 1.0f, 6);
+        mesh.vertex(-4.0f, 1.0f, 6);
+        mesh.end();
 
         // Parte superior de la pared frontal (encima de la puerta)
-        glBegin(GL_QUADS);
-        glVertex3f(-1.0f, 3.0f, 6);
-        glVertex3f(1.0f, 3.0f, 6);
-        glVertex3f(1.0f, 5.5f, 6);
-        glVertex3f(-1.0f, 5.5f, 6);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-1.0f, 3.0f, 6);
+        mesh.vertex(1.0f, 3.0f, 6);
+        mesh.vertex(1.0f, 5.5f, 6);
+        mesh.vertex(-1.0f, 5.5f, 6);
+        mesh.end();
 
         // Parte derecha de la pared frontal
-        glBegin(GL_QUADS);
-        glVertex3f(1.0f, 0, 6);
-        glVertex3f(6, 0, 6);
-        glVertex3f(6, 5.5f, 6);
-        glVertex3f(1.0f, 5.5f, 6);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(1.0f, 0, 6);
+        mesh.vertex(6, 0, 6);
+        mesh.vertex(6, 5.5f, 6);
+        mesh.vertex(1.0f, 5.5f, 6);
+        mesh.end();
 
         // Ventana (cristal celeste claro)
-        glColor3f(0.8f, 0.9f, 1.0f);
-        glBegin(GL_QUADS);
-        glNormal3f(0.0f, 0.0f, -1.0f);
-        glVertex3f(-4.0f, 1.0f, 6.01f);
-        glVertex3f(-2.5f, 1.0f, 6.01f);
-        glVertex3f(-2.5f, 3.0f, 6.01f);
-        glVertex3f(-4.0f, 3.0f, 6.01f);
-        glEnd();
+        mesh.color(0.8f, 0.9f, 1.0f);
+        mesh.begin(GL_QUADS);
+        mesh.normal(0.0f, 0.0f, -1.0f);
+        mesh.vertex(-4.0f, 1.0f, 6.01f);
+        mesh.vertex(-2.5f, 1.0f, 6.01f);
+        mesh.vertex(-2.5f, 3.0f, 6.01f);
+        mesh.vertex(-4.0f, 3.0f, 6.01f);
+        mesh.end();
 
         // Marco de la ventana (blanco)
-        glColor3f(0.9f, 0.9f, 0.9f);
-        glNormal3f(0.0f, 0.0f, -1.0f);
+        mesh.color(0.9f, 0.9f, 0.9f);
+        mesh.normal(0.0f, 0.0f, -1.0f);
         
         // Marco superior
-        glBegin(GL_QUADS);
-        glVertex3f(-4.1f, 2.9f, 6.02f);
-        glVertex3f(-2.4f, 2.9f, 6.02f);
-        glVertex3f(-2.4f, 3.1f, 6.02f);
-        glVertex3f(-4.1f, 3.1f, 6.02f);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-4.1f, 2.9f, 6.02f);
+        mesh.vertex(-2.4f, 2.9f, 6.02f);
+        mesh.vertex(-2.4f, 3.1f, 6.02f);
+        mesh.vertex(-4.1f, 3.1f, 6.02f);
+        mesh.end();
         
         // Marco inferior
-        glBegin(GL_QUADS);
-        glVertex3f(-4.1f, 0.9f, 6.02f);
-        glVertex3f(-2.4f, 0.9f, 6.02f);
-        glVertex3f(-2.4f, 1.1f, 6.02f);
-        glVertex3f(-4.1f, 1.1f, 6.02f);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-4.1f, 0.9f, 6.02f);
+        mesh.vertex(-2.4f, 0.9f, 6.02f);
+        mesh.vertex(-2.4f, 1.1f, 6.02f);
+        mesh.vertex(-4.1f, 1.1f, 6.02f);
+        mesh.end();
         
         // Marco izquierdo
-        glBegin(GL_QUADS);
-        glVertex3f(-4.1f, 1.0f, 6.02f);
-        glVertex3f(-3.9f, 1.0f, 6.02f);
-        glVertex3f(-3.9f, 3.0f, 6.02f);
-        glVertex3f(-4.1f, 3.0f, 6.02f);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-4.1f, 1.0f, 6.02f);
+        mesh.vertex(-3.9f, 1.0f, 6.02f);
+        mesh.vertex(-3.9f, 3.0f, 6.02f);
+        mesh.vertex(-4.1f, 3.0f, 6.02f);
+        mesh.end();
         
         // Marco derecho
-        glBegin(GL_QUADS);
-        glVertex3f(-2.6f, 1.0f, 6.02f);
-        glVertex3f(-2.4f, 1.0f, 6.02f);
-        glVertex3f(-2.4f, 3.0f, 6.02f);
-        glVertex3f(-2.6f, 3.0f, 6.02f);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-2.6f, 1.0f, 6.02f);
+        mesh.vertex(-2.4f, 1.0f, 6.02f);
+        mesh.vertex(-2.4f, 3.0f, 6.02f);
+        mesh.vertex(-2.6f, 3.0f, 6.02f);
+        mesh.end();
         
         // Divisin central vertical
-        glBegin(GL_QUADS);
-        glVertex3f(-3.35f, 1.0f, 6.02f);
-        glVertex3f(-3.15f, 1.0f, 6.02f);
-        glVertex3f(-3.15f, 3.0f, 6.02f);
-        glVertex3f(-3.35f, 3.0f, 6.02f);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-3.35f, 1.0f, 6.02f);
+        mesh.vertex(-3.15f, 1.0f, 6.02f);
+        mesh.vertex(-3.15f, 3.0f, 6.02f);
+        mesh.vertex(-3.35f, 3.0f, 6.02f);
+        mesh.end();
         
         // Divisin central horizontal
-        glBegin(GL_QUADS);
-        glVertex3f(-4.0f, 1.9f, 6.02f);
-        glVertex3f(-2.5f, 1.9f, 6.02f);
-        glVertex3f(-2.5f, 2.1f, 6.02f);
-        glVertex3f(-4.0f, 2.1f, 6.02f);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-4.0f, 1.9f, 6.02f);
+        mesh.vertex(-2.5f, 1.9f, 6.02f);
+        mesh.vertex(-2.5f, 2.1f, 6.02f);
+        mesh.vertex(-4.0f, 2.1f, 6.02f);
+        mesh.end();
 
         // Puerta (caf/marrn)
-        glColor3f(0.5f, 0.3f, 0.2f);
-        glBegin(GL_QUADS);
-        glNormal3f(0.0f, 0.0f, -1.0f);
-        glVertex3f(-1.0f, 0, 6);
-        glVertex3f(1.0f, 0, 6);
-        glVertex3f(1.0f, 3.0f, 6);
-        glVertex3f(-1.0f, 3.0f, 6);
-        glEnd();
+        mesh.color(0.5f, 0.3f, 0.2f);
+        mesh.begin(GL_QUADS);
+        mesh.normal(0.0f, 0.0f, -1.0f);
+        mesh.vertex(-1.0f, 0, 6);
+        mesh.vertex(1.0f, 0, 6);
+        mesh.vertex(1.0f, 3.0f, 6);
+        mesh.vertex(-1.0f, 3.0f, 6);
+        mesh.end();
 
         // Nmero de la puerta "72"
-        glColor3f(0.9f, 0.9f, 0.9f);
-        glBegin(GL_QUADS);
-        glNormal3f(0.0f, 0.0f, -1.0f);
-        glVertex3f(-0.3f, 2.2f, 6.01f);
-        glVertex3f(0.3f, 2.2f, 6.01f);
-        glVertex3f(0.3f, 2.6f, 6.01f);
-        glVertex3f(-0.3f, 2.6f, 6.01f);
-        glEnd();
+        mesh.color(0.9f, 0.9f, 0.9f);
+        mesh.begin(GL_QUADS);
+        mesh.normal(0.0f, 0.0f, -1.0f);
+        mesh.vertex(-0.3f, 2.2f, 6.01f);
+        mesh.vertex(0.3f, 2.2f, 6.01f);
+        mesh.vertex(0.3f, 2.6f, 6.01f);
+        mesh.vertex(-0.3f, 2.6f, 6.01f);
+        mesh.end();
 
         // Manija de la puerta
-        glColor3f(0.8f, 0.7f, 0.3f);
-        glBegin(GL_QUADS);
-        glNormal3f(0.0f, 0.0f, -1.0f);
-        glVertex3f(0.6f, 1.4f, 6.01f);
-        glVertex3f(0.8f, 1.4f, 6.01f);
-        glVertex3f(0.8f, 1.6f, 6.01f);
-        glVertex3f(0.6f, 1.6f, 6.01f);
-        glEnd();
+        mesh.color(0.8f, 0.7f, 0.3f);
+        mesh.begin(GL_QUADS);
+        mesh.normal(0.0f, 0.0f, -1.0f);
+        mesh.vertex(0.6f, 1.4f, 6.01f);
+        mesh.vertex(0.8f, 1.4f, 6.01f);
+        mesh.vertex(0.8f, 1.6f, 6.01f);
+        mesh.vertex(0.6f, 1.6f, 6.01f);
+        mesh.end();
 
         // Suelo gris (en Y = 0)
-        glColor3f(0.7f, 0.7f, 0.7f);
-        glBegin(GL_QUADS);
-        glNormal3f(0.0f, 1.0f, 0.0f);
-        glVertex3f(-6, 0, -6);
-        glVertex3f(6, 0, -6);
-        glVertex3f(6, 0, 6);
-        glVertex3f(-6, 0, 6);
-        glEnd();
+        mesh.color(0.7f, 0.7f, 0.7f);
+        mesh.begin(GL_QUADS);
+        mesh.normal(0.0f, 1.0f, 0.0f);
+        mesh.vertex(-6, 0, -6);
+        mesh.vertex(6, 0, -6);
+        mesh.vertex(6, 0, 6);
+        mesh.vertex(-6, 0, 6);
+        mesh.end();
 
         // Techo blanco (en Y = 5.5)
-        glColor3f(0.9f, 0.9f, 0.9f);
-        glBegin(GL_QUADS);
-        glNormal3f(0.0f, -1.0f, 0.0f);
-        glVertex3f(-6, 5.5f, -6);
-        glVertex3f(-6, 5.5f, 6);
-        glVertex3f(6, 5.5f, 6);
-        glVertex3f(6, 5.5f, -6);
-        glEnd();
+        mesh.color(0.9f, 0.9f, 0.9f);
+        mesh.begin(GL_QUADS);
+        mesh.normal(0.0f, -1.0f, 0.0f);
+        mesh.vertex(-6, 5.5f, -6);
+        mesh.vertex(-6, 5.5f, 6);
+        mesh.vertex(6, 5.5f, 6);
+        mesh.vertex(6, 5.5f, -6);
+        mesh.end();
     }
 
     // Dibuja el sof
-    void drawSofa() {
+    void drawSofa(MeshBuilder& mesh) {
         // Base del sof (marrn)
-        drawCube(-2.5f, 0.0f, -2.0f, 3.0f, 0.8f, 1.5f, 0.6f, 0.4f, 0.2f);
+        drawCube(mesh, -2.5f, 0.0f, -2.0f, 3.0f, 0.8f, 1.5f, 0.6f, 0.4f, 0.2f);
 
         // Respaldo del sof
-        drawCube(-2.5f, 0.8f, -2.0f, 3.0f, 1.2f, 0.3f, 0.6f, 0.4f, 0.2f);
+        drawCube(mesh, -2.5f, 0.8f, -2.0f, 3.0f, 1.2f, 0.3f, 0.6f, 0.4f, 0.2f);
 
         // Brazos del sof (izquierda y derecha)
-        drawCube(-2.5f, 0.8f, -2.0f, 0.3f, 0.8f, 1.5f, 0.6f, 0.4f, 0.2f);
-        drawCube(2.2f, 0.8f, -2.0f, 0.3f, 0.8f, 1.5f, 0.6f, 0.4f, 0.2f);
+        drawCube(mesh, -2.5f, 0.8f, -2.0f, 0.3f, 0.8f, 1.5f, 0.6f, 0.4f, 0.2f);
+        drawCube(mesh, 2.2f, 0.8f, -2.0f, 0.3f, 0.8f, 1.5f, 0.6f, 0.4f, 0.2f);
     }
 
     // Dibuja la mesa
-    void drawTable() {
+    void drawTable(MeshBuilder& mesh) {
         // Superficie de la mesa
-        drawCube(-0.8f, 1.5f, 1.0f, 1.6f, 0.1f, 1.2f, 0.8f, 0.6f, 0.4f);
+        drawCube(mesh, -0.8f, 1.5f, 1.0f, 1.6f, 0.1f, 1.2f, 0.8f, 0.6f, 0.4f);
 
         // Patas de la mesa
-        drawCube(-0.7f, 0.0f, 1.1f, 0.1f, 1.5f, 0.1f, 0.8f, 0.6f, 0.4f);
-        drawCube(0.6f, 0.0f, 1.1f, 0.1f, 1.5f, 0.1f, 0.8f, 0.6f, 0.4f);
-        drawCube(-0.7f, 0.0f, 2.1f, 0.1f, 1.5f, 0.1f, 0.8f, 0.6f, 0.4f);
-        drawCube(0.6f, 0.0f, 2.1f, 0.1f, 1.5f, 0.1f, 0.8f, 0.6f, 0.4f);
+        drawCube(mesh, -0.7f, 0.0f, 1.1f, 0.1f, 1.5f, 0.1f, 0.8f, 0.6f, 0.4f);
+        drawCube(mesh, 0.6f, 0.0f, 1.1f, 0.1f, 1.5f, 0.1f, 0.8f, 0.6f, 0.4f);
+        drawCube(mesh, -0.7f, 0.0f, 2.1f, 0.1f, 1.5f, 0.1f, 0.8f, 0.6f, 0.4f);
+        drawCube(mesh, 0.6f, 0.0f, 2.1f, 0.1f, 1.5f, 0.1f, 0.8f, 0.6f, 0.4f);
     }
 
     // Dibuja una silla en la posicin especificada
-    void drawChair(float x, float z) {
+    void drawChair(MeshBuilder& mesh, float x, float z) {
         // Asiento
-        drawCube(x, 0.8f, z, 0.8f, 0.1f, 0.8f, 0.8f, 0.6f, 0.4f);
+        drawCube(mesh, x, 0.8f, z, 0.8f, 0.1f, 0.8f, 0.8f, 0.6f, 0.4f);
 
         // Respaldo
-        drawCube(x, 0.9f, z, 0.8f, 1.0f, 0.1f, 0.8f, 0.6f, 0.4f);
+        drawCube(mesh, x, 0.9f, z, 0.8f, 1.0f, 0.1f, 0.8f, 0.6f, 0.4f);
 
         // Patas
-        drawCube(x, 0.0f, z, 0.1f, 0.8f, 0.1f, 0.8f, 0.6f, 0.4f);
-        drawCube(x + 0.7f, 0.0f, z, 0.1f, 0.8f, 0.1f, 0.8f, 0.6f, 0.4f);
-        drawCube(x, 0.0f, z + 0.7f, 0.1f, 0.8f, 0.1f, 0.8f, 0.6f, 0.4f);
-        drawCube(x + 0.7f, 0.0f, z + 0.7f, 0.1f, 0.8f, 0.1f, 0.8f, 0.6f, 0.4f);
+        drawCube(mesh, x, 0.0f, z, 0.1f, 0.8f, 0.1f, 0.8f, 0.6f, 0.4f);
+        drawCube(mesh, x + 0.7f, 0.0f, z, 0.1f, 0.8f, 0.1f, 0.8f, 0.6f, 0.4f);
+        drawCube(mesh, x, 0.0f, z + 0.7f, 0.1f, 0.8f, 0.1f, 0.8f, 0.6f, 0.4f);
+        drawCube(mesh, x + 0.7f, 0.0f, z + 0.7f, 0.1f, 0.8f, 0.1f, 0.8f, 0.6f, 0.4f);
     }
 
     // Dibuja el aparador con objetos encima
-    void drawSideboard() {
-        drawCube(2.5f, 0.0f, -4.5f, 2.5f, 1.5f, 1.0f, 0.5f, 0.3f, 0.2f);
+    void drawSideboard(MeshBuilder& mesh) {
+        drawCube(mesh, 2.5f, 0.0f, -4.5f, 2.5f, 1.5f, 1.0f, 0.5f, 0.3f, 0.2f);
 
         // Objetos decorativos sobre el aparador
-        drawCube(2.7f, 1.5f, -4.3f, 0.3f, 0.5f, 0.3f, 0.9f, 0.1f, 0.1f);
-        drawCube(3.2f, 1.5f, -4.3f, 0.2f, 0.3f, 0.2f, 0.8f, 0.8f, 0.2f);
-        drawCube(4.2f, 1.5f, -4.3f, 0.4f, 0.4f, 0.4f, 0.6f, 0.4f, 0.2f);
+        drawCube(mesh, 2.7f, 1.5f, -4.3f, 0.3f, 0.5f, 0.3f, 0.9f, 0.1f, 0.1f);
+        drawCube(mesh, 3.2f, 1.5f, -4.3f, 0.2f, 0.3f, 0.2f, 0.8f, 0.8f, 0.2f);
+        drawCube(mesh, 4.2f, 1.5f, -4.3f, 0.4f, 0.4f, 0.4f, 0.6f, 0.4f, 0.2f);
     }
 
     // Dibuja la estantera con libros
-    void drawBookshelf() {
-        drawCube(-5.5f, 0.0f, -3.0f, 0.5f, 4.5f, 2.0f, 0.7f, 0.5f, 0.3f);
+    void drawBookshelf(MeshBuilder& mesh) {
+        drawCube(mesh, -5.5f, 0.0f, -3.0f, 0.5f, 4.5f, 2.0f, 0.7f, 0.5f, 0.3f);
 
         // Estantes individuales
         for(int i = 0; i < 6; i++) {
-            drawCube(-5.5f, 0.7f * (i + 1), -3.0f, 0.5f, 0.05f, 2.0f, 0.8f, 0.6f, 0.4f);
+            drawCube(mesh, -5.5f, 0.7f * (i + 1), -3.0f, 0.5f, 0.05f, 2.0f, 0.8f, 0.6f, 0.4f);
         }
 
         // Libros en los estantes
@@ -326,117 +328,81 @@ private:
                 float r = 0.3f + (book % 3) * 0.2f;
                 float g = 0.2f + (shelf % 2) * 0.3f;
                 float b = 0.4f + ((book + shelf) % 2) * 0.3f;
-                drawCube(-5.4f, bookY, bookZ, 0.3f, 0.6f, 0.25f, r, g, b);
+                drawCube(mesh, -5.4f, bookY, bookZ, 0.3f, 0.6f, 0.25f, r, g, b);
             }
         }
     }
 
     // Dibuja el silln
-    void drawArmchair() {
+    void drawArmchair(MeshBuilder& mesh) {
         // Base del silln
-        drawCube(-4.5f, 0.0f, 2.0f, 1.2f, 0.8f, 1.2f, 0.4f, 0.6f, 0.3f);
+        drawCube(mesh, -4.5f, 0.0f, 2.0f, 1.2f, 0.8f, 1.2f, 0.4f, 0.6f, 0.3f);
         // Respaldo
-        drawCube(-4.5f, 0.8f, 2.0f, 1.2f, 1.0f, 0.3f, 0.4f, 0.6f, 0.3f);
+        drawCube(mesh, -4.5f, 0.8f, 2.0f, 1.2f, 1.0f, 0.3f, 0.4f, 0.6f, 0.3f);
         // Brazos
-        drawCube(-4.5f, 0.8f, 2.0f, 0.3f, 0.6f, 1.2f, 0.4f, 0.6f, 0.3f);
-        drawCube(-3.6f, 0.8f, 2.0f, 0.3f, 0.6f, 1.2f, 0.4f, 0.6f, 0.3f);
+        drawCube(mesh, -4.5f, 0.8f, 2.0f, 0.3f, 0.6f, 1.2f, 0.4f, 0.6f, 0.3f);
+        drawCube(mesh, -3.6f, 0.8f, 2.0f, 0.3f, 0.6f, 1.2f, 0.4f, 0.6f, 0.3f);
     }
 
     // Dibuja las decoraciones de la pared
-    void drawWallDecorations() {
+    void drawWallDecorations(MeshBuilder& mesh) {
         // Cuadros
-        drawCube(-2.0f, 3.0f, -5.9f, 0.8f, 0.6f, 0.1f, 0.9f, 0.9f, 0.8f);
-        drawCube(1.0f, 3.0f, -5.9f, 0.6f, 0.8f, 0.1f, 0.9f, 0.9f, 0.8f);
-        drawCube(3.5f, 3.5f, -5.9f, 0.5f, 0.4f, 0.1f, 0.2f, 0.3f, 0.8f);
+        drawCube(mesh, -2.0f, 3.0f, -5.9f, 0.8f, 0.6f, 0.1f, 0.9f, 0.9f, 0.8f);
+        drawCube(mesh, 1.0f, 3.0f, -5.9f, 0.6f, 0.8f, 0.1f, 0.9f, 0.9f, 0.8f);
+        drawCube(mesh, 3.5f, 3.5f, -5.9f, 0.5f, 0.4f, 0.1f, 0.2f, 0.3f, 0.8f);
 
         // Decoracin triangular
-        glColor3f(0.8f, 0.2f, 0.3f);
-        glBegin(GL_TRIANGLES);
-        glNormal3f(0.0f, 0.0f, 1.0f);
+        mesh.color(0.8f, 0.2f, 0.3f);
+        mesh.begin(GL_TRIANGLES);
+        mesh.normal(0.0f, 0.0f, 1.0f);
         for(int i = 0; i < 5; i++) {
             float x = -3.0f + i * 1.2f;
-            glVertex3f(x, 4.8f, -5.8f);
-            glVertex3f(x + 0.4f, 4.8f, -5.8f);
-            glVertex3f(x + 0.2f, 4.5f, -5.8f);
+            mesh.vertex(x, 4.8f, -5.8f);
+            mesh.vertex(x + 0.4f, 4.8f, -5.8f);
+            mesh.vertex(x + 0.2f, 4.5f, -5.8f);
         }
-        glEnd();
+        mesh.end();
     }
 
     // Dibuja la alfombra en el suelo
-    void drawRug() {
+    void drawRug(MeshBuilder& mesh) {
         // Base de la alfombra
-        glColor3f(0.8f, 0.7f, 0.6f);
-        glBegin(GL_QUADS);
-        glNormal3f(0.0f, 1.0f, 0.0f);
-        glVertex3f(-2.0f, 0.01f, 0.5f);
-        glVertex3f(2.0f, 0.01f, 0.5f);
-        glVertex3f(2.0f, 0.01f, 3.0f);
-        glVertex3f(-2.0f, 0.01f, 3.0f);
-        glEnd();
+        mesh.color(0.8f, 0.7f, 0.6f);
+        mesh.begin(GL_QUADS);
+        mesh.normal(0.0f, 1.0f, 0.0f);
+        mesh.vertex(-2.0f, 0.01f, 0.5f);
+        mesh.vertex(2.0f, 0.01f, 0.5f);
+        mesh.vertex(2.0f, 0.01f, 3.0f);
+        mesh.vertex(-2.0f, 0.01f, 3.0f);
+        mesh.end();
 
         // Patrn decorativo
-        glColor3f(0.6f, 0.5f, 0.4f);
-        glNormal3f(0.0f, 1.0f, 0.0f);
+        mesh.color(0.6f, 0.5f, 0.4f);
+        mesh.normal(0.0f, 1.0f, 0.0f);
         for(int i = 0; i < 3; i++) {
             for(int j = 0; j < 2; j++) {
                 float x1 = -1.5f + i * 1.0f;
                 float z1 = 0.8f + j * 1.0f;
-                glBegin(GL_QUADS);
-                glVertex3f(x1, 0.02f, z1);
-                glVertex3f(x1 + 0.6f, 0.02f, z1);
-                glVertex3f(x1 + 0.6f, 0.02f, z1 + 0.6f);
-                glVertex3f(x1, 0.02f, z1 + 0.6f);
-                glEnd();
+                mesh.begin(GL_QUADS);
+                mesh.vertex(x1, 0.02f, z1);
+                mesh.vertex(x1 + 0.6f, 0.02f, z1);
+                mesh.vertex(x1 + 0.6f, 0.02f, z1 + 0.6f);
+                mesh.vertex(x1, 0.02f, z1 + 0.6f);
+                mesh.end();
             }
         }
     }
 
 public:
-    // Funcin para renderizar toda la casa de Ramn
-    void render() {
-        glPushMatrix();
-        
-        // Configurar el estado de renderizado
-        glEnable(GL_DEPTH_TEST);
-        glEnable(GL_NORMALIZE);
-        glEnable(GL_COLOR_MATERIAL);
-        glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
-        
-        // Configurar material especular
-        GLfloat mat_specular[] = {0.3f, 0.3f, 0.3f, 1.0f};
-        GLfloat mat_shininess[] = {10.0f};
-        glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, mat_specular);
-        glMaterialfv(GL_FRONT_AND_BACK, GL_SHININESS, mat_shininess);
-        
-        // Deshabilitar face culling para ver todas las caras
-        glDisable(GL_CULL_FACE);
-        
-        // Dibujar todos los componentes
-        drawRoom();
-        drawRug();
-        drawSofa();
-        drawTable();
-        drawChair(-1.5f, 0.2f);
-        drawChair(0.7f, 0.2f);
-        drawChair(-1.5f, 2.8f);
-        drawChair(0.7f, 2.8f);
-        drawSideboard();
-        drawBookshelf();
-        drawArmchair();
-        drawWallDecorations();
-
-        glPopMatrix();
-    }
-
     // Inicializacin de OpenGL
     void init() {
-        glEnable(GL_DEPTH_TEST);
-        glEnable(GL_COLOR_MATERIAL);
+        RenderState::enable(GL_DEPTH_TEST);
+        RenderState::enable(GL_COLOR_MATERIAL);
         glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
-        glEnable(GL_NORMALIZE);
+        RenderState::enable(GL_NORMALIZE);
         
         // Deshabilitar face culling
-        glDisable(GL_CULL_FACE);
+        RenderState::disable(GL_CULL_FACE);
         
         // Configurar material especular
         GLfloat mat_specular[] = {0.3f, 0.3f, 0.3f, 1.0f};
@@ -447,6 +413,35 @@ public:
         // Habilitar iluminacin de dos lados
         glLightModeli(GL_LIGHT_MODEL_TWO_SIDE, GL_TRUE);
     }
+
+    // Grabar el cuarto y los muebles en 'mesh' con la matriz actual del builder.
+    // El brillo y el culling quedan puestos en el builder, igual que antes
+    // quedaban puestos en OpenGL para lo que se dibujaba despus.
+    void buildGeometry(MeshBuilder& mesh) {
+        mesh.pushMatrix();
+        
+        // Material con brillo bajo
+        mesh.shininess(10.0f);
+        
+        // Deshabilitar face culling para ver todas las caras
+        mesh.cullFace(false);
+        
+        // Dibujar todos los componentes
+        drawRoom(mesh);
+        drawRug(mesh);
+        drawSofa(mesh);
+        drawTable(mesh);
+        drawChair(mesh, -1.5f, 0.2f);
+        drawChair(mesh, 0.7f, 0.2f);
+        drawChair(mesh, -1.5f, 2.8f);
+        drawChair(mesh, 0.7f, 2.8f);
+        drawSideboard(mesh);
+        drawBookshelf(mesh);
+        drawArmchair(mesh);
+        drawWallDecorations(mesh);
+
+        mesh.popMatrix();
+    }
 };
 
 #endif // CASA_RAMON_H
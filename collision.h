@@ -1,9 +1,25 @@
 #ifndef COLLISION_H
 #define COLLISION_H
 
+#include <windows.h>
 #include <vector>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <algorithm> // Para std::min, std::max
+#include "threadpool.h"
+
+// Ancho del kernel SIMD del narrowphase: 8 cajas por instruccin con AVX,
+// 4 con SSE y ruta escalar si el compilador no genera ninguno de los dos.
+#if defined(__AVX__)
+#include <immintrin.h>
+#define COLLISION_SIMD_WIDTH 8
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define COLLISION_SIMD_WIDTH 4
+#else
+#define COLLISION_SIMD_WIDTH 1
+#endif
 
 // Estructura para representar un cubo colisionable
 struct CollisionBox {
@@ -43,44 +59,1155 @@ struct CollisionResult {
                         normalX(0.0f), normalY(0.0f), normalZ(0.0f) {}
 };
 
+// Nodo del rbol de volmenes envolventes (BVH) que acelera las consultas
+// contra las cajas estticas. Las hojas guardan un rango dentro de bvhIndices.
+struct BVHNode {
+    float minX, minY, minZ;
+    float maxX, maxY, maxZ;
+    int left, right;     // Hijos del nodo (-1 en las hojas)
+    int first, count;    // Rango de cajas en bvhIndices (solo hojas)
+
+    BVHNode() : minX(0.0f), minY(0.0f), minZ(0.0f),
+                maxX(0.0f), maxY(0.0f), maxZ(0.0f),
+                left(-1), right(-1), first(0), count(0) {}
+
+    bool isLeaf() const { return left < 0; }
+
+    bool overlaps(float qMinX, float qMinY, float qMinZ,
+                  float qMaxX, float qMaxY, float qMaxZ) const {
+        return qMinX <= maxX && qMaxX >= minX &&
+               qMinY <= maxY && qMaxY >= minY &&
+               qMinZ <= maxZ && qMaxZ >= minZ;
+    }
+};
+
+// Resultado de un barrido: primer contacto a lo largo del desplazamiento
+struct SweepResult {
+    bool hit;
+    float toi;                       // Fraccin del desplazamiento recorrida hasta el contacto
+    float normalX, normalY, normalZ; // Normal de la cara contra la que se choca
+
+    SweepResult() : hit(false), toi(1.0f), normalX(0.0f), normalY(0.0f), normalZ(0.0f) {}
+};
+
+// Resultado de un rayo o de un sphere cast
+struct RaycastHit {
+    bool hit;
+    float distance;                  // Distancia desde el origen hasta el primer contacto
+    float normalX, normalY, normalZ; // Normal de la superficie alcanzada
+
+    RaycastHit() : hit(false), distance(0.0f), normalX(0.0f), normalY(0.0f), normalZ(0.0f) {}
+};
+
+// Contacto de la esfera con una superficie, linealizado como un plano
+struct CollisionContact {
+    float normalX, normalY, normalZ; // Normal que aleja a la esfera de la superficie
+    float separation;                // Distancia a la superficie (negativa si hay penetracin)
+
+    CollisionContact() : normalX(0.0f), normalY(1.0f), normalZ(0.0f), separation(0.0f) {}
+};
+
+// Todos los contactos de una esfera reunidos en una sola consulta. Incluye los que
+// estn dentro de un margen aunque todava no penetren, para que el solver no
+// empuje a la esfera dentro de una superficie vecina.
+struct ContactManifold {
+    static const int MAX_CONTACTS = 16;
+    CollisionContact contacts[MAX_CONTACTS];
+    int count;
+
+    ContactManifold() : count(0) {}
+
+    // Con el arreglo lleno se descarta el contacto ms separado
+    void add(const CollisionContact& contact) {
+        if (count < MAX_CONTACTS) {
+            contacts[count++] = contact;
+            return;
+        }
+        int farthest = 0;
+        for (int i = 1; i < count; ++i) {
+            if (contacts[i].separation > contacts[farthest].separation) farthest = i;
+        }
+        if (contact.separation < contacts[farthest].separation) {
+            contacts[farthest] = contact;
+        }
+    }
+};
+
+// Huella XZ y altura superior de una caja, duplicada en cada celda de la
+// grilla de soporte para no tener que leer la caja completa al consultar.
+struct SupportEntry {
+    float minX, maxX;
+    float minZ, maxZ;
+    float topY;
+};
+
+// Espejo estructura-de-arreglos de las cajas con min/max ya calculados,
+// para que el kernel SIMD cargue un mismo lmite de varias cajas a la vez.
+struct CollisionBoxSoA {
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+
+    void resize(size_t count) {
+        minX.resize(count); minY.resize(count); minZ.resize(count);
+        maxX.resize(count); maxY.resize(count); maxZ.resize(count);
+    }
+
+    void clear() {
+        minX.clear(); minY.clear(); minZ.clear();
+        maxX.clear(); maxY.clear(); maxZ.clear();
+    }
+
+    size_t size() const { return minX.size(); }
+};
+
+// Cuerpo dinmico (autos, objetos que se mueven). Se actualiza cada frame y no
+// entra al BVH esttico; lo ordena el sweep-and-prune sobre el eje X.
+struct DynamicBody {
+    float x, y, z;                            // Centro
+    float halfWidth, halfHeight, halfDepth;   // Semiejes (todos iguales al radio si es esfera)
+    bool isSphere;
+
+    DynamicBody() : x(0.0f), y(0.0f), z(0.0f),
+                    halfWidth(0.5f), halfHeight(0.5f), halfDepth(0.5f), isSphere(false) {}
+
+    float getMinX() const { return x - halfWidth; }
+    float getMaxX() const { return x + halfWidth; }
+    float getMinY() const { return y - halfHeight; }
+    float getMaxY() const { return y + halfHeight; }
+    float getMinZ() const { return z - halfDepth; }
+    float getMaxZ() const { return z + halfDepth; }
+};
+
+// Vista de solo lectura sobre los datos que usan las consultas. Apunta a los
+// vectores propios despus de buildBroadphase() o directamente dentro del
+// archivo horneado cuando el mundo se carg con loadBaked().
+struct CollisionWorldView {
+    const CollisionBox* boxes;
+    int boxCount;
+    const BVHNode* nodes;
+    int nodeCount;
+    const int* indices;                       // ndice original de cada caja del espejo SoA
+    const float* minX; const float* minY; const float* minZ;
+    const float* maxX; const float* maxY; const float* maxZ;
+    const int* cellStart;                     // Grilla de soporte (CSR)
+    const SupportEntry* cellEntries;
+    int cellEntryCount;
+
+    CollisionWorldView() { memset(this, 0, sizeof(*this)); }
+};
+
+// Cabecera del archivo horneado. Todas las secciones van alineadas a 16 bytes
+// y se usan en el lugar, sin copiarlas, despus de mapear el archivo.
+struct CollisionBakeHeader {
+    char magic[4];             // "CHCB"
+    unsigned int version;      // COLLISION_BAKE_VERSION
+    unsigned int leafSize;     // Las hojas dependen del ancho SIMD con que se horne
+    unsigned int structSizes;  // sizeof(CollisionBox) | sizeof(BVHNode) << 8 | sizeof(SupportEntry) << 16
+    unsigned int fileSize;
+    int boxCount, nodeCount, soaCount, cellCount, entryCount;
+    int cellsX, cellsZ;
+    float originX, originZ, cellSize;
+    unsigned int boxesOffset, nodesOffset, indicesOffset, soaOffset;
+    unsigned int cellStartOffset, entriesOffset;
+    unsigned int sourceHash;   // Hash de las cajas de setupWorldCollisions() antes de simplificarlas
+};
+
+// Tolerancia con la que simplifyBoxes() considera dos caras alineadas
+#define COLLISION_MERGE_TOLERANCE 0.02f
+
+// Incrementar cada vez que cambie simplifyBoxes(), el BVH o el formato del archivo, para que
+// los archivos horneados viejos se descarten. Los cambios en setupWorldCollisions() ya los
+// detecta el hash de las cajas guardado en la cabecera.
+#define COLLISION_BAKE_VERSION 3
+#define COLLISION_BAKE_FILE "collision.bin"
+
 class CollisionSystem {
 private:
     std::vector<CollisionBox> boxes;
     float groundLevel;
-    
+
+    // Broadphase esttico: se construye una vez despus de setupWorldCollisions()
+    // y se reconstruye solo si se aaden o quitan cajas.
+    // Cada hoja cabe en un solo bloque del kernel SIMD
+    static const int BVH_LEAF_SIZE = COLLISION_SIMD_WIDTH > 4 ? COLLISION_SIMD_WIDTH : 4;
+    static const int BVH_STACK_SIZE = 64;
+    std::vector<BVHNode> bvhNodes;
+    std::vector<int> bvhIndices;
+    CollisionBoxSoA soa;        // Lmites de las cajas en el orden de bvhIndices
+    bool broadphaseDirty;
+
+    // Capa dinmica: cuerpos en movimiento ordenados por minX (sweep-and-prune).
+    // Entre frames los cuerpos se mueven poco, as que reordenar por insercin
+    // cuesta casi O(n) en lugar de volver a ordenar desde cero.
+    std::vector<DynamicBody> dynamicBodies;
+    std::vector<int> dynamicOrder;    // ndices de dynamicBodies ordenados por minX
+    float dynamicMaxWidthX;           // Ancho mximo en X, acota el barrido hacia atrs
+    bool dynamicDirty;
+
+    // Hilos para checkCollisionBatch(); se crean en el primer lote grande
+    ThreadPool* batchPool;
+    static const int BATCH_GRAIN = 64;   // Esferas por bloque de trabajo
+
+    // Sin copias: el sistema es dueo del pool y del archivo mapeado
+    CollisionSystem(const CollisionSystem&);
+    CollisionSystem& operator=(const CollisionSystem&);
+
+    // Tarea del pool: cada bloque escribe su propio rango de resultados
+    struct CollisionBatchTask : public ParallelTask {
+        CollisionSystem* system;
+        const CollisionSphere* spheres;
+        CollisionResult* results;
+
+        void run(int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                const CollisionSphere& sphere = spheres[i];
+                results[i] = system->checkCollision(sphere.x, sphere.y, sphere.z, sphere.radius);
+            }
+        }
+    };
+
+    // Datos activos para las consultas (vectores propios o archivo mapeado)
+    CollisionWorldView world;
+    HANDLE bakeFile;
+    HANDLE bakeMapping;
+    const unsigned char* bakeView;  // NULL si el mundo no viene de un archivo horneado
+
+    // Apuntar la vista a los vectores recin construidos
+    void bindOwnedStorage() {
+        world.boxes = boxes.empty() ? NULL : &boxes[0];
+        world.boxCount = (int)boxes.size();
+        world.nodes = bvhNodes.empty() ? NULL : &bvhNodes[0];
+        world.nodeCount = (int)bvhNodes.size();
+        world.indices = bvhIndices.empty() ? NULL : &bvhIndices[0];
+        world.minX = &soa.minX[0]; world.minY = &soa.minY[0]; world.minZ = &soa.minZ[0];
+        world.maxX = &soa.maxX[0]; world.maxY = &soa.maxY[0]; world.maxZ = &soa.maxZ[0];
+        world.cellStart = supportCellStart.empty() ? NULL : &supportCellStart[0];
+        world.cellEntries = supportEntries.empty() ? NULL : &supportEntries[0];
+        world.cellEntryCount = (int)supportEntries.size();
+    }
+
+    // Cerrar el archivo horneado si hay uno mapeado
+    void unmapBaked() {
+        if (bakeView) UnmapViewOfFile(bakeView);
+        if (bakeMapping) CloseHandle(bakeMapping);
+        if (bakeFile && bakeFile != INVALID_HANDLE_VALUE) CloseHandle(bakeFile);
+        bakeView = NULL;
+        bakeMapping = NULL;
+        bakeFile = NULL;
+        world = CollisionWorldView();
+    }
+
+    // Antes de modificar un mundo cargado desde archivo, copiar sus cajas a
+    // los vectores propios y soltar el mapeo
+    void detachBaked() {
+        if (!bakeView) return;
+        boxes.assign(world.boxes, world.boxes + world.boxCount);
+        unmapBaked();
+        broadphaseDirty = true;
+    }
+
+    static unsigned int alignBakeOffset(unsigned int offset) {
+        return (offset + 15u) & ~15u;
+    }
+
+    // Una seccin del archivo horneado: alineada, despus de la cabecera y dentro del archivo
+    static bool bakeSectionFits(unsigned int offset, int count, unsigned long long elementSize,
+                                unsigned int fileSize) {
+        if (count < 0 || offset % 16 != 0 || offset < sizeof(CollisionBakeHeader)) return false;
+        return (unsigned long long)offset + (unsigned long long)count * elementSize <= fileSize;
+    }
+
+    // Comprobar que la cabecera es coherente y que cada seccin cae dentro del
+    // archivo antes de apuntar la vista a l. Solo se lee la cabecera, as que
+    // el mapeo no se recorre entero al cargar: los nodos del BVH y la grilla
+    // se comprueban al usarlos (ver descendBvh(), bvhLeafInRange() y
+    // queryHighestSupport()). Los ndices de bvhIndices solo desempatan
+    // contactos y nunca se usan para leer memoria.
+    static bool validateBaked(const unsigned char* view, unsigned int fileSize) {
+        const CollisionBakeHeader* header = (const CollisionBakeHeader*)view;
+        if (header->nodeCount <= 0 || header->soaCount < header->boxCount + COLLISION_SIMD_WIDTH ||
+            header->cellsX < 0 || header->cellsZ < 0 ||
+            header->cellsX > SUPPORT_GRID_MAX_CELLS + 1 || header->cellsZ > SUPPORT_GRID_MAX_CELLS + 1 ||
+            header->cellCount != header->cellsX * header->cellsZ ||
+            header->entryCount < 0 || (header->cellCount == 0 && header->entryCount != 0) ||
+            !(header->cellSize > 0.0f)) {
+            return false;
+        }
+
+        unsigned long long soaStride = ((unsigned long long)header->soaCount * sizeof(float) + 15u) & ~15ull;
+        if (!bakeSectionFits(header->boxesOffset, header->boxCount, sizeof(CollisionBox), fileSize) ||
+            !bakeSectionFits(header->nodesOffset, header->nodeCount, sizeof(BVHNode), fileSize) ||
+            !bakeSectionFits(header->indicesOffset, header->boxCount, sizeof(int), fileSize) ||
+            !bakeSectionFits(header->soaOffset, 6, soaStride, fileSize) ||
+            !bakeSectionFits(header->entriesOffset, header->entryCount, sizeof(SupportEntry), fileSize)) {
+            return false;
+        }
+        if (header->cellCount > 0 &&
+            !bakeSectionFits(header->cellStartOffset, header->cellCount + 1, sizeof(int), fileSize)) {
+            return false;
+        }
+
+        return true;
+    }
+
+    // FNV-1a sobre las cajas tal como las define setupWorldCollisions()
+    unsigned int hashBoxes() const {
+        unsigned int hash = 2166136261u;
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            float values[6] = { boxes[i].x, boxes[i].y, boxes[i].z,
+                                boxes[i].width, boxes[i].height, boxes[i].depth };
+            const unsigned char* bytes = (const unsigned char*)values;
+            for (size_t b = 0; b < sizeof(values); ++b) {
+                hash = (hash ^ bytes[b]) * 16777619u;
+            }
+        }
+        return hash;
+    }
+
+    static void writeBakeSection(FILE* file, unsigned int& offset, const void* data, size_t size) {
+        static const char padding[16] = { 0 };
+        unsigned int aligned = alignBakeOffset(offset);
+        fwrite(padding, 1, aligned - offset, file);
+        if (size > 0) fwrite(data, 1, size, file);
+        offset = aligned + (unsigned int)size;
+    }
+
+    // Grilla uniforme sobre las huellas XZ de las cajas para buscar el suelo
+    // bajo el jugador tocando solo la celda en la que est parado.
+    static const int SUPPORT_GRID_MAX_CELLS = 512; // Mximo de celdas por eje
+    float supportOriginX, supportOriginZ;
+    float supportCellSize;
+    int supportCellsX, supportCellsZ;
+    std::vector<int> supportCellStart;   // Inicio de cada celda en supportEntries (CSR)
+    std::vector<SupportEntry> supportEntries;
+
+    int supportCellX(float x) const {
+        int cell = (int)floorf((x - supportOriginX) / supportCellSize);
+        if (cell < 0) return 0;
+        return cell < supportCellsX ? cell : supportCellsX - 1;
+    }
+
+    int supportCellZ(float z) const {
+        int cell = (int)floorf((z - supportOriginZ) / supportCellSize);
+        if (cell < 0) return 0;
+        return cell < supportCellsZ ? cell : supportCellsZ - 1;
+    }
+
+    void buildSupportGrid() {
+        supportCellStart.clear();
+        supportEntries.clear();
+        supportCellsX = supportCellsZ = 0;
+        if (boxes.empty()) return;
+
+        float minX = 1e30f, minZ = 1e30f, maxX = -1e30f, maxZ = -1e30f;
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            minX = fminf(minX, boxes[i].getMinX());
+            maxX = fmaxf(maxX, boxes[i].getMaxX());
+            minZ = fminf(minZ, boxes[i].getMinZ());
+            maxZ = fmaxf(maxZ, boxes[i].getMaxZ());
+        }
+
+        // Celdas de 2 unidades, agrandadas si el mundo no entra en la grilla mxima
+        float extent = fmaxf(maxX - minX, maxZ - minZ);
+        supportCellSize = fmaxf(2.0f, extent / SUPPORT_GRID_MAX_CELLS);
+        supportOriginX = minX;
+        supportOriginZ = minZ;
+        supportCellsX = (int)((maxX - minX) / supportCellSize) + 1;
+        supportCellsZ = (int)((maxZ - minZ) / supportCellSize) + 1;
+
+        // Primera pasada: contar entradas por celda
+        int cellCount = supportCellsX * supportCellsZ;
+        supportCellStart.assign(cellCount + 1, 0);
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            const CollisionBox& box = boxes[i];
+            int x0 = supportCellX(box.getMinX()), x1 = supportCellX(box.getMaxX());
+            int z0 = supportCellZ(box.getMinZ()), z1 = supportCellZ(box.getMaxZ());
+            for (int cz = z0; cz <= z1; ++cz) {
+                for (int cx = x0; cx <= x1; ++cx) {
+                    supportCellStart[cz * supportCellsX + cx + 1]++;
+                }
+            }
+        }
+        for (int c = 0; c < cellCount; ++c) {
+            supportCellStart[c + 1] += supportCellStart[c];
+        }
+
+        // Segunda pasada: rellenar cada celda con las huellas que la tocan
+        supportEntries.resize(supportCellStart[cellCount]);
+        std::vector<int> fill(supportCellStart.begin(), supportCellStart.end() - 1);
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            const CollisionBox& box = boxes[i];
+            SupportEntry entry;
+            entry.minX = box.getMinX();
+            entry.maxX = box.getMaxX();
+            entry.minZ = box.getMinZ();
+            entry.maxZ = box.getMaxZ();
+            entry.topY = box.getMaxY();
+
+            int x0 = supportCellX(entry.minX), x1 = supportCellX(entry.maxX);
+            int z0 = supportCellZ(entry.minZ), z1 = supportCellZ(entry.maxZ);
+            for (int cz = z0; cz <= z1; ++cz) {
+                for (int cx = x0; cx <= x1; ++cx) {
+                    supportEntries[fill[cz * supportCellsX + cx]++] = entry;
+                }
+            }
+        }
+    }
+
+    // Lmites de una caja durante la simplificacin
+    struct MergeBounds {
+        float min[3], max[3];
+        bool removed;
+
+        bool operator<(const MergeBounds& other) const { return min[0] < other.min[0]; }
+    };
+
+    // Dos cajas se pueden unir sin cambiar la forma del mundo (salvo la tolerancia)
+    // si una contiene a la otra, o si coinciden en dos ejes y se tocan en el tercero.
+    // Las casi duplicadas coinciden en los tres ejes y entran en el segundo caso.
+    static bool canMergeBounds(const MergeBounds& a, const MergeBounds& b, float tolerance) {
+        bool aContainsB = true;
+        bool bContainsA = true;
+        int matchingAxes = 0;
+        int freeAxis = 0;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (b.min[axis] < a.min[axis] - tolerance || b.max[axis] > a.max[axis] + tolerance) aContainsB = false;
+            if (a.min[axis] < b.min[axis] - tolerance || a.max[axis] > b.max[axis] + tolerance) bContainsA = false;
+            if (fabsf(a.min[axis] - b.min[axis]) <= tolerance &&
+                fabsf(a.max[axis] - b.max[axis]) <= tolerance) {
+                matchingAxes++;
+            } else {
+                freeAxis = axis;
+            }
+        }
+        if (aContainsB || bContainsA || matchingAxes == 3) return true;
+        if (matchingAxes < 2) return false;
+
+        // Mismo rectngulo en dos ejes: deben tocarse o solaparse en el tercero
+        return b.min[freeAxis] <= a.max[freeAxis] + tolerance &&
+               a.min[freeAxis] <= b.max[freeAxis] + tolerance;
+    }
+
+    // Comparador para repartir las cajas por el centro en un eje dado
+    struct BoxCenterLess {
+        const std::vector<CollisionBox>* boxes;
+        int axis;
+
+        BoxCenterLess(const std::vector<CollisionBox>* b, int a) : boxes(b), axis(a) {}
+
+        float center(int index) const {
+            const CollisionBox& box = (*boxes)[index];
+            if (axis == 0) return box.x;
+            if (axis == 1) return box.y;
+            return box.z;
+        }
+
+        bool operator()(int a, int b) const { return center(a) < center(b); }
+    };
+
+    // Construir recursivamente el subrbol para bvhIndices[first, first + count)
+    int buildNode(int first, int count) {
+        int nodeIndex = (int)bvhNodes.size();
+        bvhNodes.push_back(BVHNode());
+
+        BVHNode node;
+        node.minX = node.minY = node.minZ = 1e30f;
+        node.maxX = node.maxY = node.maxZ = -1e30f;
+        float cMinX = 1e30f, cMinY = 1e30f, cMinZ = 1e30f;
+        float cMaxX = -1e30f, cMaxY = -1e30f, cMaxZ = -1e30f;
+
+        for (int i = first; i < first + count; ++i) {
+            const CollisionBox& box = boxes[bvhIndices[i]];
+            node.minX = fminf(node.minX, box.getMinX());
+            node.minY = fminf(node.minY, box.getMinY());
+            node.minZ = fminf(node.minZ, box.getMinZ());
+            node.maxX = fmaxf(node.maxX, box.getMaxX());
+            node.maxY = fmaxf(node.maxY, box.getMaxY());
+            node.maxZ = fmaxf(node.maxZ, box.getMaxZ());
+
+            cMinX = fminf(cMinX, box.x); cMaxX = fmaxf(cMaxX, box.x);
+            cMinY = fminf(cMinY, box.y); cMaxY = fmaxf(cMaxY, box.y);
+            cMinZ = fminf(cMinZ, box.z); cMaxZ = fmaxf(cMaxZ, box.z);
+        }
+
+        if (count <= BVH_LEAF_SIZE) {
+            node.first = first;
+            node.count = count;
+            bvhNodes[nodeIndex] = node;
+            return nodeIndex;
+        }
+
+        // Dividir por la mediana de los centros en el eje de mayor extensin
+        int axis = 0;
+        float extentX = cMaxX - cMinX;
+        float extentY = cMaxY - cMinY;
+        float extentZ = cMaxZ - cMinZ;
+        if (extentY > extentX && extentY >= extentZ) axis = 1;
+        else if (extentZ > extentX && extentZ > extentY) axis = 2;
+
+        int mid = first + count / 2;
+        std::nth_element(bvhIndices.begin() + first, bvhIndices.begin() + mid,
+                         bvhIndices.begin() + first + count,
+                         BoxCenterLess(&boxes, axis));
+
+        node.left = buildNode(first, mid - first);
+        node.right = buildNode(mid, first + count - mid);
+        bvhNodes[nodeIndex] = node;
+        return nodeIndex;
+    }
+
+    // Reconstruir el BVH si la lista de cajas cambi desde la ltima consulta
+    void ensureBroadphase() {
+        if (broadphaseDirty) {
+            buildBroadphase();
+        }
+    }
+
+    // buildNode() guarda cada nodo antes que sus hijos y su profundidad no llega
+    // al tamao de la pila. Un archivo horneado daado puede no cumplirlo: en
+    // ese caso el recorrido no baja por el nodo en lugar de leer fuera del
+    // mapeo o de la pila (un hijo siempre mayor que el padre descarta ciclos).
+    // Como en un rbol cada nodo se visita una vez, los recorridos tampoco
+    // pasan de nodeCount visitas aunque el archivo comparta hijos entre nodos.
+    bool descendBvh(int index, const BVHNode& node, int stackSize) const {
+        return node.left > index && node.right > index &&
+               node.left < world.nodeCount && node.right < world.nodeCount &&
+               stackSize + 2 <= BVH_STACK_SIZE;
+    }
+
+    // Una hoja no puede pasarse de las cajas ni del bloque del kernel SIMD
+    bool bvhLeafInRange(const BVHNode& node) const {
+        return node.first >= 0 && node.count >= 0 && node.count <= BVH_LEAF_SIZE &&
+               node.first <= world.boxCount - node.count;
+    }
+
+    // Recorrer el BVH llamando a visitor(first, count) por cada hoja cuyo AABB
+    // toque la regin consultada. El rango indexa bvhIndices y el espejo SoA,
+    // as que las cajas de una hoja son contiguas. Si el visitor devuelve true se detiene.
+    template <typename Visitor>
+    bool queryBoxes(float qMinX, float qMinY, float qMinZ,
+                    float qMaxX, float qMaxY, float qMaxZ, Visitor& visitor) {
+        ensureBroadphase();
+        if (world.nodeCount == 0) return false;
+
+        int stack[BVH_STACK_SIZE];
+        int stackSize = 0;
+        stack[stackSize++] = 0;
+        int visited = 0;
+
+        while (stackSize > 0 && visited++ < world.nodeCount) {
+            int index = stack[--stackSize];
+            const BVHNode& node = world.nodes[index];
+            if (!node.overlaps(qMinX, qMinY, qMinZ, qMaxX, qMaxY, qMaxZ)) {
+                continue;
+            }
+
+            if (node.isLeaf()) {
+                if (bvhLeafInRange(node) && visitor(node.first, node.count)) {
+                    return true;
+                }
+            } else if (descendBvh(index, node, stackSize)) {
+                stack[stackSize++] = node.right;
+                stack[stackSize++] = node.left;
+            }
+        }
+
+        return false;
+    }
+
+    // Comparar dos cuerpos dinmicos por su minX
+    bool dynamicLess(int a, int b) const {
+        return dynamicBodies[a].getMinX() < dynamicBodies[b].getMinX();
+    }
+
+    // Reordenar la capa dinmica despus de que se movieron los cuerpos
+    void sortDynamicBodies() {
+        if (!dynamicDirty) return;
+
+        dynamicMaxWidthX = 0.0f;
+        for (size_t i = 0; i < dynamicOrder.size(); ++i) {
+            int body = dynamicOrder[i];
+            dynamicMaxWidthX = fmaxf(dynamicMaxWidthX, 2.0f * dynamicBodies[body].halfWidth);
+
+            // Insercin: el orden del frame anterior casi no cambia
+            size_t j = i;
+            while (j > 0 && dynamicLess(body, dynamicOrder[j - 1])) {
+                dynamicOrder[j] = dynamicOrder[j - 1];
+                --j;
+            }
+            dynamicOrder[j] = body;
+        }
+        dynamicDirty = false;
+    }
+
+    // Recorrer los cuerpos dinmicos cuyo AABB toca la regin consultada.
+    // Bsqueda binaria del ltimo minX <= qMaxX y barrido hacia atrs mientras
+    // minX >= qMinX - ancho mximo (ningn cuerpo anterior puede llegar a qMinX).
+    template <typename Visitor>
+    bool queryDynamic(float qMinX, float qMinY, float qMinZ,
+                      float qMaxX, float qMaxY, float qMaxZ, Visitor& visitor) {
+        if (dynamicOrder.empty()) return false;
+        sortDynamicBodies();
+
+        int low = 0;
+        int high = (int)dynamicOrder.size();
+        while (low < high) {
+            int mid = (low + high) / 2;
+            if (dynamicBodies[dynamicOrder[mid]].getMinX() <= qMaxX) low = mid + 1;
+            else high = mid;
+        }
+
+        float stopX = qMinX - dynamicMaxWidthX;
+        for (int i = low - 1; i >= 0; --i) {
+            int index = dynamicOrder[i];
+            const DynamicBody& body = dynamicBodies[index];
+            if (body.getMinX() < stopX) break;
+            if (body.getMaxX() < qMinX ||
+                body.getMaxY() < qMinY || body.getMinY() > qMaxY ||
+                body.getMaxZ() < qMinZ || body.getMinZ() > qMaxZ) {
+                continue;
+            }
+            if (visitor.visitDynamic(index, body)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Recorrer primero las cajas estticas y luego la capa dinmica
+    template <typename Visitor>
+    bool queryAll(float qMinX, float qMinY, float qMinZ,
+                  float qMaxX, float qMaxY, float qMaxZ, Visitor& visitor) {
+        return queryBoxes(qMinX, qMinY, qMinZ, qMaxX, qMaxY, qMaxZ, visitor) ||
+               queryDynamic(qMinX, qMinY, qMinZ, qMaxX, qMaxY, qMaxZ, visitor);
+    }
+
+    // Visitor que acumula la penetracin mxima por eje (usado por checkCollision)
+    struct AccumulateVisitor {
+        CollisionSystem* system;
+        CollisionSphere sphere;
+        CollisionResult result;
+        int winnerX, winnerY, winnerZ; // Caja que aporta la penetracin de cada eje
+
+        AccumulateVisitor(CollisionSystem* s, const CollisionSphere& sp)
+            : system(s), sphere(sp), winnerX(-1), winnerY(-1), winnerZ(-1) {}
+
+        // El BVH no visita las cajas en el orden en que se aadieron; ante
+        // empates gana la de menor ndice, igual que en un recorrido lineal.
+        static bool beats(float value, int index, float current, int currentIndex) {
+            float a = fabs(value), b = fabs(current);
+            return a > b || (a == b && currentIndex >= 0 && index < currentIndex);
+        }
+
+        bool operator()(int first, int count) {
+            unsigned int mask = system->sphereBoxMask(sphere, first, count);
+            for (int lane = 0; mask != 0; ++lane, mask >>= 1) {
+                if (!(mask & 1u)) continue;
+
+                accumulate(system->sphereBoxResult(sphere, first + lane),
+                           system->world.indices[first + lane]);
+            }
+            return false; // Seguir recorriendo
+        }
+
+        // Los cuerpos dinmicos van despus de todas las cajas estticas en el desempate
+        bool visitDynamic(int index, const DynamicBody& body) {
+            CollisionResult hit = dynamicBodyResult(sphere, body);
+            if (hit.hasCollision) {
+                accumulate(hit, system->world.boxCount + index);
+            }
+            return false;
+        }
+
+        void accumulate(const CollisionResult& hit, int index) {
+            result.hasCollision = true;
+
+            // Acumular penetracin (tomar la mxima en cada eje)
+            // Note: This accumulation might not be perfect for complex multi-object collisions
+            // but provides a reasonable approximation for simple scenarios.
+            if (beats(hit.penetrationX, index, result.penetrationX, winnerX)) {
+                result.penetrationX = hit.penetrationX;
+                result.normalX = hit.normalX; // Store the normal of the dominant penetration
+                winnerX = index;
+            }
+            if (beats(hit.penetrationY, index, result.penetrationY, winnerY)) {
+                result.penetrationY = hit.penetrationY;
+                result.normalY = hit.normalY;
+                winnerY = index;
+            }
+            if (beats(hit.penetrationZ, index, result.penetrationZ, winnerZ)) {
+                result.penetrationZ = hit.penetrationZ;
+                result.normalZ = hit.normalZ;
+                winnerZ = index;
+            }
+        }
+    };
+
+    // Visitor que rene en un manifold los contactos dentro del margen
+    struct ContactVisitor {
+        CollisionSystem* system;
+        CollisionSphere sphere;
+        CollisionSphere expanded;   // Esfera agrandada por el margen para el kernel SIMD
+        ContactManifold* manifold;
+
+        ContactVisitor(CollisionSystem* s, const CollisionSphere& sp, float margin, ContactManifold* m)
+            : system(s), sphere(sp), expanded(sp.x, sp.y, sp.z, sp.radius + margin), manifold(m) {}
+
+        bool operator()(int first, int count) {
+            unsigned int mask = system->sphereBoxMask(expanded, first, count);
+            for (int lane = 0; mask != 0; ++lane, mask >>= 1) {
+                if (!(mask & 1u)) continue;
+                int i = first + lane;
+                manifold->add(boundsContact(sphere,
+                                            system->world.minX[i], system->world.minY[i], system->world.minZ[i],
+                                            system->world.maxX[i], system->world.maxY[i], system->world.maxZ[i]));
+            }
+            return false;
+        }
+
+        bool visitDynamic(int, const DynamicBody& body) {
+            if (!body.isSphere) {
+                if (sphereAabbCollision(expanded, body.getMinX(), body.getMinY(), body.getMinZ(),
+                                        body.getMaxX(), body.getMaxY(), body.getMaxZ()).hasCollision) {
+                    manifold->add(boundsContact(sphere, body.getMinX(), body.getMinY(), body.getMinZ(),
+                                                body.getMaxX(), body.getMaxY(), body.getMaxZ()));
+                }
+                return false;
+            }
+
+            float offset[3] = { sphere.x - body.x, sphere.y - body.y, sphere.z - body.z };
+            float distSq = offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2];
+            float reach = expanded.radius + body.halfWidth;
+            if (distSq >= reach * reach) return false;
+
+            CollisionContact contact;
+            float dist = sqrt(distSq);
+            if (dist > 0.0f) {
+                contact.normalX = offset[0] / dist;
+                contact.normalY = offset[1] / dist;
+                contact.normalZ = offset[2] / dist;
+            }
+            contact.separation = dist - sphere.radius - body.halfWidth;
+            manifold->add(contact);
+            return false;
+        }
+    };
+
+    // Contacto de la esfera con un AABB. Si el centro qued dentro de la caja,
+    // la normal apunta a la cara ms cercana en lugar de usar siempre +Y.
+    static CollisionContact boundsContact(const CollisionSphere& sphere,
+                                          float minX, float minY, float minZ,
+                                          float maxX, float maxY, float maxZ) {
+        CollisionContact contact;
+        float dx = sphere.x - clamp(sphere.x, minX, maxX);
+        float dy = sphere.y - clamp(sphere.y, minY, maxY);
+        float dz = sphere.z - clamp(sphere.z, minZ, maxZ);
+        float distSq = dx * dx + dy * dy + dz * dz;
+
+        if (distSq > 0.0f) {
+            float dist = sqrt(distSq);
+            contact.normalX = dx / dist;
+            contact.normalY = dy / dist;
+            contact.normalZ = dz / dist;
+            contact.separation = dist - sphere.radius;
+            return contact;
+        }
+
+        // Centro dentro: salir por la cara ms cercana
+        const float exits[6] = { sphere.x - minX, maxX - sphere.x,
+                                 sphere.y - minY, maxY - sphere.y,
+                                 sphere.z - minZ, maxZ - sphere.z };
+        int best = 0;
+        for (int face = 1; face < 6; ++face) {
+            if (exits[face] < exits[best]) best = face;
+        }
+        float normal[3] = { 0.0f, 0.0f, 0.0f };
+        normal[best / 2] = (best % 2 == 0) ? -1.0f : 1.0f;
+        contact.normalX = normal[0];
+        contact.normalY = normal[1];
+        contact.normalZ = normal[2];
+        contact.separation = -(exits[best] + sphere.radius);
+        return contact;
+    }
+
+    // Visitor que se detiene en la primera caja que toca la esfera
+    struct AnyHitVisitor {
+        CollisionSystem* system;
+        CollisionSphere sphere;
+
+        AnyHitVisitor(CollisionSystem* s, const CollisionSphere& sp) : system(s), sphere(sp) {}
+
+        bool operator()(int first, int count) {
+            return system->sphereBoxMask(sphere, first, count) != 0;
+        }
+
+        bool visitDynamic(int, const DynamicBody& body) {
+            return dynamicBodyResult(sphere, body).hasCollision;
+        }
+    };
+
+    // Interseccin del segmento origen + t * dir (0 <= t <= maxT) con un AABB.
+    // Devuelve el t de entrada y el eje de la cara atravesada (-1 si el origen
+    // ya est dentro, en cuyo caso tEnter queda en 0).
+    static bool segmentAabb(const float origin[3], const float dir[3], float maxT,
+                            const float boxMin[3], const float boxMax[3],
+                            float& tEnter, int& enterAxis) {
+        float tMin = -1e30f;
+        float tMax = 1e30f;
+        enterAxis = -1;
+
+        for (int axis = 0; axis < 3; ++axis) {
+            if (fabs(dir[axis]) < 1e-8f) {
+                // Paralelo a las caras de este eje: debe estar ya entre ellas
+                if (origin[axis] < boxMin[axis] || origin[axis] > boxMax[axis]) return false;
+                continue;
+            }
+
+            float inv = 1.0f / dir[axis];
+            float t0 = (boxMin[axis] - origin[axis]) * inv;
+            float t1 = (boxMax[axis] - origin[axis]) * inv;
+            if (t0 > t1) std::swap(t0, t1);
+
+            if (t0 > tMin) { tMin = t0; enterAxis = axis; }
+            if (t1 < tMax) tMax = t1;
+            if (tMin > tMax) return false;
+        }
+
+        if (tMax < 0.0f || tMin > maxT) return false;
+
+        if (tMin < 0.0f) {
+            enterAxis = -1;
+            tEnter = 0.0f;
+        } else {
+            tEnter = tMin;
+        }
+        return true;
+    }
+
+    // Probar una caja ya expandida por el radio contra el segmento y quedarse con
+    // el contacto si es anterior a best.toi
+    static void castExpandedBox(const float origin[3], const float dir[3], float radius,
+                                const float boxMin[3], const float boxMax[3], SweepResult& best) {
+        float t;
+        int axis;
+        if (!segmentAabb(origin, dir, best.toi, boxMin, boxMax, t, axis)) {
+            return;
+        }
+
+        float normal[3] = { 0.0f, 0.0f, 0.0f };
+        if (axis >= 0) {
+            normal[axis] = dir[axis] > 0.0f ? -1.0f : 1.0f;
+        } else {
+            // Ya estaba dentro de la caja expandida: la normal va desde el punto
+            // ms cercano de la caja real y solo se bloquea si el movimiento entra
+            float offset[3];
+            float lengthSq = 0.0f;
+            for (int a = 0; a < 3; ++a) {
+                offset[a] = origin[a] - clamp(origin[a], boxMin[a] + radius, boxMax[a] - radius);
+                lengthSq += offset[a] * offset[a];
+            }
+
+            if (lengthSq > 0.0f) {
+                float invLength = 1.0f / sqrt(lengthSq);
+                for (int a = 0; a < 3; ++a) normal[a] = offset[a] * invLength;
+            } else {
+                normal[1] = 1.0f; // Centro dentro de la caja: empujar hacia arriba como checkCollision
+            }
+
+            if (dir[0] * normal[0] + dir[1] * normal[1] + dir[2] * normal[2] >= 0.0f) {
+                return;
+            }
+        }
+
+        if (!best.hit || t < best.toi) {
+            best.hit = true;
+            best.toi = t;
+            best.normalX = normal[0];
+            best.normalY = normal[1];
+            best.normalZ = normal[2];
+        }
+    }
+
+    // Segmento contra una esfera de radio combinado (esfera barrida contra esfera)
+    static void castExpandedSphere(const float origin[3], const float dir[3],
+                                   const DynamicBody& body, float combinedRadius, SweepResult& best) {
+        float offset[3] = { origin[0] - body.x, origin[1] - body.y, origin[2] - body.z };
+        float a = dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2];
+        float b = offset[0] * dir[0] + offset[1] * dir[1] + offset[2] * dir[2];
+        float c = offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2] -
+                  combinedRadius * combinedRadius;
+        if (a < 1e-12f || b >= 0.0f) return;  // Quieto o alejndose del centro
+
+        float t = 0.0f;
+        if (c > 0.0f) {
+            float discriminant = b * b - a * c;
+            if (discriminant < 0.0f) return;
+            t = (-b - sqrt(discriminant)) / a;
+            if (t > best.toi) return;
+        }
+
+        float hitPoint[3];
+        float lengthSq = 0.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            hitPoint[axis] = offset[axis] + dir[axis] * t;
+            lengthSq += hitPoint[axis] * hitPoint[axis];
+        }
+        if (lengthSq <= 0.0f) return;
+
+        if (!best.hit || t < best.toi) {
+            float invLength = 1.0f / sqrt(lengthSq);
+            best.hit = true;
+            best.toi = t;
+            best.normalX = hitPoint[0] * invLength;
+            best.normalY = hitPoint[1] * invLength;
+            best.normalZ = hitPoint[2] * invLength;
+        }
+    }
+
+    // Visitor del barrido contra la capa dinmica
+    struct CastVisitor {
+        const float* origin;
+        const float* dir;
+        float radius;
+        SweepResult* best;
+
+        bool visitDynamic(int, const DynamicBody& body) {
+            if (body.isSphere) {
+                castExpandedSphere(origin, dir, body, body.halfWidth + radius, *best);
+            } else {
+                const float boxMin[3] = { body.getMinX() - radius, body.getMinY() - radius, body.getMinZ() - radius };
+                const float boxMax[3] = { body.getMaxX() + radius, body.getMaxY() + radius, body.getMaxZ() + radius };
+                castExpandedBox(origin, dir, radius, boxMin, boxMax, *best);
+            }
+            return false;
+        }
+    };
+
+    // Barrer la esfera contra los cuerpos dinmicos que toca el AABB del recorrido
+    void castDynamic(const float origin[3], const float dir[3], float radius, SweepResult& best) {
+        if (dynamicBodies.empty()) return;
+
+        float qMin[3], qMax[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            float end = origin[axis] + dir[axis] * best.toi;
+            qMin[axis] = fminf(origin[axis], end) - radius;
+            qMax[axis] = fmaxf(origin[axis], end) + radius;
+        }
+
+        CastVisitor visitor;
+        visitor.origin = origin;
+        visitor.dir = dir;
+        visitor.radius = radius;
+        visitor.best = &best;
+        queryDynamic(qMin[0], qMin[1], qMin[2], qMax[0], qMax[1], qMax[2], visitor);
+    }
+
+    // Barrer una esfera desde origen a lo largo de dir hasta t = maxT y devolver
+    // el primer contacto. Cada caja se expande por el radio (suma de Minkowski),
+    // as que en las aristas y esquinas el contacto es algo conservador.
+    SweepResult castSphere(float ox, float oy, float oz, float dx, float dy, float dz,
+                           float radius, float maxT) {
+        SweepResult best;
+        best.toi = maxT;
+
+        const float origin[3] = { ox, oy, oz };
+        const float dir[3] = { dx, dy, dz };
+
+        ensureBroadphase();
+        if (world.nodeCount == 0) {
+            castDynamic(origin, dir, radius, best);
+            return best;
+        }
+
+        int stack[BVH_STACK_SIZE];
+        int stackSize = 0;
+        stack[stackSize++] = 0;
+        int visited = 0;
+
+        while (stackSize > 0 && visited++ < world.nodeCount) {
+            int index = stack[--stackSize];
+            const BVHNode& node = world.nodes[index];
+            const float nodeMin[3] = { node.minX - radius, node.minY - radius, node.minZ - radius };
+            const float nodeMax[3] = { node.maxX + radius, node.maxY + radius, node.maxZ + radius };
+
+            float tNode;
+            int axis;
+            if (!segmentAabb(origin, dir, best.toi, nodeMin, nodeMax, tNode, axis)) {
+                continue;
+            }
+
+            if (!node.isLeaf()) {
+                if (!descendBvh(index, node, stackSize)) continue;
+
+                // Visitar primero el hijo ms cercano al origen para acotar antes best.toi
+                const BVHNode& left = world.nodes[node.left];
+                const BVHNode& right = world.nodes[node.right];
+                float towardsRight = (right.minX + right.maxX - left.minX - left.maxX) * dx +
+                                     (right.minY + right.maxY - left.minY - left.maxY) * dy +
+                                     (right.minZ + right.maxZ - left.minZ - left.maxZ) * dz;
+                if (towardsRight > 0.0f) {
+                    stack[stackSize++] = node.right;
+                    stack[stackSize++] = node.left;
+                } else {
+                    stack[stackSize++] = node.left;
+                    stack[stackSize++] = node.right;
+                }
+                continue;
+            }
+
+            if (!bvhLeafInRange(node)) continue;
+            for (int i = node.first; i < node.first + node.count; ++i) {
+                const float boxMin[3] = { world.minX[i] - radius, world.minY[i] - radius, world.minZ[i] - radius };
+                const float boxMax[3] = { world.maxX[i] + radius, world.maxY[i] + radius, world.maxZ[i] + radius };
+                castExpandedBox(origin, dir, radius, boxMin, boxMax, best);
+            }
+        }
+
+        castDynamic(origin, dir, radius, best);
+        return best;
+    }
+
     // Funciones de utilidad para clculos
-    float clamp(float value, float min, float max) {
+    static float clamp(float value, float min, float max) {
         if (value < min) return min;
         if (value > max) return max;
         return value;
     }
-    
-    float distance(float x1, float y1, float z1, float x2, float y2, float z2) {
-        float dx = x2 - x1;
-        float dy = y2 - y1;
-        float dz = z2 - z1;
-        return sqrt(dx * dx + dy * dy + dz * dz);
+
+    // Copiar los lmites de las cajas al espejo SoA en el orden de las hojas del BVH,
+    // con relleno al final para que el kernel pueda leer un bloque completo.
+    void buildBoxSoA() {
+        size_t count = bvhIndices.size();
+        soa.resize(count + COLLISION_SIMD_WIDTH);
+
+        for (size_t i = 0; i < count; ++i) {
+            const CollisionBox& box = boxes[bvhIndices[i]];
+            soa.minX[i] = box.getMinX(); soa.maxX[i] = box.getMaxX();
+            soa.minY[i] = box.getMinY(); soa.maxY[i] = box.getMaxY();
+            soa.minZ[i] = box.getMinZ(); soa.maxZ[i] = box.getMaxZ();
+        }
+
+        // Cajas de relleno lejsimos: su distancia al cuadrado es infinita y nunca colisionan
+        for (size_t i = count; i < soa.size(); ++i) {
+            soa.minX[i] = soa.maxX[i] = 1e30f;
+            soa.minY[i] = soa.maxY[i] = 1e30f;
+            soa.minZ[i] = soa.maxZ[i] = 1e30f;
+        }
     }
-    
-    // Detectar colisin entre esfera y cubo usando el mtodo del punto ms cercano
-    CollisionResult checkSphereBoxCollision(const CollisionSphere& sphere, const CollisionBox& box) {
+
+    // Kernel del narrowphase: probar la esfera contra las cajas SoA [first, first + count)
+    // comparando distancias al cuadrado. Devuelve una mscara con un bit por caja tocada.
+    unsigned int sphereBoxMask(const CollisionSphere& sphere, int first, int count) const {
+        unsigned int mask = 0;
+        float radiusSq = sphere.radius * sphere.radius;
+
+#if COLLISION_SIMD_WIDTH == 8
+        __m256 sx = _mm256_set1_ps(sphere.x);
+        __m256 sy = _mm256_set1_ps(sphere.y);
+        __m256 sz = _mm256_set1_ps(sphere.z);
+        __m256 r2 = _mm256_set1_ps(radiusSq);
+
+        for (int base = 0; base < count; base += 8) {
+            int i = first + base;
+            __m256 dx = _mm256_sub_ps(sx, _mm256_min_ps(_mm256_max_ps(sx, _mm256_loadu_ps(&world.minX[i])), _mm256_loadu_ps(&world.maxX[i])));
+            __m256 dy = _mm256_sub_ps(sy, _mm256_min_ps(_mm256_max_ps(sy, _mm256_loadu_ps(&world.minY[i])), _mm256_loadu_ps(&world.maxY[i])));
+            __m256 dz = _mm256_sub_ps(sz, _mm256_min_ps(_mm256_max_ps(sz, _mm256_loadu_ps(&world.minZ[i])), _mm256_loadu_ps(&world.maxZ[i])));
+            __m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+            mask |= (unsigned int)_mm256_movemask_ps(_mm256_cmp_ps(d2, r2, _CMP_LT_OQ)) << base;
+        }
+#elif COLLISION_SIMD_WIDTH == 4
+        __m128 sx = _mm_set1_ps(sphere.x);
+        __m128 sy = _mm_set1_ps(sphere.y);
+        __m128 sz = _mm_set1_ps(sphere.z);
+        __m128 r2 = _mm_set1_ps(radiusSq);
+
+        for (int base = 0; base < count; base += 4) {
+            int i = first + base;
+            __m128 dx = _mm_sub_ps(sx, _mm_min_ps(_mm_max_ps(sx, _mm_loadu_ps(&world.minX[i])), _mm_loadu_ps(&world.maxX[i])));
+            __m128 dy = _mm_sub_ps(sy, _mm_min_ps(_mm_max_ps(sy, _mm_loadu_ps(&world.minY[i])), _mm_loadu_ps(&world.maxY[i])));
+            __m128 dz = _mm_sub_ps(sz, _mm_min_ps(_mm_max_ps(sz, _mm_loadu_ps(&world.minZ[i])), _mm_loadu_ps(&world.maxZ[i])));
+            __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            mask |= (unsigned int)_mm_movemask_ps(_mm_cmplt_ps(d2, r2)) << base;
+        }
+#else
+        for (int lane = 0; lane < count; ++lane) {
+            int i = first + lane;
+            float dx = sphere.x - clamp(sphere.x, world.minX[i], world.maxX[i]);
+            float dy = sphere.y - clamp(sphere.y, world.minY[i], world.maxY[i]);
+            float dz = sphere.z - clamp(sphere.z, world.minZ[i], world.maxZ[i]);
+            if (dx * dx + dy * dy + dz * dz < radiusSq) {
+                mask |= 1u << lane;
+            }
+        }
+#endif
+
+        // Descartar los carriles que pertenecen a la hoja siguiente o al relleno
+        if (count < 32) {
+            mask &= (1u << count) - 1u;
+        }
+        return mask;
+    }
+
+    // Resultado completo para una caja del espejo SoA que el kernel marc como tocada
+    CollisionResult sphereBoxResult(const CollisionSphere& sphere, int i) const {
+        return sphereAabbCollision(sphere, world.minX[i], world.minY[i], world.minZ[i],
+                                   world.maxX[i], world.maxY[i], world.maxZ[i]);
+    }
+
+    // Colisin de la esfera con un cuerpo dinmico (caja o esfera)
+    static CollisionResult dynamicBodyResult(const CollisionSphere& sphere, const DynamicBody& body) {
+        if (!body.isSphere) {
+            return sphereAabbCollision(sphere, body.getMinX(), body.getMinY(), body.getMinZ(),
+                                       body.getMaxX(), body.getMaxY(), body.getMaxZ());
+        }
+
+        CollisionResult result;
+        float dx = sphere.x - body.x;
+        float dy = sphere.y - body.y;
+        float dz = sphere.z - body.z;
+        float distSq = dx * dx + dy * dy + dz * dz;
+        float combined = sphere.radius + body.halfWidth;
+        if (distSq >= combined * combined) return result;
+
+        result.hasCollision = true;
+        float dist = sqrt(distSq);
+        if (dist == 0.0f) {
+            result.normalY = 1.0f;
+            result.penetrationY = combined;
+        } else {
+            float invDist = 1.0f / dist;
+            float depth = combined - dist;
+            result.normalX = dx * invDist;
+            result.normalY = dy * invDist;
+            result.normalZ = dz * invDist;
+            result.penetrationX = result.normalX * depth;
+            result.penetrationY = result.normalY * depth;
+            result.penetrationZ = result.normalZ * depth;
+        }
+        return result;
+    }
+
+    // Detectar colisin entre esfera y AABB usando el mtodo del punto ms cercano.
+    // Compara distancias al cuadrado y solo calcula la raz cuando hay contacto.
+    static CollisionResult sphereAabbCollision(const CollisionSphere& sphere,
+                                               float minX, float minY, float minZ,
+                                               float maxX, float maxY, float maxZ) {
         CollisionResult result;
         
         // Encontrar el punto ms cercano del cubo a la esfera
-        float closestX = clamp(sphere.x, box.getMinX(), box.getMaxX());
-        float closestY = clamp(sphere.y, box.getMinY(), box.getMaxY());
-        float closestZ = clamp(sphere.z, box.getMinZ(), box.getMaxZ());
+        float closestX = clamp(sphere.x, minX, maxX);
+        float closestY = clamp(sphere.y, minY, maxY);
+        float closestZ = clamp(sphere.z, minZ, maxZ);
         
-        // Calcular distancia desde el centro de la esfera al punto ms cercano
-        float dist = distance(sphere.x, sphere.y, sphere.z, closestX, closestY, closestZ);
+        // Calcular vector desde el punto ms cercano al centro de la esfera
+        float dx = sphere.x - closestX;
+        float dy = sphere.y - closestY;
+        float dz = sphere.z - closestZ;
+        float distSq = dx * dx + dy * dy + dz * dz;
         
-        if (dist < sphere.radius) {
+        if (distSq < sphere.radius * sphere.radius) {
             result.hasCollision = true;
-            
-            // Calcular vector de penetracin
-            float dx = sphere.x - closestX;
-            float dy = sphere.y - closestY;
-            float dz = sphere.z - closestZ;
+            float dist = sqrt(distSq);
             
             // Si la esfera est exactamente en el centro del cubo, usar Y como normal por defecto
             if (dist == 0.0f) {
@@ -107,17 +1234,31 @@ private:
         
         return result;
     }
+
+    // Ruta escalar equivalente para una caja suelta
+    static CollisionResult checkSphereBoxCollision(const CollisionSphere& sphere, const CollisionBox& box) {
+        return sphereAabbCollision(sphere, box.getMinX(), box.getMinY(), box.getMinZ(),
+                                   box.getMaxX(), box.getMaxY(), box.getMaxZ());
+    }
     
 public:
-    CollisionSystem() : groundLevel(-0.1f) {}
+    CollisionSystem() : groundLevel(-0.1f), broadphaseDirty(true),
+                        dynamicMaxWidthX(0.0f), dynamicDirty(false), batchPool(NULL),
+                        bakeFile(NULL), bakeMapping(NULL), bakeView(NULL),
+                        supportOriginX(0.0f), supportOriginZ(0.0f), supportCellSize(2.0f),
+                        supportCellsX(0), supportCellsZ(0) {}
     
     ~CollisionSystem() {
+        delete batchPool;
+        unmapBaked();
         boxes.clear();
     }
     
     // Aadir un cubo colisionable
     void addBox(float x, float y, float z, float width, float height, float depth) {
+        detachBaked();
         boxes.push_back(CollisionBox(x, y, z, width, height, depth));
+        broadphaseDirty = true;
     }
     
     // Aadir un cubo colisionable con tamao uniforme (adjusts Y for base position)
@@ -125,12 +1266,187 @@ public:
         // The y parameter here is assumed to be the base of the cube,
         // so we adjust it to be the center for CollisionBox.
         float adjustedY = y + size * 0.5f;
+        detachBaked();
         boxes.push_back(CollisionBox(x, adjustedY, z, size, size, size));
+        broadphaseDirty = true;
     }
     
     // Limpiar todas las cajas de colisin
     void clearBoxes() {
+        unmapBaked();
+        boxes.clear();
+        bvhNodes.clear();
+        bvhIndices.clear();
+        soa.clear();
+        supportCellStart.clear();
+        supportEntries.clear();
+        broadphaseDirty = true;
+    }
+
+    // Construir el BVH sobre las cajas actuales. setupWorldCollisions() lo
+    // llama al final; si luego se aaden cajas se reconstruye en la siguiente consulta.
+    void buildBroadphase() {
+        bvhNodes.clear();
+        bvhIndices.resize(boxes.size());
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            bvhIndices[i] = (int)i;
+        }
+
+        if (!boxes.empty()) {
+            bvhNodes.reserve(2 * boxes.size() / BVH_LEAF_SIZE + 1);
+            buildNode(0, (int)boxes.size());
+        }
+
+        buildBoxSoA();
+        buildSupportGrid();
+        bindOwnedStorage();
+        broadphaseDirty = false;
+    }
+
+    // Indica si ya hay un mundo listo para consultar (construido o cargado)
+    bool isReady() const {
+        return !broadphaseDirty && world.boxCount > 0;
+    }
+
+    // Guardar las cajas y todo el broadphase en un archivo binario versionado
+    // que loadBaked() puede mapear y usar sin reconstruir nada. 'sourceHash'
+    // identifica la lista de cajas de la que sali (ver setupWorldCollisions())
+    bool saveBaked(const char* filename, unsigned int sourceHash) {
+        ensureBroadphase();
+
+        FILE* file = fopen(filename, "wb");
+        if (!file) {
+            printf("Error: No se pudo crear el archivo de colisiones %s\n", filename);
+            return false;
+        }
+
+        CollisionBakeHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, "CHCB", 4);
+        header.version = COLLISION_BAKE_VERSION;
+        header.leafSize = BVH_LEAF_SIZE;
+        header.structSizes = sizeof(CollisionBox) | (sizeof(BVHNode) << 8) | (sizeof(SupportEntry) << 16);
+        header.boxCount = world.boxCount;
+        header.nodeCount = world.nodeCount;
+        header.soaCount = (int)soa.size();
+        header.cellCount = supportCellsX * supportCellsZ;
+        header.entryCount = (int)supportEntries.size();
+        header.cellsX = supportCellsX;
+        header.cellsZ = supportCellsZ;
+        header.originX = supportOriginX;
+        header.originZ = supportOriginZ;
+        header.cellSize = supportCellSize;
+        header.sourceHash = sourceHash;
+
+        // Calcular los desplazamientos de cada seccin (alineados a 16 bytes)
+        unsigned int offset = sizeof(header);
+        header.boxesOffset = alignBakeOffset(offset);     offset = header.boxesOffset + header.boxCount * sizeof(CollisionBox);
+        header.nodesOffset = alignBakeOffset(offset);     offset = header.nodesOffset + header.nodeCount * sizeof(BVHNode);
+        header.indicesOffset = alignBakeOffset(offset);   offset = header.indicesOffset + header.boxCount * sizeof(int);
+        header.soaOffset = alignBakeOffset(offset);       offset = header.soaOffset + 6 * alignBakeOffset(header.soaCount * sizeof(float));
+        header.cellStartOffset = alignBakeOffset(offset); offset = header.cellStartOffset + (header.cellCount + 1) * sizeof(int);
+        header.entriesOffset = alignBakeOffset(offset);   offset = header.entriesOffset + header.entryCount * sizeof(SupportEntry);
+        header.fileSize = offset;
+
+        unsigned int written = 0;
+        size_t soaBytes = header.soaCount * sizeof(float);
+        writeBakeSection(file, written, &header, sizeof(header));
+        writeBakeSection(file, written, world.boxes, header.boxCount * sizeof(CollisionBox));
+        writeBakeSection(file, written, world.nodes, header.nodeCount * sizeof(BVHNode));
+        writeBakeSection(file, written, world.indices, header.boxCount * sizeof(int));
+        writeBakeSection(file, written, world.minX, soaBytes);
+        writeBakeSection(file, written, world.minY, soaBytes);
+        writeBakeSection(file, written, world.minZ, soaBytes);
+        writeBakeSection(file, written, world.maxX, soaBytes);
+        writeBakeSection(file, written, world.maxY, soaBytes);
+        writeBakeSection(file, written, world.maxZ, soaBytes);
+        writeBakeSection(file, written, world.cellStart, header.cellCount > 0 ? (header.cellCount + 1) * sizeof(int) : 0);
+        writeBakeSection(file, written, world.cellEntries, header.entryCount * sizeof(SupportEntry));
+
+        bool ok = (written == header.fileSize) && !ferror(file);
+        fclose(file);
+        if (!ok) {
+            printf("Error: No se pudo escribir el archivo de colisiones %s\n", filename);
+        }
+        return ok;
+    }
+
+    // Mapear un archivo horneado y usar sus datos en el lugar. Devuelve false si
+    // no existe, es de otra versin, sali de otras cajas o est daado; en ese
+    // caso hay que reconstruir el mundo.
+    bool loadBaked(const char* filename, unsigned int sourceHash) {
+        unmapBaked();
+
+        bakeFile = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (bakeFile == INVALID_HANDLE_VALUE) {
+            bakeFile = NULL;
+            return false;
+        }
+
+        DWORD fileSize = GetFileSize(bakeFile, NULL);
+        if (fileSize >= sizeof(CollisionBakeHeader)) {
+            bakeMapping = CreateFileMappingA(bakeFile, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (bakeMapping) {
+                bakeView = (const unsigned char*)MapViewOfFile(bakeMapping, FILE_MAP_READ, 0, 0, 0);
+            }
+        }
+        if (!bakeView) {
+            unmapBaked();
+            return false;
+        }
+
+        const CollisionBakeHeader* header = (const CollisionBakeHeader*)bakeView;
+        unsigned int structSizes = sizeof(CollisionBox) | (sizeof(BVHNode) << 8) | (sizeof(SupportEntry) << 16);
+        if (memcmp(header->magic, "CHCB", 4) != 0 ||
+            header->version != COLLISION_BAKE_VERSION ||
+            header->leafSize != (unsigned int)BVH_LEAF_SIZE ||
+            header->structSizes != structSizes ||
+            header->fileSize != fileSize ||
+            header->sourceHash != sourceHash ||
+            header->boxCount <= 0) {
+            printf("Archivo de colisiones %s desactualizado, se reconstruye\n", filename);
+            unmapBaked();
+            return false;
+        }
+        if (!validateBaked(bakeView, fileSize)) {
+            printf("Archivo de colisiones %s danado, se reconstruye\n", filename);
+            unmapBaked();
+            return false;
+        }
+
+        size_t soaStride = alignBakeOffset(header->soaCount * sizeof(float));
+        const float* soaBase = (const float*)(bakeView + header->soaOffset);
+        world.boxes = (const CollisionBox*)(bakeView + header->boxesOffset);
+        world.boxCount = header->boxCount;
+        world.nodes = (const BVHNode*)(bakeView + header->nodesOffset);
+        world.nodeCount = header->nodeCount;
+        world.indices = (const int*)(bakeView + header->indicesOffset);
+        world.minX = (const float*)((const unsigned char*)soaBase + 0 * soaStride);
+        world.minY = (const float*)((const unsigned char*)soaBase + 1 * soaStride);
+        world.minZ = (const float*)((const unsigned char*)soaBase + 2 * soaStride);
+        world.maxX = (const float*)((const unsigned char*)soaBase + 3 * soaStride);
+        world.maxY = (const float*)((const unsigned char*)soaBase + 4 * soaStride);
+        world.maxZ = (const float*)((const unsigned char*)soaBase + 5 * soaStride);
+        world.cellStart = header->cellCount > 0 ? (const int*)(bakeView + header->cellStartOffset) : NULL;
+        world.cellEntries = header->entryCount > 0 ? (const SupportEntry*)(bakeView + header->entriesOffset) : NULL;
+        world.cellEntryCount = header->entryCount;
+
+        supportCellsX = header->cellsX;
+        supportCellsZ = header->cellsZ;
+        supportOriginX = header->originX;
+        supportOriginZ = header->originZ;
+        supportCellSize = header->cellSize;
+
+        // Los vectores propios no se usan mientras el archivo est mapeado
         boxes.clear();
+        bvhNodes.clear();
+        bvhIndices.clear();
+        soa.clear();
+        supportCellStart.clear();
+        supportEntries.clear();
+        broadphaseDirty = false;
+        return true;
     }
     
     // Establecer nivel del suelo
@@ -145,72 +1461,192 @@ public:
     
     // Verificar colisin principal y resolver penetracin
     CollisionResult checkCollision(float x, float y, float z, float radius) {
-        CollisionSphere sphere(x, y, z, radius);
-        CollisionResult finalResult;
-        
-        // Variables para acumular penetracin
-        float totalPenetrationX = 0.0f;
-        float totalPenetrationY = 0.0f;
-        float totalPenetrationZ = 0.0f;
-        
-        // Verificar colisin con cada caja
-        for (size_t i = 0; i < boxes.size(); ++i) {
-            CollisionResult result = checkSphereBoxCollision(sphere, boxes[i]);
-            
-            if (result.hasCollision) {
-                finalResult.hasCollision = true;
-                
-                // Acumular penetracin (tomar la mxima en cada eje)
-                // Note: This accumulation might not be perfect for complex multi-object collisions
-                // but provides a reasonable approximation for simple scenarios.
-                if (fabs(result.penetrationX) > fabs(totalPenetrationX)) {
-                    totalPenetrationX = result.penetrationX;
-                    finalResult.normalX = result.normalX; // Store the normal of the dominant penetration
-                }
-                if (fabs(result.penetrationY) > fabs(totalPenetrationY)) {
-                    totalPenetrationY = result.penetrationY;
-                    finalResult.normalY = result.normalY;
-                }
-                if (fabs(result.penetrationZ) > fabs(totalPenetrationZ)) {
-                    totalPenetrationZ = result.penetrationZ;
-                    finalResult.normalZ = result.normalZ;
-                }
-            }
-        }
-        
-        finalResult.penetrationX = totalPenetrationX;
-        finalResult.penetrationY = totalPenetrationY;
-        finalResult.penetrationZ = totalPenetrationZ;
-        
-        return finalResult;
+        AccumulateVisitor visitor(this, CollisionSphere(x, y, z, radius));
+        queryAll(x - radius, y - radius, z - radius,
+                   x + radius, y + radius, z + radius, visitor);
+        return visitor.result;
     }
     
+    // Consultar muchas esferas a la vez (NPCs, objetos fsicos). Escribe un
+    // CollisionResult por esfera, igual que checkCollision(). Los bloques se reparten
+    // entre los hilos del pool y todos leen el mismo broadphase sin bloqueos: por
+    // eso se termina de construir (BVH y orden de la capa dinmica) antes de empezar,
+    // y no se deben aadir ni mover cuerpos mientras corre el lote.
+    void checkCollisionBatch(const CollisionSphere* spheres, CollisionResult* results, int count) {
+        if (count <= 0) return;
+
+        ensureBroadphase();
+        sortDynamicBodies();
+
+        CollisionBatchTask task;
+        task.system = this;
+        task.spheres = spheres;
+        task.results = results;
+
+        if (count <= BATCH_GRAIN) {
+            task.run(0, count);
+            return;
+        }
+
+        if (!batchPool) {
+            batchPool = new ThreadPool();
+        }
+        batchPool->parallelFor(count, BATCH_GRAIN, task);
+    }
+
     // Verificar si una posicin est libre de colisiones
     bool isPositionFree(float x, float y, float z, float radius) {
-        CollisionSphere sphere(x, y, z, radius);
-        
-        for (size_t i = 0; i < boxes.size(); ++i) {
-            CollisionResult result = checkSphereBoxCollision(sphere, boxes[i]);
-            if (result.hasCollision) {
-                return false;
+        AnyHitVisitor visitor(this, CollisionSphere(x, y, z, radius));
+        return !queryAll(x - radius, y - radius, z - radius,
+                         x + radius, y + radius, z + radius, visitor);
+    }
+    
+    // Tiempo de impacto de una esfera que se desplaza (dx, dy, dz) desde (x, y, z).
+    // toi es la fraccin del desplazamiento (0..1) recorrida antes del contacto.
+    SweepResult sweepSphere(float x, float y, float z, float radius, float dx, float dy, float dz) {
+        return castSphere(x, y, z, dx, dy, dz, radius, 1.0f);
+    }
+
+    // Primer contacto de un rayo (lnea de visin, seleccin con el mouse).
+    // La direccin no necesita estar normalizada; la distancia se mide en unidades del mundo.
+    RaycastHit raycast(float ox, float oy, float oz, float dirX, float dirY, float dirZ,
+                       float maxDistance) {
+        return sphereCast(ox, oy, oz, 0.0f, dirX, dirY, dirZ, maxDistance);
+    }
+
+    // Primer contacto de una esfera lanzada desde el origen en la direccin dada
+    RaycastHit sphereCast(float ox, float oy, float oz, float radius,
+                          float dirX, float dirY, float dirZ, float maxDistance) {
+        RaycastHit result;
+        float length = sqrt(dirX * dirX + dirY * dirY + dirZ * dirZ);
+        if (length < 1e-6f || maxDistance <= 0.0f) return result;
+
+        float inv = 1.0f / length;
+        SweepResult sweep = castSphere(ox, oy, oz, dirX * inv, dirY * inv, dirZ * inv,
+                                       radius, maxDistance);
+        result.hit = sweep.hit;
+        result.distance = sweep.hit ? sweep.toi : maxDistance;
+        result.normalX = sweep.normalX;
+        result.normalY = sweep.normalY;
+        result.normalZ = sweep.normalZ;
+        return result;
+    }
+
+    // Mover la esfera deslizando sobre las superficies que encuentra en el camino.
+    // Como el movimiento se barre, los pasos grandes no atraviesan cajas delgadas.
+    // Devuelve el primer contacto encontrado (hit == false si el camino estaba libre).
+    SweepResult slideMove(float& x, float& y, float& z, float radius, float dx, float dy, float dz) {
+        const int maxSlides = 3;
+        const float SKIN = 0.01f; // Separacin que se deja frente a la superficie
+
+        SweepResult firstHit;
+        for (int slide = 0; slide < maxSlides; ++slide) {
+            float length = sqrt(dx * dx + dy * dy + dz * dz);
+            if (length < 1e-6f) break;
+
+            SweepResult sweep = sweepSphere(x, y, z, radius, dx, dy, dz);
+            if (!sweep.hit) {
+                x += dx; y += dy; z += dz;
+                break;
+            }
+            if (!firstHit.hit) {
+                firstHit = sweep;
+            }
+
+            // Avanzar hasta el contacto sin llegar a tocar la superficie
+            float moveT = fmaxf(0.0f, sweep.toi - SKIN / length);
+            x += dx * moveT;
+            y += dy * moveT;
+            z += dz * moveT;
+
+            // Quitar al resto del desplazamiento la componente que entra en la superficie
+            float remaining = 1.0f - moveT;
+            dx *= remaining; dy *= remaining; dz *= remaining;
+            float into = dx * sweep.normalX + dy * sweep.normalY + dz * sweep.normalZ;
+            if (into < 0.0f) {
+                dx -= sweep.normalX * into;
+                dy -= sweep.normalY * into;
+                dz -= sweep.normalZ * into;
             }
         }
-        
-        return true;
+
+        return firstHit;
     }
     
-    // Resolver colisin ajustando posicin
-    void resolveCollision(float& x, float& y, float& z, float radius) {
-        const int maxIterations = 5; // Evitar bucles infinitos para resolver mltiples colisiones
-        
+    // Reunir en una sola pasada del broadphase todos los contactos de la esfera,
+    // incluidos los que estn a menos de 'margin' de tocarla
+    void collectContacts(float x, float y, float z, float radius, float margin,
+                         ContactManifold& manifold) {
+        manifold.count = 0;
+        ContactVisitor visitor(this, CollisionSphere(x, y, z, radius), margin, &manifold);
+        float reach = radius + margin;
+        queryAll(x - reach, y - reach, z - reach, x + reach, y + reach, z + reach, visitor);
+    }
+
+    // Resolver el manifold con Gauss-Seidel proyectado: cada contacto es un plano
+    // que la esfera no puede cruzar y el impulso acumulado de cada uno nunca es
+    // negativo. Devuelve la correccin total como penetracin y como normal la del
+    // contacto que ms empuj. No vuelve a consultar el mundo.
+    static CollisionResult solveContacts(const ContactManifold& manifold) {
+        const int maxIterations = 8;
+        const float TOLERANCE = 1e-5f;
+
+        CollisionResult result;
+        float impulses[ContactManifold::MAX_CONTACTS] = { 0.0f };
+        float correction[3] = { 0.0f, 0.0f, 0.0f };
+
         for (int iter = 0; iter < maxIterations; ++iter) {
-            CollisionResult result = checkCollision(x, y, z, radius);
-            
-            if (!result.hasCollision) {
-                break; // No hay ms colisiones
+            float largestChange = 0.0f;
+            for (int i = 0; i < manifold.count; ++i) {
+                const CollisionContact& contact = manifold.contacts[i];
+                float separation = contact.separation +
+                                   contact.normalX * correction[0] +
+                                   contact.normalY * correction[1] +
+                                   contact.normalZ * correction[2];
+                float impulse = fmaxf(impulses[i] - separation, 0.0f);
+                float change = impulse - impulses[i];
+                if (change == 0.0f) continue;
+
+                impulses[i] = impulse;
+                correction[0] += contact.normalX * change;
+                correction[1] += contact.normalY * change;
+                correction[2] += contact.normalZ * change;
+                largestChange = fmaxf(largestChange, fabsf(change));
             }
-            
-            // Ajustar posicin segn penetracin
+            if (largestChange < TOLERANCE) break;
+        }
+
+        int dominant = -1;
+        for (int i = 0; i < manifold.count; ++i) {
+            if (impulses[i] > 0.0f && (dominant < 0 || impulses[i] > impulses[dominant])) {
+                dominant = i;
+            }
+        }
+        if (dominant < 0) return result;
+
+        result.hasCollision = true;
+        result.penetrationX = correction[0];
+        result.penetrationY = correction[1];
+        result.penetrationZ = correction[2];
+        result.normalX = manifold.contacts[dominant].normalX;
+        result.normalY = manifold.contacts[dominant].normalY;
+        result.normalZ = manifold.contacts[dominant].normalZ;
+        return result;
+    }
+
+    // Correccin que saca a la esfera de todas las superficies a la vez
+    // (una consulta y un solve sobre el manifold, sin volver a recorrer el mundo)
+    CollisionResult resolveContacts(float x, float y, float z, float radius,
+                                    float margin = 0.05f) {
+        ContactManifold manifold;
+        collectContacts(x, y, z, radius, margin, manifold);
+        return solveContacts(manifold);
+    }
+
+    // Resolver colisin ajustando posicin
+    void resolveCollision(float& x, float& y, float& z, float radius) {
+        CollisionResult result = resolveContacts(x, y, z, radius);
+        if (result.hasCollision) {
             x += result.penetrationX;
             y += result.penetrationY;
             z += result.penetrationZ;
@@ -219,26 +1655,174 @@ public:
     
     // Verificar colisin en una direccin especfica (til para movimiento)
     bool wouldCollideAt(float x, float y, float z, float radius) {
-        CollisionSphere sphere(x, y, z, radius);
-        
-        for (size_t i = 0; i < boxes.size(); ++i) {
-            CollisionResult result = checkSphereBoxCollision(sphere, boxes[i]);
-            if (result.hasCollision) {
-                return true;
+        AnyHitVisitor visitor(this, CollisionSphere(x, y, z, radius));
+        return queryAll(x - radius, y - radius, z - radius,
+                        x + radius, y + radius, z + radius, visitor);
+    }
+    
+    // Altura de la superficie ms alta bajo (x, z) cuyo tope est entre yMin e yMax.
+    // Solo recorre la celda de la grilla que contiene el punto.
+    // Devuelve noSupport() si no hay ninguna caja que sirva de soporte.
+    static float noSupport() { return -1000.0f; }
+
+    float queryHighestSupport(float x, float z, float yMin, float yMax) {
+        ensureBroadphase();
+        float highest = noSupport();
+        if (supportCellsX == 0 || supportCellsZ == 0) return highest;
+
+        // Fuera de la grilla no hay ninguna caja debajo
+        if (x < supportOriginX || z < supportOriginZ ||
+            x > supportOriginX + supportCellsX * supportCellSize ||
+            z > supportOriginZ + supportCellsZ * supportCellSize) {
+            return highest;
+        }
+
+        // Los lmites de la celda vienen del archivo horneado si se carg de ah
+        int cell = supportCellZ(z) * supportCellsX + supportCellX(x);
+        int begin = world.cellStart[cell];
+        int end = world.cellStart[cell + 1];
+        if (begin < 0 || end > world.cellEntryCount) return highest;
+        for (int i = begin; i < end; ++i) {
+            const SupportEntry& entry = world.cellEntries[i];
+            if (x >= entry.minX && x <= entry.maxX &&
+                z >= entry.minZ && z <= entry.maxZ &&
+                entry.topY >= yMin && entry.topY <= yMax &&
+                entry.topY > highest) {
+                highest = entry.topY;
             }
         }
-        
-        return false;
+
+        return highest;
     }
     
+    // Aadir una caja dinmica centrada en (x, y, z). Devuelve su identificador
+    // para moverla despus con setDynamicPosition(); no toca el BVH esttico.
+    int addDynamicBox(float x, float y, float z, float width, float height, float depth) {
+        DynamicBody body;
+        body.x = x; body.y = y; body.z = z;
+        body.halfWidth = width * 0.5f;
+        body.halfHeight = height * 0.5f;
+        body.halfDepth = depth * 0.5f;
+        body.isSphere = false;
+        return addDynamicBody(body);
+    }
+
+    // Aadir una esfera dinmica
+    int addDynamicSphere(float x, float y, float z, float radius) {
+        DynamicBody body;
+        body.x = x; body.y = y; body.z = z;
+        body.halfWidth = body.halfHeight = body.halfDepth = radius;
+        body.isSphere = true;
+        return addDynamicBody(body);
+    }
+
+    int addDynamicBody(const DynamicBody& body) {
+        dynamicBodies.push_back(body);
+        dynamicOrder.push_back((int)dynamicBodies.size() - 1);
+        dynamicDirty = true;
+        return (int)dynamicBodies.size() - 1;
+    }
+
+    // Mover un cuerpo dinmico; el reordenamiento se hace en la siguiente consulta
+    void setDynamicPosition(int id, float x, float y, float z) {
+        if (id < 0 || id >= (int)dynamicBodies.size()) return;
+        DynamicBody& body = dynamicBodies[id];
+        body.x = x;
+        body.y = y;
+        body.z = z;
+        dynamicDirty = true;
+    }
+
+    // Cambiar el tamao de una caja dinmica (por ejemplo, al girar un auto 90 grados)
+    void setDynamicExtents(int id, float width, float height, float depth) {
+        if (id < 0 || id >= (int)dynamicBodies.size()) return;
+        DynamicBody& body = dynamicBodies[id];
+        if (body.isSphere) return;
+        body.halfWidth = width * 0.5f;
+        body.halfHeight = height * 0.5f;
+        body.halfDepth = depth * 0.5f;
+        dynamicDirty = true;
+    }
+
+    void clearDynamicBodies() {
+        dynamicBodies.clear();
+        dynamicOrder.clear();
+        dynamicMaxWidthX = 0.0f;
+        dynamicDirty = false;
+    }
+
+    size_t getDynamicBodyCount() const {
+        return dynamicBodies.size();
+    }
+
+    const DynamicBody& getDynamicBody(size_t index) const {
+        return dynamicBodies[index];
+    }
+
+    // Unir cajas redundantes: contenidas, casi duplicadas o adyacentes y coplanares.
+    // Barrido sobre las cajas ordenadas por minX, repetido hasta que no haya ms uniones
+    // porque una unin puede habilitar otra. Devuelve cuntas cajas se eliminaron.
+    int simplifyBoxes(float tolerance = COLLISION_MERGE_TOLERANCE) {
+        detachBaked();
+
+        std::vector<MergeBounds> bounds(boxes.size());
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            const CollisionBox& box = boxes[i];
+            bounds[i].min[0] = box.getMinX(); bounds[i].max[0] = box.getMaxX();
+            bounds[i].min[1] = box.getMinY(); bounds[i].max[1] = box.getMaxY();
+            bounds[i].min[2] = box.getMinZ(); bounds[i].max[2] = box.getMaxZ();
+            bounds[i].removed = false;
+        }
+        std::sort(bounds.begin(), bounds.end());
+
+        int removed = 0;
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (size_t i = 0; i < bounds.size(); ++i) {
+                if (bounds[i].removed) continue;
+                MergeBounds& a = bounds[i];
+                // Ordenadas por minX: a partir de aqu ninguna caja puede tocar a 'a'
+                for (size_t j = i + 1; j < bounds.size() && bounds[j].min[0] <= a.max[0] + tolerance; ++j) {
+                    MergeBounds& b = bounds[j];
+                    if (b.removed || !canMergeBounds(a, b, tolerance)) continue;
+
+                    for (int axis = 0; axis < 3; ++axis) {
+                        a.min[axis] = fminf(a.min[axis], b.min[axis]);
+                        a.max[axis] = fmaxf(a.max[axis], b.max[axis]);
+                    }
+                    b.removed = true;
+                    removed++;
+                    merged = true;
+                }
+            }
+        }
+
+        if (removed > 0) {
+            boxes.clear();
+            for (size_t i = 0; i < bounds.size(); ++i) {
+                const MergeBounds& b = bounds[i];
+                if (b.removed) continue;
+                boxes.push_back(CollisionBox((b.min[0] + b.max[0]) * 0.5f,
+                                             (b.min[1] + b.max[1]) * 0.5f,
+                                             (b.min[2] + b.max[2]) * 0.5f,
+                                             b.max[0] - b.min[0],
+                                             b.max[1] - b.min[1],
+                                             b.max[2] - b.min[2]));
+            }
+            broadphaseDirty = true;
+        }
+        return removed;
+    }
+
     // Obtener el nmero de cajas de colisin
     size_t getBoxCount() const {
-        return boxes.size();
+        return bakeView ? (size_t)world.boxCount : boxes.size();
     }
     
     // Obtener una caja especfica (para debug)
     const CollisionBox& getBox(size_t index) const {
-        return boxes[index];
+        return bakeView ? world.boxes[index] : boxes[index];
     }
     
     // Mtodo para aadir colisiones especficas de la escalera
@@ -312,8 +1896,32 @@ public:
         }
     }
     
-    // Mtodo para sincronizar con el mundo
-    void setupWorldCollisions() {
+    // Mtodo para sincronizar con el mundo. Con 'bakedFile' usa el archivo
+    // horneado si sali de estas mismas cajas; si no, construye el broadphase
+    // y lo vuelve a guardar. Armar la lista de cajas es barato: lo caro es el BVH.
+    void setupWorldCollisions(const char* bakedFile = NULL) {
+        addWorldBoxes();
+        unsigned int sourceHash = hashBoxes();
+        if (bakedFile && loadBaked(bakedFile, sourceHash)) {
+            return;
+        }
+
+        // Quitar las cajas redundantes antes de construir el broadphase
+        size_t boxCountBefore = boxes.size();
+        int removedBoxes = simplifyBoxes();
+        printf("Colisiones: %d de %d cajas eliminadas por simplificacion\n", removedBoxes, (int)boxCountBefore);
+
+        // Construir el broadphase una sola vez con todas las cajas del mundo
+        buildBroadphase();
+
+        if (bakedFile) {
+            saveBaked(bakedFile, sourceHash);
+        }
+    }
+
+private:
+    // Las cajas del escenario, sin simplificar
+    void addWorldBoxes() {
         clearBoxes();
         
         // --- Casa Jaimito ---
@@ -461,9 +2069,6 @@ public:
         // Let's assume it's roughly 3 units wide, 1 unit high, 3 units deep (unscaled).
         addBox(piletaOffsetX, piletaOffsetY, piletaOffsetZ,
                3.0f * piletaScale, 1.0f * piletaScale, 3.0f * piletaScale);
-
-
-
     }
 };
 
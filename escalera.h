@@ -7,6 +7,8 @@
 #include <cmath>
 #include <cstdio>
 #include "texture.h"
+#include "textureatlas.h"
+#include "meshbuilder.h"
 
 class Escalera {
 private:
@@ -15,75 +17,75 @@ private:
     float scale;
     int numSteps;
     float stepWidth, stepHeight, stepDepth;
-    GLuint textureID;
+    AtlasRegion texture;    // Su rectngulo en el atlas de los objetos
     bool textureLoaded;
     
-    void drawTexturedCube(float x, float y, float z, float width, float height, float depth) {
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glScalef(width, height, depth);
+    void drawTexturedCube(MeshBuilder& mesh, float x, float y, float z, float width, float height, float depth) {
+        mesh.pushMatrix();
+        mesh.translate(x, y, z);
+        mesh.scale(width, height, depth);
         
         // Habilitar texturas si estn disponibles
         if (textureLoaded) {
-            TextureManager::bindTexture(textureID);
+            texture.bind(mesh);
         }
         
-        glBegin(GL_QUADS);
+        mesh.begin(GL_QUADS);
         
         // Cara frontal
-        glNormal3f(0.0f, 0.0f, 1.0f);
-        glTexCoord2f(0.0f, 0.0f); glVertex3f(-0.5f, -0.5f, 0.5f);
-        glTexCoord2f(1.0f, 0.0f); glVertex3f(0.5f, -0.5f, 0.5f);
-        glTexCoord2f(1.0f, 1.0f); glVertex3f(0.5f, 0.5f, 0.5f);
-        glTexCoord2f(0.0f, 1.0f); glVertex3f(-0.5f, 0.5f, 0.5f);
+        mesh.normal(0.0f, 0.0f, 1.0f);
+        mesh.texCoord(0.0f, 0.0f); mesh.vertex(-0.5f, -0.5f, 0.5f);
+        mesh.texCoord(1.0f, 0.0f); mesh.vertex(0.5f, -0.5f, 0.5f);
+        mesh.texCoord(1.0f, 1.0f); mesh.vertex(0.5f, 0.5f, 0.5f);
+        mesh.texCoord(0.0f, 1.0f); mesh.vertex(-0.5f, 0.5f, 0.5f);
         
         // Cara trasera
-        glNormal3f(0.0f, 0.0f, -1.0f);
-        glTexCoord2f(1.0f, 0.0f); glVertex3f(-0.5f, -0.5f, -0.5f);
-        glTexCoord2f(1.0f, 1.0f); glVertex3f(-0.5f, 0.5f, -0.5f);
-        glTexCoord2f(0.0f, 1.0f); glVertex3f(0.5f, 0.5f, -0.5f);
-        glTexCoord2f(0.0f, 0.0f); glVertex3f(0.5f, -0.5f, -0.5f);
+        mesh.normal(0.0f, 0.0f, -1.0f);
+        mesh.texCoord(1.0f, 0.0f); mesh.vertex(-0.5f, -0.5f, -0.5f);
+        mesh.texCoord(1.0f, 1.0f); mesh.vertex(-0.5f, 0.5f, -0.5f);
+        mesh.texCoord(0.0f, 1.0f); mesh.vertex(0.5f, 0.5f, -0.5f);
+        mesh.texCoord(0.0f, 0.0f); mesh.vertex(0.5f, -0.5f, -0.5f);
         
         // Cara superior
-        glNormal3f(0.0f, 1.0f, 0.0f);
-        glTexCoord2f(0.0f, 1.0f); glVertex3f(-0.5f, 0.5f, -0.5f);
-        glTexCoord2f(0.0f, 0.0f); glVertex3f(-0.5f, 0.5f, 0.5f);
-        glTexCoord2f(1.0f, 0.0f); glVertex3f(0.5f, 0.5f, 0.5f);
-        glTexCoord2f(1.0f, 1.0f); glVertex3f(0.5f, 0.5f, -0.5f);
+        mesh.normal(0.0f, 1.0f, 0.0f);
+        mesh.texCoord(0.0f, 1.0f); mesh.vertex(-0.5f, 0.5f, -0.5f);
+        mesh.texCoord(0.0f, 0.0f); mesh.vertex(-0.5f, 0.5f, 0.5f);
+        mesh.texCoord(1.0f, 0.0f); mesh.vertex(0.5f, 0.5f, 0.5f);
+        mesh.texCoord(1.0f, 1.0f); mesh.vertex(0.5f, 0.5f, -0.5f);
         
         // Cara inferior
-        glNormal3f(0.0f, -1.0f, 0.0f);
-        glTexCoord2f(1.0f, 1.0f); glVertex3f(-0.5f, -0.5f, -0.5f);
-        glTexCoord2f(0.0f, 1.0f); glVertex3f(0.5f, -0.5f, -0.5f);
-        glTexCoord2f(0.0f, 0.0f); glVertex3f(0.5f, -0.5f, 0.5f);
-        glTexCoord2f(1.0f, 0.0f); glVertex3f(-0.5f, -0.5f, 0.5f);
+        mesh.normal(0.0f, -1.0f, 0.0f);
+        mesh.texCoord(1.0f, 1.0f); mesh.vertex(-0.5f, -0.5f, -0.5f);
+        mesh.texCoord(0.0f, 1.0f); mesh.vertex(0.5f, -0.5f, -0.5f);
+        mesh.texCoord(0.0f, 0.0f); mesh.vertex(0.5f, -0.5f, 0.5f);
+        mesh.texCoord(1.0f, 0.0f); mesh.vertex(-0.5f, -0.5f, 0.5f);
         
         // Cara derecha
-        glNormal3f(1.0f, 0.0f, 0.0f);
-        glTexCoord2f(1.0f, 0.0f); glVertex3f(0.5f, -0.5f, -0.5f);
-        glTexCoord2f(1.0f, 1.0f); glVertex3f(0.5f, 0.5f, -0.5f);
-        glTexCoord2f(0.0f, 1.0f); glVertex3f(0.5f, 0.5f, 0.5f);
-        glTexCoord2f(0.0f, 0.0f); glVertex3f(0.5f, -0.5f, 0.5f);
+        mesh.normal(1.0f, 0.0f, 0.0f);
+        mesh.texCoord(1.0f, 0.0f); mesh.vertex(0.5f, -0.5f, -0.5f);
+        mesh.texCoord(1.0f, 1.0f); mesh.vertex(0.5f, 0.5f, -0.5f);
+        mesh.texCoord(0.0f, 1.0f); mesh.vertex(0.5f, 0.5f, 0.5f);
+        mesh.texCoord(0.0f, 0.0f); mesh.vertex(0.5f, -0.5f, 0.5f);
         
         // Cara izquierda
-        glNormal3f(-1.0f, 0.0f, 0.0f);
-        glTexCoord2f(0.0f, 0.0f); glVertex3f(-0.5f, -0.5f, -0.5f);
-        glTexCoord2f(1.0f, 0.0f); glVertex3f(-0.5f, -0.5f, 0.5f);
-        glTexCoord2f(1.0f, 1.0f); glVertex3f(-0.5f, 0.5f, 0.5f);
-        glTexCoord2f(0.0f, 1.0f); glVertex3f(-0.5f, 0.5f, -0.5f);
+        mesh.normal(-1.0f, 0.0f, 0.0f);
+        mesh.texCoord(0.0f, 0.0f); mesh.vertex(-0.5f, -0.5f, -0.5f);
+        mesh.texCoord(1.0f, 0.0f); mesh.vertex(-0.5f, -0.5f, 0.5f);
+        mesh.texCoord(1.0f, 1.0f); mesh.vertex(-0.5f, 0.5f, 0.5f);
+        mesh.texCoord(0.0f, 1.0f); mesh.vertex(-0.5f, 0.5f, -0.5f);
         
-        glEnd();
+        mesh.end();
         
         if (textureLoaded) {
-            TextureManager::unbindTexture();
+            mesh.bindTexture(0);
         }
         
-        glPopMatrix();
+        mesh.popMatrix();
     }
     
-    void drawSteps(float posX, float posY, float posZ) {
+    void drawSteps(MeshBuilder& mesh, float posX, float posY, float posZ) {
         // Color base para los escalones (se mezcla con la textura)
-        glColor3f(1.0f, 1.0f, 1.0f); // Blanco para mostrar textura natural
+        mesh.color(1.0f, 1.0f, 1.0f); // Blanco para mostrar textura natural
         
         int numSteps = 8;
         float stepWidth = 4.0f;
@@ -95,13 +97,13 @@ private:
             float y = posY + i * stepHeight;
             float z = posZ - i * stepDepth;
             
-            drawTexturedCube(x, y, z, stepWidth, stepHeight * 2, stepDepth);
+            drawTexturedCube(mesh, x, y, z, stepWidth, stepHeight * 2, stepDepth);
         }
     }
     
-    void drawRailing(float posX, float posY, float posZ) {
+    void drawRailing(MeshBuilder& mesh, float posX, float posY, float posZ) {
         // Color oscuro para el barandal
-        glColor3f(0.3f, 0.3f, 0.3f);
+        mesh.color(0.3f, 0.3f, 0.3f);
         
         int numSteps = 8;
         float stepHeight = 0.5f;  // Ajustado para coincidir con los escalones
@@ -114,7 +116,7 @@ private:
             float y = posY + i * stepHeight + railingHeight/2;
             float z = posZ - i * stepDepth;
             
-            drawTexturedCube(x, y, z, 0.1f, railingHeight, 0.1f);
+            drawTexturedCube(mesh, x, y, z, 0.1f, railingHeight, 0.1f);
         }
         
         // Barandal horizontal izquierdo
@@ -123,7 +125,7 @@ private:
             float y = posY + i * stepHeight + railingHeight;
             float z = posZ - i * stepDepth - stepDepth/2;
             
-            drawTexturedCube(x, y, z, 0.08f, 0.08f, stepDepth);
+            drawTexturedCube(mesh, x, y, z, 0.08f, 0.08f, stepDepth);
         }
         
         // Postes verticales del barandal derecho
@@ -132,7 +134,7 @@ private:
             float y = posY + i * stepHeight + railingHeight/2;
             float z = posZ - i * stepDepth;
             
-            drawTexturedCube(x, y, z, 0.1f, railingHeight, 0.1f);
+            drawTexturedCube(mesh, x, y, z, 0.1f, railingHeight, 0.1f);
         }
         
         // Barandal horizontal derecho
@@ -141,7 +143,7 @@ private:
             float y = posY + i * stepHeight + railingHeight;
             float z = posZ - i * stepDepth - stepDepth/2;
             
-            drawTexturedCube(x, y, z, 0.08f, 0.08f, stepDepth);
+            drawTexturedCube(mesh, x, y, z, 0.08f, 0.08f, stepDepth);
         }
     }
 
@@ -155,21 +157,19 @@ public:
         stepWidth = 4.0f;
         stepHeight = 0.5f;  // Actualizado para menor inclinacin (ms echada)
         stepDepth = 1.0f;   // Actualizado para menor inclinacin (ms echada)
-        textureID = 0;
         textureLoaded = false;
     }
     
     // Destructor
     ~Escalera() {
-        if (textureLoaded) {
-            TextureManager::deleteTexture(textureID);
-        }
+        PropAtlas::unload(texture);
     }
     
     // Cargar textura
     bool loadTexture(const char* filename) {
-        textureID = TextureManager::loadTexture(filename);
-        textureLoaded = (textureID != 0);
+        PropAtlas::unload(texture);
+        texture = PropAtlas::load(filename);
+        textureLoaded = (texture.texture != 0);
         return textureLoaded;
     }
     
@@ -180,75 +180,14 @@ public:
         }
     }
     
-    // Mtodo principal para dibujar la escalera completa
-    void render(float x = 0.0f, float y = 0.0f, float z = 0.0f) {
-        posX = x; posY = y; posZ = z;
-        rotationY = 0.0f; scale = 1.0f;
-        
-        // Asegurarse de que la textura est cargada
-        if (!textureLoaded) {
-            initialize();
-        }
-        
-        glPushMatrix();
-        drawSteps(x, y, z);
-        drawRailing(x, y, z);
-        glPopMatrix();
-    }
-    
-    // Mtodo para dibujar la escalera con rotacin
-    void drawRotated(float x, float y, float z, float rotY) {
-        posX = x; posY = y; posZ = z;
-        rotationY = rotY; scale = 1.0f;
-        
+    // Grabar escalones y barandales en el origen dentro de 'mesh' (el batch
+    // esttico de World). Carga la textura si falta.
+    void buildGeometry(MeshBuilder& mesh) {
         if (!textureLoaded) {
             initialize();
         }
-        
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glRotatef(rotY, 0.0f, 1.0f, 0.0f);
-        glTranslatef(-x, -y, -z);
-        drawSteps(x, y, z);
-        drawRailing(x, y, z);
-        glPopMatrix();
-    }
-    
-    // Mtodo para dibujar escalera con escala personalizada
-    void drawScaled(float x, float y, float z, float sc) {
-        posX = x; posY = y; posZ = z;
-        rotationY = 0.0f; scale = sc;
-        
-        if (!textureLoaded) {
-            initialize();
-        }
-        
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glScalef(sc, sc, sc);
-        glTranslatef(-x, -y, -z);
-        drawSteps(x, y, z);
-        drawRailing(x, y, z);
-        glPopMatrix();
-    }
-    
-    // Mtodo para dibujar escalera con rotacin y escala
-    void drawTransformed(float x, float y, float z, float rotY, float sc) {
-        posX = x; posY = y; posZ = z;
-        rotationY = rotY; scale = sc;
-        
-        if (!textureLoaded) {
-            initialize();
-        }
-        
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glRotatef(rotY, 0.0f, 1.0f, 0.0f);
-        glScalef(sc, sc, sc);
-        glTranslatef(-x, -y, -z);
-        drawSteps(x, y, z);
-        drawRailing(x, y, z);
-        glPopMatrix();
+        drawSteps(mesh, 0.0f, 0.0f, 0.0f);
+        drawRailing(mesh, 0.0f, 0.0f, 0.0f);
     }
     
     // ========== SISTEMA DE COLISIONES ==========
@@ -395,9 +334,6 @@ public:
     
     // Mtodo para cambiar la textura
     bool changeTexture(const char* filename) {
-        if (textureLoaded) {
-            TextureManager::deleteTexture(textureID);
-        }
         return loadTexture(filename);
     }
 };
@@ -0,0 +1,72 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <GL/glut.h>
+#include <cmath>
+
+// Los seis planos del volumen de visin, sacados de las matrices actuales de
+// OpenGL. Quedan en el espacio de la modelview actual: creado justo despus
+// de la cmara sirve para coordenadas de mundo, y creado dentro de un
+// glTranslatef sirve para las coordenadas de ese objeto.
+class Frustum {
+private:
+    float planes[6][4]; // a*x + b*y + c*z + d >= 0 adentro
+
+public:
+    Frustum() {
+        GLfloat modelview[16];
+        GLfloat projection[16];
+        glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+        glGetFloatv(GL_PROJECTION_MATRIX, projection);
+
+        // clip = projection * modelview (column-major)
+        float clip[16];
+        for (int col = 0; col < 4; col++) {
+            for (int row = 0; row < 4; row++) {
+                clip[col * 4 + row] = projection[row] * modelview[col * 4] +
+                                      projection[4 + row] * modelview[col * 4 + 1] +
+                                      projection[8 + row] * modelview[col * 4 + 2] +
+                                      projection[12 + row] * modelview[col * 4 + 3];
+            }
+        }
+
+        // Izquierda, derecha, abajo, arriba, cerca, lejos: fila 3 ms o menos fila 0, 1 y 2
+        for (int i = 0; i < 6; i++) {
+            int row = i / 2;
+            float sign = (i % 2 == 0) ? 1.0f : -1.0f;
+            for (int k = 0; k < 4; k++) {
+                planes[i][k] = clip[k * 4 + 3] + sign * clip[k * 4 + row];
+            }
+
+            float length = sqrtf(planes[i][0] * planes[i][0] + planes[i][1] * planes[i][1] +
+                                 planes[i][2] * planes[i][2]);
+            if (length > 0.0f) {
+                for (int k = 0; k < 4; k++) planes[i][k] /= length;
+            }
+        }
+    }
+
+    bool sphereVisible(float x, float y, float z, float radius) const {
+        for (int i = 0; i < 6; i++) {
+            if (planes[i][0] * x + planes[i][1] * y + planes[i][2] * z + planes[i][3] < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Caja alineada a los ejes: afuera solo si la esquina ms adentro de algn plano queda afuera
+    bool boxVisible(float minX, float minY, float minZ, float maxX, float maxY, float maxZ) const {
+        for (int i = 0; i < 6; i++) {
+            float x = planes[i][0] >= 0.0f ? maxX : minX;
+            float y = planes[i][1] >= 0.0f ? maxY : minY;
+            float z = planes[i][2] >= 0.0f ? maxZ : minZ;
+            if (planes[i][0] * x + planes[i][1] * y + planes[i][2] * z + planes[i][3] < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+#endif // FRUSTUM_H
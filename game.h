@@ -9,6 +9,8 @@
 #include "menu.h"
 #include "options.h"
 #include "playing.h"
+#include "renderstate.h"
+#include "bitmapfont.h"
 
 enum GameState {
     STATE_MENU,
@@ -96,22 +98,19 @@ private:
     }
     
     void renderText(float x, float y, const char* text) {
-        glRasterPos2f(x, y);
-        for (const char* c = text; *c != '\0'; c++) {
-            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-        }
+        BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, x, y, text);
     }
     
     void renderPausedOverlay() {
-        GLboolean lightingEnabled = glIsEnabled(GL_LIGHTING);
-        GLboolean depthTestEnabled = glIsEnabled(GL_DEPTH_TEST);
+        GLboolean lightingEnabled = RenderState::isEnabled(GL_LIGHTING);
+        GLboolean depthTestEnabled = RenderState::isEnabled(GL_DEPTH_TEST);
         
-        glDisable(GL_LIGHTING);
-        glDisable(GL_DEPTH_TEST);
+        RenderState::disable(GL_LIGHTING);
+        RenderState::disable(GL_DEPTH_TEST);
         
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glColor4f(0.0f, 0.0f, 0.0f, 0.5f);
+        RenderState::enable(GL_BLEND);
+        RenderState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        RenderState::color(0.0f, 0.0f, 0.0f, 0.5f);
         
         int viewport[4];
         glGetIntegerv(GL_VIEWPORT, viewport);
@@ -131,26 +130,20 @@ private:
             glVertex2f((float)viewport[2], (float)viewport[3]);
             glVertex2f(0.0f, (float)viewport[3]);
         glEnd();
-        glDisable(GL_BLEND);
+        RenderState::disable(GL_BLEND);
+        
+        float centerX = (float)viewport[2] / 2.0f;
+        float centerY = (float)viewport[3] / 2.0f;
         
-        glColor3f(1.0f, 1.0f, 1.0f);
-        glRasterPos2f((float)viewport[2] / 2.0f - 40.0f, (float)viewport[3] / 2.0f);
+        RenderState::color(1.0f, 1.0f, 1.0f);
         const char* pausedText = "PAUSADO";
-        for (const char* c = pausedText; *c != '\0'; c++) {
-            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-        }
+        BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, centerX - 40.0f, centerY, pausedText);
         
-        glRasterPos2f((float)viewport[2] / 2.0f - 80.0f, (float)viewport[3] / 2.0f + 30.0f);
         const char* continueText = "Presiona P para continuar";
-        for (const char* c = continueText; *c != '\0'; c++) {
-            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, *c);
-        }
+        BitmapFont::drawText(GLUT_BITMAP_HELVETICA_12, centerX - 80.0f, centerY + 30.0f, continueText);
         
-        glRasterPos2f((float)viewport[2] / 2.0f - 80.0f, (float)viewport[3] / 2.0f + 50.0f);
         const char* menuText = "Presiona ESC para menu";
-        for (const char* c = menuText; *c != '\0'; c++) {
-            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, *c);
-        }
+        BitmapFont::drawText(GLUT_BITMAP_HELVETICA_12, centerX - 80.0f, centerY + 50.0f, menuText);
         
         glPopMatrix();
         glMatrixMode(GL_PROJECTION);
@@ -158,32 +151,32 @@ private:
         glMatrixMode(GL_MODELVIEW);
         
         if (lightingEnabled) {
-            glEnable(GL_LIGHTING);
+            RenderState::enable(GL_LIGHTING);
         }
         if (depthTestEnabled) {
-            glEnable(GL_DEPTH_TEST);
+            RenderState::enable(GL_DEPTH_TEST);
         }
     }
     
     void setupMenuLighting() {
         // Limpiar completamente el estado de iluminacin
-        glDisable(GL_LIGHTING);
+        RenderState::disable(GL_LIGHTING);
         for (int i = 0; i < 8; i++) {
-            glDisable(GL_LIGHT0 + i);
+            RenderState::disable(GL_LIGHT0 + i);
         }
         
         // Limpiar otros estados que pueden verse afectados
-        glDisable(GL_DEPTH_TEST);
-        glDisable(GL_CULL_FACE);
-        glDisable(GL_NORMALIZE);
-        glDisable(GL_COLOR_MATERIAL);
-        glDisable(GL_BLEND);
+        RenderState::disable(GL_DEPTH_TEST);
+        RenderState::disable(GL_CULL_FACE);
+        RenderState::disable(GL_NORMALIZE);
+        RenderState::disable(GL_COLOR_MATERIAL);
+        RenderState::disable(GL_BLEND);
         
         // Restaurar color de fondo para mens
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         
         // Establecer color base
-        glColor3f(1.0f, 1.0f, 1.0f);
+        RenderState::color(1.0f, 1.0f, 1.0f);
         
         // Configurar matriz de proyeccin para 2D
         glMatrixMode(GL_PROJECTION);
@@ -234,25 +227,19 @@ private:
         int viewport[4];
         glGetIntegerv(GL_VIEWPORT, viewport);
         
-        glColor3f(1.0f, 0.0f, 0.0f);
-        glRasterPos2f((float)viewport[2] / 2.0f - 60.0f, (float)viewport[3] / 2.0f);
+        float centerX = (float)viewport[2] / 2.0f;
+        float centerY = (float)viewport[3] / 2.0f;
+        
+        RenderState::color(1.0f, 0.0f, 0.0f);
         const char* gameOverText = "GAME OVER";
-        for (const char* c = gameOverText; *c != '\0'; c++) {
-            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-        }
+        BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, centerX - 60.0f, centerY, gameOverText);
         
-        glColor3f(1.0f, 1.0f, 1.0f);
-        glRasterPos2f((float)viewport[2] / 2.0f - 100.0f, (float)viewport[3] / 2.0f + 40.0f);
+        RenderState::color(1.0f, 1.0f, 1.0f);
         const char* menuText = "Presiona ESC para menu";
-        for (const char* c = menuText; *c != '\0'; c++) {
-            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, *c);
-        }
+        BitmapFont::drawText(GLUT_BITMAP_HELVETICA_12, centerX - 100.0f, centerY + 40.0f, menuText);
         
-        glRasterPos2f((float)viewport[2] / 2.0f - 80.0f, (float)viewport[3] / 2.0f + 60.0f);
         const char* restartText = "Presiona R para reiniciar";
-        for (const char* c = restartText; *c != '\0'; c++) {
-            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, *c);
-        }
+        BitmapFont::drawText(GLUT_BITMAP_HELVETICA_12, centerX - 80.0f, centerY + 60.0f, restartText);
     }
     
     void safeStateTransition(GameState newState) {
@@ -282,23 +269,24 @@ private:
     
     void cleanupLightingState() {
         // Deshabilitar sistema de iluminacin
-        glDisable(GL_LIGHTING);
+        LightingShader::reset();
+        RenderState::disable(GL_LIGHTING);
         for (int i = 0; i < 8; i++) {
-            glDisable(GL_LIGHT0 + i);
+            RenderState::disable(GL_LIGHT0 + i);
         }
         
         // Limpiar otros estados relacionados con rendering 3D
-        glDisable(GL_DEPTH_TEST);
-        glDisable(GL_CULL_FACE);
-        glDisable(GL_NORMALIZE);
-        glDisable(GL_COLOR_MATERIAL);
-        glDisable(GL_BLEND);
+        RenderState::disable(GL_DEPTH_TEST);
+        RenderState::disable(GL_CULL_FACE);
+        RenderState::disable(GL_NORMALIZE);
+        RenderState::disable(GL_COLOR_MATERIAL);
+        RenderState::disable(GL_BLEND);
         
         // Resetear color de fondo
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         
         // Resetear color actual
-        glColor3f(1.0f, 1.0f, 1.0f);
+        RenderState::color(1.0f, 1.0f, 1.0f);
         
         // Limpiar matriz de transformacin
         glMatrixMode(GL_MODELVIEW);
@@ -0,0 +1,263 @@
+#ifndef GLEXTENSIONS_H
+#define GLEXTENSIONS_H
+
+#include <windows.h>
+#include <GL/glut.h>
+#include <cstdio>
+#include <cstddef>
+#include <cstring>
+
+// opengl32.dll solo exporta OpenGL 1.1; todo lo posterior hay que pedirlo al
+// driver con wglGetProcAddress una vez que existe el contexto.
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_ELEMENT_ARRAY_BUFFER
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+#ifndef GL_TEXTURE_MAX_LEVEL
+#define GL_TEXTURE_MAX_LEVEL 0x813D
+#endif
+#ifndef GL_TEXTURE_MAX_ANISOTROPY_EXT
+#define GL_TEXTURE_MAX_ANISOTROPY_EXT 0x84FE
+#endif
+#ifndef GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT
+#define GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT 0x84FF
+#endif
+#ifndef GL_FRAMEBUFFER
+#define GL_FRAMEBUFFER 0x8D40
+#endif
+#ifndef GL_RENDERBUFFER
+#define GL_RENDERBUFFER 0x8D41
+#endif
+#ifndef GL_COLOR_ATTACHMENT0
+#define GL_COLOR_ATTACHMENT0 0x8CE0
+#endif
+#ifndef GL_FRAMEBUFFER_COMPLETE
+#define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#endif
+
+class GLExtensions {
+public:
+    // Buffer objects (OpenGL 1.5 / GL_ARB_vertex_buffer_object)
+    typedef void (APIENTRY *GenBuffersProc)(GLsizei n, GLuint* buffers);
+    typedef void (APIENTRY *DeleteBuffersProc)(GLsizei n, const GLuint* buffers);
+    typedef void (APIENTRY *BindBufferProc)(GLenum target, GLuint buffer);
+    typedef void (APIENTRY *BufferDataProc)(GLenum target, ptrdiff_t size, const void* data, GLenum usage);
+
+    static GenBuffersProc genBuffers;
+    static DeleteBuffersProc deleteBuffers;
+    static BindBufferProc bindBuffer;
+    static BufferDataProc bufferData;
+
+    // Shaders (OpenGL 2.0 / GL_ARB_shader_objects). Los nombres ARB usan
+    // handles en vez de nombres, pero en Windows son el mismo entero.
+    typedef GLuint (APIENTRY *CreateShaderProc)(GLenum type);
+    typedef void (APIENTRY *ShaderSourceProc)(GLuint shader, GLsizei count, const char** strings, const GLint* lengths);
+    typedef void (APIENTRY *CompileShaderProc)(GLuint shader);
+    typedef GLuint (APIENTRY *CreateProgramProc)();
+    typedef void (APIENTRY *AttachShaderProc)(GLuint program, GLuint shader);
+    typedef void (APIENTRY *LinkProgramProc)(GLuint program);
+    typedef void (APIENTRY *UseProgramProc)(GLuint program);
+    typedef void (APIENTRY *DeleteObjectProc)(GLuint object);
+    typedef void (APIENTRY *GetObjectivProc)(GLuint object, GLenum pname, GLint* params);
+    typedef void (APIENTRY *GetInfoLogProc)(GLuint object, GLsizei maxLength, GLsizei* length, char* log);
+    typedef GLint (APIENTRY *GetUniformLocationProc)(GLuint program, const char* name);
+    typedef void (APIENTRY *Uniform1iProc)(GLint location, GLint value);
+    typedef void (APIENTRY *Uniform4fvProc)(GLint location, GLsizei count, const GLfloat* values);
+
+    static CreateShaderProc createShader;
+    static ShaderSourceProc shaderSource;
+    static CompileShaderProc compileShader;
+    static GetObjectivProc getShaderiv;
+    static GetInfoLogProc getShaderInfoLog;
+    static DeleteObjectProc deleteShader;
+    static CreateProgramProc createProgram;
+    static AttachShaderProc attachShader;
+    static LinkProgramProc linkProgram;
+    static GetObjectivProc getProgramiv;
+    static GetInfoLogProc getProgramInfoLog;
+    static DeleteObjectProc deleteProgram;
+    static UseProgramProc useProgram;
+    static GetUniformLocationProc getUniformLocation;
+    static Uniform1iProc uniform1i;
+    static Uniform4fvProc uniform4fv;
+
+    // Framebuffers fuera de pantalla (OpenGL 3.0 / GL_EXT_framebuffer_object)
+    typedef void (APIENTRY *GenObjectsProc)(GLsizei n, GLuint* objects);
+    typedef void (APIENTRY *DeleteObjectsProc)(GLsizei n, const GLuint* objects);
+    typedef void (APIENTRY *BindObjectProc)(GLenum target, GLuint object);
+    typedef void (APIENTRY *RenderbufferStorageProc)(GLenum target, GLenum format, GLsizei width, GLsizei height);
+    typedef void (APIENTRY *FramebufferRenderbufferProc)(GLenum target, GLenum attachment,
+                                                         GLenum renderbufferTarget, GLuint renderbuffer);
+    typedef GLenum (APIENTRY *CheckFramebufferStatusProc)(GLenum target);
+
+    static GenObjectsProc genFramebuffers;
+    static DeleteObjectsProc deleteFramebuffers;
+    static BindObjectProc bindFramebuffer;
+    static GenObjectsProc genRenderbuffers;
+    static DeleteObjectsProc deleteRenderbuffers;
+    static BindObjectProc bindRenderbuffer;
+    static RenderbufferStorageProc renderbufferStorage;
+    static FramebufferRenderbufferProc framebufferRenderbuffer;
+    static CheckFramebufferStatusProc checkFramebufferStatus;
+
+    // Cargar los punteros. Necesita un contexto activo; se puede llamar varias veces.
+    static void load() {
+        if (loaded) return;
+        loaded = true;
+
+        genBuffers = (GenBuffersProc)getProc("glGenBuffers", "glGenBuffersARB");
+        deleteBuffers = (DeleteBuffersProc)getProc("glDeleteBuffers", "glDeleteBuffersARB");
+        bindBuffer = (BindBufferProc)getProc("glBindBuffer", "glBindBufferARB");
+        bufferData = (BufferDataProc)getProc("glBufferData", "glBufferDataARB");
+
+        createShader = (CreateShaderProc)getProc("glCreateShader", "glCreateShaderObjectARB");
+        shaderSource = (ShaderSourceProc)getProc("glShaderSource", "glShaderSourceARB");
+        compileShader = (CompileShaderProc)getProc("glCompileShader", "glCompileShaderARB");
+        getShaderiv = (GetObjectivProc)getProc("glGetShaderiv", "glGetObjectParameterivARB");
+        getShaderInfoLog = (GetInfoLogProc)getProc("glGetShaderInfoLog", "glGetInfoLogARB");
+        deleteShader = (DeleteObjectProc)getProc("glDeleteShader", "glDeleteObjectARB");
+        createProgram = (CreateProgramProc)getProc("glCreateProgram", "glCreateProgramObjectARB");
+        attachShader = (AttachShaderProc)getProc("glAttachShader", "glAttachObjectARB");
+        linkProgram = (LinkProgramProc)getProc("glLinkProgram", "glLinkProgramARB");
+        getProgramiv = (GetObjectivProc)getProc("glGetProgramiv", "glGetObjectParameterivARB");
+        getProgramInfoLog = (GetInfoLogProc)getProc("glGetProgramInfoLog", "glGetInfoLogARB");
+        deleteProgram = (DeleteObjectProc)getProc("glDeleteProgram", "glDeleteObjectARB");
+        useProgram = (UseProgramProc)getProc("glUseProgram", "glUseProgramObjectARB");
+        getUniformLocation = (GetUniformLocationProc)getProc("glGetUniformLocation", "glGetUniformLocationARB");
+        uniform1i = (Uniform1iProc)getProc("glUniform1i", "glUniform1iARB");
+        uniform4fv = (Uniform4fvProc)getProc("glUniform4fv", "glUniform4fvARB");
+
+        genFramebuffers = (GenObjectsProc)getProc("glGenFramebuffers", "glGenFramebuffersEXT");
+        deleteFramebuffers = (DeleteObjectsProc)getProc("glDeleteFramebuffers", "glDeleteFramebuffersEXT");
+        bindFramebuffer = (BindObjectProc)getProc("glBindFramebuffer", "glBindFramebufferEXT");
+        genRenderbuffers = (GenObjectsProc)getProc("glGenRenderbuffers", "glGenRenderbuffersEXT");
+        deleteRenderbuffers = (DeleteObjectsProc)getProc("glDeleteRenderbuffers", "glDeleteRenderbuffersEXT");
+        bindRenderbuffer = (BindObjectProc)getProc("glBindRenderbuffer", "glBindRenderbufferEXT");
+        renderbufferStorage = (RenderbufferStorageProc)getProc("glRenderbufferStorage", "glRenderbufferStorageEXT");
+        framebufferRenderbuffer = (FramebufferRenderbufferProc)getProc("glFramebufferRenderbuffer",
+                                                                       "glFramebufferRenderbufferEXT");
+        checkFramebufferStatus = (CheckFramebufferStatusProc)getProc("glCheckFramebufferStatus",
+                                                                     "glCheckFramebufferStatusEXT");
+
+        if (!hasVertexBuffers()) {
+            printf("Aviso: El driver no soporta vertex buffer objects, se usaran arrays en memoria\n");
+        }
+        if (!hasShaders()) {
+            printf("Aviso: El driver no soporta shaders, se usara la iluminacion fija\n");
+        }
+    }
+
+    static bool hasVertexBuffers() {
+        return genBuffers && deleteBuffers && bindBuffer && bufferData;
+    }
+
+    static bool hasShaders() {
+        return createShader && shaderSource && compileShader && getShaderiv && getShaderInfoLog &&
+               deleteShader && createProgram && attachShader && linkProgram && getProgramiv &&
+               getProgramInfoLog && deleteProgram && useProgram && getUniformLocation &&
+               uniform1i && uniform4fv;
+    }
+
+    static bool hasFramebuffers() {
+        return genFramebuffers && deleteFramebuffers && bindFramebuffer && genRenderbuffers &&
+               deleteRenderbuffers && bindRenderbuffer && renderbufferStorage &&
+               framebufferRenderbuffer && checkFramebufferStatus;
+    }
+
+    // Nombre completo dentro de la lista de GL_EXTENSIONS (no un prefijo de otro)
+    static bool hasExtension(const char* name) {
+        const char* list = (const char*)glGetString(GL_EXTENSIONS);
+        if (!list) return false;
+
+        size_t length = strlen(name);
+        for (const char* found = strstr(list, name); found; found = strstr(found + length, name)) {
+            bool startsWord = (found == list || found[-1] == ' ');
+            bool endsWord = (found[length] == ' ' || found[length] == '\0');
+            if (startsWord && endsWord) return true;
+        }
+        return false;
+    }
+
+    // Filtrado anisotrpico (GL_EXT_texture_filter_anisotropic); 1 si no hay
+    static float getMaxAnisotropy() {
+        if (maxAnisotropy == 0.0f) {
+            maxAnisotropy = 1.0f;
+            if (hasExtension("GL_EXT_texture_filter_anisotropic")) {
+                glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy);
+            }
+        }
+        return maxAnisotropy;
+    }
+
+private:
+    static bool loaded;
+    static float maxAnisotropy;
+
+    static PROC getProc(const char* name, const char* arbName) {
+        PROC proc = wglGetProcAddress(name);
+        if (!proc) proc = wglGetProcAddress(arbName);
+        return proc;
+    }
+};
+
+GLExtensions::GenBuffersProc GLExtensions::genBuffers = NULL;
+GLExtensions::DeleteBuffersProc GLExtensions::deleteBuffers = NULL;
+GLExtensions::BindBufferProc GLExtensions::bindBuffer = NULL;
+GLExtensions::BufferDataProc GLExtensions::bufferData = NULL;
+GLExtensions::CreateShaderProc GLExtensions::createShader = NULL;
+GLExtensions::ShaderSourceProc GLExtensions::shaderSource = NULL;
+GLExtensions::CompileShaderProc GLExtensions::compileShader = NULL;
+GLExtensions::GetObjectivProc GLExtensions::getShaderiv = NULL;
+GLExtensions::GetInfoLogProc GLExtensions::getShaderInfoLog = NULL;
+GLExtensions::DeleteObjectProc GLExtensions::deleteShader = NULL;
+GLExtensions::CreateProgramProc GLExtensions::createProgram = NULL;
+GLExtensions::AttachShaderProc GLExtensions::attachShader = NULL;
+GLExtensions::LinkProgramProc GLExtensions::linkProgram = NULL;
+GLExtensions::GetObjectivProc GLExtensions::getProgramiv = NULL;
+GLExtensions::GetInfoLogProc GLExtensions::getProgramInfoLog = NULL;
+GLExtensions::DeleteObjectProc GLExtensions::deleteProgram = NULL;
+GLExtensions::UseProgramProc GLExtensions::useProgram = NULL;
+GLExtensions::GetUniformLocationProc GLExtensions::getUniformLocation = NULL;
+GLExtensions::Uniform1iProc GLExtensions::uniform1i = NULL;
+GLExtensions::Uniform4fvProc GLExtensions::uniform4fv = NULL;
+GLExtensions::GenObjectsProc GLExtensions::genFramebuffers = NULL;
+GLExtensions::DeleteObjectsProc GLExtensions::deleteFramebuffers = NULL;
+GLExtensions::BindObjectProc GLExtensions::bindFramebuffer = NULL;
+GLExtensions::GenObjectsProc GLExtensions::genRenderbuffers = NULL;
+GLExtensions::DeleteObjectsProc GLExtensions::deleteRenderbuffers = NULL;
+GLExtensions::BindObjectProc GLExtensions::bindRenderbuffer = NULL;
+GLExtensions::RenderbufferStorageProc GLExtensions::renderbufferStorage = NULL;
+GLExtensions::FramebufferRenderbufferProc GLExtensions::framebufferRenderbuffer = NULL;
+GLExtensions::CheckFramebufferStatusProc GLExtensions::checkFramebufferStatus = NULL;
+bool GLExtensions::loaded = false;
+float GLExtensions::maxAnisotropy = 0.0f;
+
+#endif // GLEXTENSIONS_H
@@ -0,0 +1,120 @@
+#ifndef LEVELOFDETAIL_H
+#define LEVELOFDETAIL_H
+
+#include <GL/glut.h>
+#include <cmath>
+
+// Matrices actuales de OpenGL, ledas una vez para medir varios objetos
+class ScreenProjection {
+private:
+    GLfloat modelview[16];
+    float pixelsPerUnit; // A distancia 1 de la cmara
+
+public:
+    ScreenProjection() {
+        GLfloat projection[16];
+        GLint viewport[4];
+        glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+        glGetFloatv(GL_PROJECTION_MATRIX, projection);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        pixelsPerUnit = projection[5] * viewport[3] * 0.5f;
+    }
+
+    // Radio en pxeles de una esfera de radio 'radius' centrada en (x, y, z),
+    // en coordenadas del objeto (cuenta la escala de la matriz actual)
+    float pixelRadius(float x, float y, float z, float radius) const {
+        float scale = sqrtf(modelview[0] * modelview[0] + modelview[1] * modelview[1] +
+                            modelview[2] * modelview[2]);
+        float depth = -(modelview[2] * x + modelview[6] * y + modelview[10] * z + modelview[14]);
+        if (depth <= 0.01f) {
+            return 1e6f; // Encima de la cmara o detrs: el mximo detalle
+        }
+        return radius * scale * pixelsPerUnit / depth;
+    }
+};
+
+// Elige un nivel de detalle (0 = el ms fino) segn el tamao en pantalla.
+// Cada nivel pide un radio mnimo en pxeles; para cambiar de nivel hay que
+// pasar el umbral por un margen, as un objeto en el lmite no parpadea entre
+// dos teselaciones.
+class LevelOfDetail {
+private:
+    static const int MAX_LEVELS = 4;
+    static int globalBias; // Desde el men de opciones
+
+    float minRadius[MAX_LEVELS]; // Radio mnimo en pxeles de cada nivel
+    int levelCount;
+    int level;                   // -1 hasta la primera seleccin
+    int bias;                    // Propio del objeto, se suma al global
+
+public:
+    // Margen de histresis: 20% por encima o por debajo del umbral
+    static const float HYSTERESIS;
+
+    // Umbrales para esferas y dems objetos redondos: completo desde 60
+    // pxeles de radio, despus 25 y 10
+    LevelOfDetail() : levelCount(4), level(-1), bias(0) {
+        minRadius[0] = 60.0f;
+        minRadius[1] = 25.0f;
+        minRadius[2] = 10.0f;
+        minRadius[3] = 0.0f;
+    }
+
+    // 'radii' son los radios mnimos de los niveles ms finos, de mayor a
+    // menor; el ltimo nivel (levelCount - 1) no tiene mnimo
+    LevelOfDetail(const float* radii, int count) : level(-1), bias(0) {
+        if (count > MAX_LEVELS) count = MAX_LEVELS;
+        if (count < 1) count = 1;
+        levelCount = count;
+        for (int i = 0; i < count - 1; i++) {
+            minRadius[i] = radii[i];
+        }
+        minRadius[count - 1] = 0.0f;
+    }
+
+    int select(float pixelRadius) {
+        // Cada punto de sesgo duplica (o reduce a la mitad) el tamao aparente
+        float radius = pixelRadius * powf(2.0f, (float)(globalBias + bias));
+
+        if (level < 0) {
+            level = 0;
+            while (level < levelCount - 1 && radius < minRadius[level]) level++;
+            return level;
+        }
+
+        while (level < levelCount - 1 && radius < minRadius[level] * (1.0f - HYSTERESIS)) level++;
+        while (level > 0 && radius >= minRadius[level - 1] * (1.0f + HYSTERESIS)) level--;
+        return level;
+    }
+
+    int getLevel() const {
+        return level < 0 ? 0 : level;
+    }
+
+    void setBias(int value) {
+        bias = value;
+    }
+
+    int getBias() const {
+        return bias;
+    }
+
+    // Teselacin del nivel: la completa dividida a la mitad por cada nivel
+    static int scaleDetail(int full, int level, int minimum) {
+        int detail = full >> level;
+        return detail < minimum ? minimum : detail;
+    }
+
+    static void setGlobalBias(int value) {
+        globalBias = value;
+    }
+
+    static int getGlobalBias() {
+        return globalBias;
+    }
+};
+
+int LevelOfDetail::globalBias = 0;
+const float LevelOfDetail::HYSTERESIS = 0.2f;
+
+#endif // LEVELOFDETAIL_H
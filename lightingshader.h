@@ -0,0 +1,315 @@
+#ifndef LIGHTINGSHADER_H
+#define LIGHTINGSHADER_H
+
+#include <GL/glut.h>
+#include <cstdio>
+#include "glextensions.h"
+#include "renderstate.h"
+
+// Iluminacin por pxel con GLSL. Hace las mismas cuentas que la iluminacin
+// fija (luz ambiente de la escena, difusa y especular de Blinn con el
+// observador en el infinito) pero por fragmento en vez de por vrtice.
+//
+// El material sale de donde ya lo ponen los objetos: glColor para ambiente y
+// difuso cuando GL_COLOR_MATERIAL est prendido, y glMaterial (especular,
+// brillo, emisin) por los uniforms del material que OpenGL mantiene. Las luces
+// van en un bloque de uniforms propio que llena Lightning, as dibujar no
+// cuesta ningn glLight.
+//
+// Quien dibuja encierra su tanda entre begin() y end(). Si el driver no tiene
+// shaders, o el programa no compila, begin() no hace nada y queda el camino fijo.
+class LightingShader {
+public:
+    static const int MAX_LIGHTS = 4;
+
+    // Compilar el programa para la cantidad de luces actual (hay uno por
+    // cantidad: con el nmero fijo el compilador desenrolla el ciclo, y un
+    // ciclo variable por pxel cuesta caro en drivers por software). Necesita
+    // el contexto activo; se puede llamar varias veces.
+    static bool load() {
+        if (!loaded) {
+            loaded = true;
+            GLExtensions::load();
+            available = GLExtensions::hasShaders();
+        }
+        if (!available) return false;
+
+        Program& p = programs[lightCount];
+        if (p.id != 0) return true;
+
+        char defines[64];
+        sprintf(defines, "#version 110\n#define LIGHT_COUNT %d\n", lightCount);
+
+        GLuint vertexShader = compile(GL_VERTEX_SHADER, defines, VERTEX_SOURCE);
+        GLuint fragmentShader = compile(GL_FRAGMENT_SHADER, defines, FRAGMENT_SOURCE);
+        GLuint program = 0;
+        if (vertexShader && fragmentShader) {
+            program = GLExtensions::createProgram();
+            GLExtensions::attachShader(program, vertexShader);
+            GLExtensions::attachShader(program, fragmentShader);
+            GLExtensions::linkProgram(program);
+
+            GLint linked = 0;
+            GLExtensions::getProgramiv(program, GL_LINK_STATUS, &linked);
+            if (!linked) {
+                char log[1024];
+                GLExtensions::getProgramInfoLog(program, sizeof(log), NULL, log);
+                printf("Error: No se pudo enlazar el shader de iluminacion:\n%s\n", log);
+                GLExtensions::deleteProgram(program);
+                program = 0;
+            }
+        }
+        // El programa se queda con ellos; se borran junto con l
+        if (vertexShader) GLExtensions::deleteShader(vertexShader);
+        if (fragmentShader) GLExtensions::deleteShader(fragmentShader);
+
+        if (program == 0) {
+            available = false; // Si no compila uno, no compila ninguno
+            return false;
+        }
+
+        p.id = program;
+        p.lightBlock = GLExtensions::getUniformLocation(program, "lightBlock");
+        p.lit = GLExtensions::getUniformLocation(program, "lit");
+        p.textured = GLExtensions::getUniformLocation(program, "textured");
+        p.colorMaterial = GLExtensions::getUniformLocation(program, "colorMaterial");
+        p.lightsDirty = true;
+        p.litState = p.texturedState = p.colorMaterialState = -1;
+
+        GLExtensions::useProgram(program);
+        GLExtensions::uniform1i(GLExtensions::getUniformLocation(program, "texture0"), 0);
+        GLExtensions::useProgram(0);
+        return true;
+    }
+
+    static void release() {
+        reset();
+        for (int i = 0; i <= MAX_LIGHTS; i++) {
+            if (programs[i].id) GLExtensions::deleteProgram(programs[i].id);
+            programs[i].id = 0;
+        }
+        available = false;
+        loaded = false;
+    }
+
+    static bool isAvailable() {
+        return available;
+    }
+
+    // Usar el camino fijo aunque haya shaders
+    static void setEnabled(bool value) {
+        enabled = value;
+    }
+
+    static bool isEnabled() {
+        return enabled;
+    }
+
+    static bool isActive() {
+        return available && enabled;
+    }
+
+    // ---- Bloque de luces ----
+
+    // Igual que glLightfv(GL_POSITION): la posicin se lleva al espacio del ojo
+    // con la modelview actual. w = 0 es una luz direccional.
+    static void setLight(int index, const GLfloat* position, const GLfloat* ambient,
+                         const GLfloat* diffuse, const GLfloat* specular) {
+        if (index < 0 || index >= MAX_LIGHTS) return;
+
+        GLfloat modelview[16];
+        glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+
+        GLfloat* light = &lightBlock[(1 + index * 4) * 4];
+        for (int row = 0; row < 4; row++) {
+            light[row] = modelview[row] * position[0] + modelview[4 + row] * position[1] +
+                         modelview[8 + row] * position[2] + modelview[12 + row] * position[3];
+        }
+        for (int k = 0; k < 4; k++) {
+            light[4 + k] = ambient[k];
+            light[8 + k] = diffuse[k];
+            light[12 + k] = specular[k];
+        }
+        markLightsDirty();
+    }
+
+    static void setLightCount(int count) {
+        lightCount = count < 0 ? 0 : (count > MAX_LIGHTS ? MAX_LIGHTS : count);
+        markLightsDirty();
+    }
+
+    // Como GL_LIGHT_MODEL_AMBIENT
+    static void setSceneAmbient(const GLfloat* ambient) {
+        for (int k = 0; k < 4; k++) lightBlock[k] = ambient[k];
+        markLightsDirty();
+    }
+
+    // ---- Dibujo ----
+
+    // Empezar una tanda con el shader (se puede anidar). Sin iluminacin el
+    // camino fijo ya es solo color por textura, as que se queda en l.
+    static void begin() {
+        if (depth > 0) {
+            depth++;
+            sync();
+            return;
+        }
+        if (!isActive() || !RenderState::isEnabled(GL_LIGHTING) || !load()) return;
+
+        current = &programs[lightCount];
+        depth = 1;
+        GLExtensions::useProgram(current->id);
+        if (current->lightsDirty) {
+            GLExtensions::uniform4fv(current->lightBlock, 1 + 4 * MAX_LIGHTS, lightBlock);
+            current->lightsDirty = false;
+        }
+        sync();
+    }
+
+    // Pasarle al shader lo que se prendi o apag con glEnable desde begin():
+    // iluminacin, textura y color como material. Solo manda lo que cambi.
+    static void sync() {
+        if (depth == 0) return;
+        setFlag(current->lit, current->litState, RenderState::isEnabled(GL_LIGHTING));
+        setFlag(current->textured, current->texturedState, RenderState::isEnabled(GL_TEXTURE_2D));
+        setFlag(current->colorMaterial, current->colorMaterialState,
+                RenderState::isEnabled(GL_COLOR_MATERIAL));
+    }
+
+    static void end() {
+        if (depth == 0) return;
+        if (--depth == 0) {
+            GLExtensions::useProgram(0);
+            current = NULL;
+        }
+    }
+
+    // Volver al camino fijo pase lo que pase (al salir del juego)
+    static void reset() {
+        if (depth > 0) {
+            GLExtensions::useProgram(0);
+        }
+        depth = 0;
+        current = NULL;
+    }
+
+private:
+    static const char* VERTEX_SOURCE;
+    static const char* FRAGMENT_SOURCE;
+
+    struct Program {
+        GLuint id;
+        GLint lightBlock;
+        GLint lit;
+        GLint textured;
+        GLint colorMaterial;
+        bool lightsDirty;       // El bloque de luces cambi desde la ltima subida
+        int litState;           // ltimo valor mandado de cada bandera (-1 = nunca)
+        int texturedState;
+        int colorMaterialState;
+    };
+
+    static Program programs[MAX_LIGHTS + 1]; // Uno por cantidad de luces
+    static Program* current;
+    static bool loaded;
+    static bool available;
+    static bool enabled;
+    static int depth;
+
+    // [0] luz ambiente de la escena; por luz: posicin, ambiente, difusa, especular
+    static GLfloat lightBlock[(1 + 4 * MAX_LIGHTS) * 4];
+    static int lightCount;
+
+    static void markLightsDirty() {
+        for (int i = 0; i <= MAX_LIGHTS; i++) programs[i].lightsDirty = true;
+    }
+
+    static void setFlag(GLint location, int& state, bool value) {
+        int v = value ? 1 : 0;
+        if (state == v) return;
+        GLExtensions::uniform1i(location, v);
+        state = v;
+    }
+
+    static GLuint compile(GLenum type, const char* defines, const char* source) {
+        const char* sources[2] = { defines, source };
+        GLuint shader = GLExtensions::createShader(type);
+        GLExtensions::shaderSource(shader, 2, sources, NULL);
+        GLExtensions::compileShader(shader);
+
+        GLint compiled = 0;
+        GLExtensions::getShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+        if (!compiled) {
+            char log[1024];
+            GLExtensions::getShaderInfoLog(shader, sizeof(log), NULL, log);
+            printf("Error: No se pudo compilar el shader de iluminacion:\n%s\n", log);
+            GLExtensions::deleteShader(shader);
+            return 0;
+        }
+        return shader;
+    }
+};
+
+// GLSL 1.10 para que corra en cualquier driver con OpenGL 2.0 (y en Mesa
+// llvmpipe). La versin y LIGHT_COUNT van delante, desde load().
+const char* LightingShader::VERTEX_SOURCE =
+    "varying vec3 eyePosition;\n"
+    "varying vec3 eyeNormal;\n"
+    "void main() {\n"
+    "    vec4 position = gl_ModelViewMatrix * gl_Vertex;\n"
+    "    eyePosition = position.xyz / position.w;\n"
+    "    eyeNormal = gl_NormalMatrix * gl_Normal;\n"
+    "    gl_FrontColor = gl_Color;\n"
+    "    gl_TexCoord[0] = gl_TextureMatrix[0] * gl_MultiTexCoord0;\n"
+    "    gl_Position = ftransform();\n"
+    "}\n";
+
+const char* LightingShader::FRAGMENT_SOURCE =
+    "const int MAX_LIGHTS = 4;\n"
+    "uniform vec4 lightBlock[1 + 4 * MAX_LIGHTS];\n"
+    "uniform int lit;\n"
+    "uniform int textured;\n"
+    "uniform int colorMaterial;\n"
+    "uniform sampler2D texture0;\n"
+    "varying vec3 eyePosition;\n"
+    "varying vec3 eyeNormal;\n"
+    "void main() {\n"
+    "    vec4 color = gl_Color;\n"
+    "    if (lit != 0) {\n"
+    "        vec4 ambient = colorMaterial != 0 ? gl_Color : gl_FrontMaterial.ambient;\n"
+    "        vec4 diffuse = colorMaterial != 0 ? gl_Color : gl_FrontMaterial.diffuse;\n"
+    "        vec3 n = normalize(eyeNormal);\n"
+    "        vec3 result = gl_FrontMaterial.emission.rgb + lightBlock[0].rgb * ambient.rgb;\n"
+    "        for (int i = 0; i < LIGHT_COUNT; i++) {\n"
+    "            vec4 position = lightBlock[1 + 4 * i];\n"
+    "            vec3 l = position.w == 0.0 ? normalize(position.xyz)\n"
+    "                                       : normalize(position.xyz - eyePosition);\n"
+    "            float nDotL = max(dot(n, l), 0.0);\n"
+    "            result += lightBlock[2 + 4 * i].rgb * ambient.rgb;\n"
+    "            result += nDotL * lightBlock[3 + 4 * i].rgb * diffuse.rgb;\n"
+    "            if (nDotL > 0.0) {\n"
+    "                vec3 h = normalize(l + vec3(0.0, 0.0, 1.0));\n"
+    "                float nDotH = max(dot(n, h), 0.0);\n"
+    "                float shine = gl_FrontMaterial.shininess > 0.0\n"
+    "                              ? pow(nDotH, gl_FrontMaterial.shininess) : 1.0;\n"
+    "                result += shine * lightBlock[4 + 4 * i].rgb * gl_FrontMaterial.specular.rgb;\n"
+    "            }\n"
+    "        }\n"
+    "        color = vec4(clamp(result, 0.0, 1.0), diffuse.a);\n"
+    "    }\n"
+    "    if (textured != 0) {\n"
+    "        color *= texture2D(texture0, gl_TexCoord[0].st);\n"
+    "    }\n"
+    "    gl_FragColor = color;\n"
+    "}\n";
+
+LightingShader::Program LightingShader::programs[LightingShader::MAX_LIGHTS + 1];
+LightingShader::Program* LightingShader::current = NULL;
+bool LightingShader::loaded = false;
+bool LightingShader::available = false;
+bool LightingShader::enabled = true;
+int LightingShader::depth = 0;
+GLfloat LightingShader::lightBlock[(1 + 4 * LightingShader::MAX_LIGHTS) * 4] = { 0.0f };
+int LightingShader::lightCount = 0;
+
+#endif // LIGHTINGSHADER_H
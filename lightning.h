@@ -3,6 +3,8 @@
 #define LIGHTNING_H
 
 #include <GL/glut.h>
+#include "lightingshader.h"
+#include "renderstate.h"
 
 class Lightning {
 private:
@@ -14,10 +16,10 @@ public:
     void setup() {
         if (!enabled) return;
 
-        glEnable(GL_LIGHTING);
-        glEnable(GL_LIGHT0);
-        glEnable(GL_DEPTH_TEST);
-        glEnable(GL_COLOR_MATERIAL);
+        RenderState::enable(GL_LIGHTING);
+        RenderState::enable(GL_LIGHT0);
+        RenderState::enable(GL_DEPTH_TEST);
+        RenderState::enable(GL_COLOR_MATERIAL);
         glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
 
         // Aumentar la luz ambiental para ver mejor los colores
@@ -38,14 +40,22 @@ public:
         glMaterialfv(GL_FRONT_AND_BACK, GL_SHININESS, matShininess);
 
         glShadeModel(GL_SMOOTH);
-        glEnable(GL_NORMALIZE);
+        RenderState::enable(GL_NORMALIZE);
+
+        // Las mismas luces para el camino con shaders (GL_LIGHT0 no tiene luz ambiente propia)
+        GLfloat noAmbient[] = {0.0f, 0.0f, 0.0f, 1.0f};
+        LightingShader::setSceneAmbient(ambientLight);
+        LightingShader::setLight(0, lightPos, noAmbient, lightDiffuse, lightSpecular);
+        LightingShader::setLightCount(1);
+        LightingShader::load();
     }
 
     void cleanup() {
-        glDisable(GL_LIGHTING);
-        glDisable(GL_LIGHT0);
-        glDisable(GL_COLOR_MATERIAL);
-        glDisable(GL_NORMALIZE);
+        RenderState::disable(GL_LIGHTING);
+        RenderState::disable(GL_LIGHT0);
+        RenderState::disable(GL_COLOR_MATERIAL);
+        RenderState::disable(GL_NORMALIZE);
+        LightingShader::reset();
     }
 
     bool isEnabled() const { return enabled; }
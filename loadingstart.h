@@ -6,6 +6,7 @@
 #include <mmsystem.h>
 #include <iostream>
 #include <string>
+#include "renderstate.h"
 
 class LoadingStart {
 private:
@@ -89,7 +90,7 @@ private:
         
         GLuint textureID;
         glGenTextures(1, &textureID);
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        RenderState::bindTexture(textureID);
         
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_BGR_EXT, GL_UNSIGNED_BYTE, data);
         
@@ -155,15 +156,15 @@ public:
         textures[2] = textureInfos[2].id;
         
         // Habilitar blending para efectos fade
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        RenderState::enable(GL_BLEND);
+        RenderState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         
         // Reproducir primer sonido (se reproducir cuando termine el fade in)
         // playTransitionSound(); // Comentado para que no suene inmediatamente
     }
     
     ~LoadingStart() {
-        glDeleteTextures(3, textures);
+        RenderState::deleteTextures(3, textures);
     }
     
     void update() {
@@ -259,7 +260,7 @@ public:
         
         // Aplicar alpha solo para los slides (no para la barra de progreso)
         float slideAlpha = fadeAlpha * slideFadeAlpha;
-        glColor4f(1.0f, 1.0f, 1.0f, slideAlpha);
+        RenderState::color(1.0f, 1.0f, 1.0f, slideAlpha);
         
         // Obtener dimensiones actuales de la ventana
         int viewport[4];
@@ -269,8 +270,8 @@ public:
         
         // Renderizar slide actual
         if (currentSlide < 3 && textures[currentSlide] != 0) {
-            glBindTexture(GL_TEXTURE_2D, textures[currentSlide]);
-            glEnable(GL_TEXTURE_2D);
+            RenderState::bindTexture(textures[currentSlide]);
+            RenderState::enable(GL_TEXTURE_2D);
             
             // Obtener dimensiones originales de la imagen
             float imgWidth = (float)textureInfos[currentSlide].width;
@@ -300,14 +301,14 @@ public:
                 glTexCoord2f(0.0f, 0.0f); glVertex2f(x, y + displayHeight);
             glEnd();
             
-            glDisable(GL_TEXTURE_2D);
+            RenderState::disable(GL_TEXTURE_2D);
         }
         
         // Renderizar barra de progreso
         renderProgressBar();
         
         // Restaurar color
-        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+        RenderState::color(1.0f, 1.0f, 1.0f, 1.0f);
     }
     
     void renderProgressBar() {
@@ -327,7 +328,7 @@ public:
         float progressBarAlpha = fadeAlpha;
         
         // Fondo de la barra (gris oscuro) con alpha
-        glColor4f(0.2f, 0.2f, 0.2f, progressBarAlpha);
+        RenderState::color(0.2f, 0.2f, 0.2f, progressBarAlpha);
         glBegin(GL_QUADS);
             glVertex2f(barX - 1, barY - 1);
             glVertex2f(barX + barWidth + 1, barY - 1);
@@ -336,7 +337,7 @@ public:
         glEnd();
         
         // Barra de progreso (blanca) con alpha
-        glColor4f(1.0f, 1.0f, 1.0f, progressBarAlpha);
+        RenderState::color(1.0f, 1.0f, 1.0f, progressBarAlpha);
         glBegin(GL_QUADS);
             glVertex2f(barX, barY);
             glVertex2f(barX + barWidth * progressBar, barY);
@@ -5,6 +5,13 @@
 #include "loadingstart.h"
 #include "game.h"
 #include "options.h"
+#include "primitivecache.h"
+#include "levelofdetail.h"
+#include "lightingshader.h"
+#include "renderstate.h"
+#include "bitmapfont.h"
+#include "menufog.h"
+#include "textureatlas.h"
 
 bool loadingComplete = false;
 LoadingStart* loader;
@@ -43,6 +50,12 @@ void applyGlobalConfiguration() {
     globalConfig.fullscreen = currentFullscreen;
     globalConfig.volume = currentVolume;
     
+    // El nivel de detalle no necesita tocar la ventana
+    LevelOfDetail::setGlobalBias(globalOptionsMenu->getLodBias());
+    
+    // El filtrado anisotrpico tambin cambia en las texturas ya cargadas
+    TextureManager::setAnisotropy((float)globalOptionsMenu->getAnisotropy());
+    
     if (globalConfig.windowCreated && (resolutionChanged || fullscreenChanged)) {
         if (resolutionChanged) {
             glutReshapeWindow(globalConfig.windowWidth, globalConfig.windowHeight);
@@ -87,14 +100,20 @@ void loadInitialConfiguration() {
         globalConfig.fullscreen = currentFullscreen;
         globalConfig.volume = currentVolume;
         globalConfig.configLoaded = true;
+        
+        LevelOfDetail::setGlobalBias(globalOptionsMenu->getLodBias());
+        TextureManager::setAnisotropy((float)globalOptionsMenu->getAnisotropy());
     }
 }
 
 void display() {
+    RenderState::beginFrame();
+    BitmapFont::prepare(); // Solo el primer frame: usa el color buffer antes del glClear
     glClear(GL_COLOR_BUFFER_BIT);
     
     if (!loadingComplete) {
         loader->render();
+        MenuFog::upload(2); // Lo que ya gener el hilo de la niebla del men
         if (loader->isComplete()) {
             loadingComplete = true;
             delete loader;
@@ -195,6 +214,13 @@ void cleanup() {
         delete globalOptionsMenu;
         globalOptionsMenu = NULL;
     }
+    
+    // Mallas compartidas de esferas, cilindros y discos
+    PrimitiveCache::release();
+    LightingShader::release();
+    BitmapFont::release();
+    MenuFog::release();
+    PropAtlas::release();
 }
 
 void exitHandler() {
@@ -223,11 +249,12 @@ int main(int argc, char** argv) {
     }
     
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    RenderState::enable(GL_TEXTURE_2D);
+    RenderState::enable(GL_BLEND);
+    RenderState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     loader = new LoadingStart();
+    MenuFog::start(); // Generar la niebla del men mientras corre la presentacin
     game = NULL;
     
     glutDisplayFunc(display);
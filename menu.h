@@ -7,6 +7,9 @@
 #include <string>
 #include <vector>
 #include <cmath>
+#include "renderstate.h"
+#include "bitmapfont.h"
+#include "menufog.h"
 
 enum MenuAction {
     MENU_NONE,
@@ -50,48 +53,15 @@ private:
     // Para video de fondo
     int videoFrame;
     float videoTime;
-    GLuint videoTextures[60]; // 60 frames de video simulado
-    bool videoInitialized;
     
     void initializeColors() {
         // Colores para diferentes estados del men
     }
     
     void loadTexture() {
-        // Inicializar video de fondo simulado
-        if (!videoInitialized) {
-            glGenTextures(60, videoTextures);
-            
-            // Crear 60 frames de video simulado con efecto de niebla/partculas
-            for (int frame = 0; frame < 60; frame++) {
-                glBindTexture(GL_TEXTURE_2D, videoTextures[frame]);
-                
-                unsigned char textureData[256 * 256 * 3];
-                for (int i = 0; i < 256; i++) {
-                    for (int j = 0; j < 256; j++) {
-                        int index = (i * 256 + j) * 3;
-                        
-                        // Efecto de niebla animada
-                        float noise = sin((i + frame * 2) * 0.1f) * cos((j + frame * 3) * 0.08f);
-                        float fog = 0.1f + 0.05f * noise;
-                        
-                        // Colores oscuros con toques de azul/verde (estilo RE)
-                        textureData[index] = (unsigned char)(20 + fog * 30);     // R
-                        textureData[index + 1] = (unsigned char)(30 + fog * 40); // G
-                        textureData[index + 2] = (unsigned char)(50 + fog * 50); // B
-                    }
-                }
-                
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 256, 256, 0, GL_RGB, GL_UNSIGNED_BYTE, textureData);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            }
-            
-            videoInitialized = true;
-        }
-        
+        // Los cuadros de niebla normalmente ya se generaron durante la presentacin
+        MenuFog::start();
         textureLoaded = true;
-        std::cout << "Video background loaded (60 frames)" << std::endl;
     }
     
     void playSound(const char* soundName) {
@@ -114,27 +84,33 @@ private:
         
         // Actualizar frame del video
         videoTime += 0.016f; // ~60 FPS
-        videoFrame = (int)(videoTime * 30.0f) % 60; // 30 FPS
+        videoFrame = (int)(videoTime * 30.0f) % MenuFog::FRAMES; // 30 FPS
         
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, videoTextures[videoFrame]);
+        // Subir los cuadros que falten, de a pocos para no trabar el frame
+        MenuFog::upload(4);
+        GLuint videoTexture = MenuFog::getTexture(videoFrame);
         
-        glColor4f(1.0f, 1.0f, 1.0f, backgroundAlpha);
-        glBegin(GL_QUADS);
-            glTexCoord2f(0.0f, 0.0f);
-            glVertex2f(0.0f, 0.0f);
-            glTexCoord2f(1.0f, 0.0f);
-            glVertex2f(windowWidth, 0.0f);
-            glTexCoord2f(1.0f, 1.0f);
-            glVertex2f(windowWidth, windowHeight);
-            glTexCoord2f(0.0f, 1.0f);
-            glVertex2f(0.0f, windowHeight);
-        glEnd();
-        
-        glDisable(GL_TEXTURE_2D);
+        if (videoTexture != 0) {
+            RenderState::enable(GL_TEXTURE_2D);
+            RenderState::bindTexture(videoTexture);
+            
+            RenderState::color(1.0f, 1.0f, 1.0f, backgroundAlpha);
+            glBegin(GL_QUADS);
+                glTexCoord2f(0.0f, 0.0f);
+                glVertex2f(0.0f, 0.0f);
+                glTexCoord2f(1.0f, 0.0f);
+                glVertex2f(windowWidth, 0.0f);
+                glTexCoord2f(1.0f, 1.0f);
+                glVertex2f(windowWidth, windowHeight);
+                glTexCoord2f(0.0f, 1.0f);
+                glVertex2f(0.0f, windowHeight);
+            glEnd();
+            
+            RenderState::disable(GL_TEXTURE_2D);
+        }
         
         // Overlay oscuro para mejor legibilidad
-        glColor4f(0.0f, 0.0f, 0.0f, 0.6f * backgroundAlpha);
+        RenderState::color(0.0f, 0.0f, 0.0f, 0.6f * backgroundAlpha);
         glBegin(GL_QUADS);
             glVertex2f(0.0f, 0.0f);
             glVertex2f(windowWidth, 0.0f);
@@ -144,20 +120,12 @@ private:
     }
     
     int getTextWidth(const char* text, void* font) {
-        int width = 0;
-        for (const char* c = text; *c != '\0'; c++) {
-            width += glutBitmapWidth(font, *c);
-        }
-        return width;
+        return BitmapFont::getTextWidth(font, text);
     }
     
     void renderTextCentered(float x, float y, const char* text, void* font, float alpha = 1.0f) {
-        glColor4f(1.0f, 1.0f, 1.0f, alpha);
-        glRasterPos2f(x, y);
-        
-        for (const char* c = text; *c != '\0'; c++) {
-            glutBitmapCharacter(font, *c);
-        }
+        RenderState::color(1.0f, 1.0f, 1.0f, alpha);
+        BitmapFont::drawText(font, x, y, text);
     }
     
     void renderMenuItem(float x, float y, const MenuItem& item, int index) {
@@ -175,29 +143,17 @@ private:
             // Renderizar el texto mltiples veces con desplazamiento para crear efecto de brillo
             for (int offset = 1; offset <= 3; offset++) {
                 float glowAlpha = alpha * (0.3f / offset);
-                glColor4f(1.0f, 1.0f, 1.0f, glowAlpha);
+                RenderState::color(1.0f, 1.0f, 1.0f, glowAlpha);
                 
                 // Renderizar texto con offset en todas las direcciones
-                glRasterPos2f(x + offset, y);
-                for (const char* c = item.text.c_str(); *c != '\0'; c++) {
-                    glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-                }
-                glRasterPos2f(x - offset, y);
-                for (const char* c = item.text.c_str(); *c != '\0'; c++) {
-                    glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-                }
-                glRasterPos2f(x, y + offset);
-                for (const char* c = item.text.c_str(); *c != '\0'; c++) {
-                    glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-                }
-                glRasterPos2f(x, y - offset);
-                for (const char* c = item.text.c_str(); *c != '\0'; c++) {
-                    glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-                }
+                BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, x + offset, y, item.text.c_str());
+                BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, x - offset, y, item.text.c_str());
+                BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, x, y + offset, item.text.c_str());
+                BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, x, y - offset, item.text.c_str());
             }
             
             // Lnea subrayada debajo del texto (CORREGIDO: ahora est debajo)
-            glColor4f(1.0f, 1.0f, 1.0f, alpha * 0.9f);
+            RenderState::color(1.0f, 1.0f, 1.0f, alpha * 0.9f);
             glLineWidth(2.0f);
             glBegin(GL_LINES);
                 glVertex2f(x, y + 3.0f);  // Justo debajo del texto
@@ -207,11 +163,8 @@ private:
         }
         
         // Texto del item principal
-        glColor4f(1.0f, 1.0f, 1.0f, alpha);
-        glRasterPos2f(x, y);
-        for (const char* c = item.text.c_str(); *c != '\0'; c++) {
-            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-        }
+        RenderState::color(1.0f, 1.0f, 1.0f, alpha);
+        BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, x, y, item.text.c_str());
     }
     
     void transitionToMainMenu() {
@@ -247,7 +200,6 @@ public:
         // Inicializar video
         videoFrame = 0;
         videoTime = 0.0f;
-        videoInitialized = false;
         
         initializeColors();
         
@@ -268,9 +220,6 @@ public:
     }
     
     ~Menu() {
-        if (textureLoaded && videoInitialized) {
-            glDeleteTextures(60, videoTextures);
-        }
         std::cout << "Menu destruido" << std::endl;
     }
     
@@ -312,8 +261,8 @@ public:
     }
     
     void render() {
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        RenderState::enable(GL_BLEND);
+        RenderState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         
         // Renderizar background
         renderBackground();
@@ -335,11 +284,8 @@ public:
                     
                     // Efecto de brillo en el ttulo
                     float titleGlow = 0.8f + 0.2f * sin(animationTimer * 0.03f);
-                    glColor4f(0.95f * titleGlow, 0.95f * titleGlow, 0.9f * titleGlow, backgroundAlpha);
-                    glRasterPos2f(titleX, titleY);
-                    for (const char* c = title; *c != '\0'; c++) {
-                        glutBitmapCharacter(GLUT_BITMAP_TIMES_ROMAN_24, *c);
-                    }
+                    RenderState::color(0.95f * titleGlow, 0.95f * titleGlow, 0.9f * titleGlow, backgroundAlpha);
+                    BitmapFont::drawText(GLUT_BITMAP_TIMES_ROMAN_24, titleX, titleY, title);
                     
                     // Subttulo "resident evil" ms grande y centrado
                     const char* subtitle = "New Life";
@@ -348,11 +294,8 @@ public:
                     float subtitleX = (windowWidth - subtitleWidth) / 2.0f;
                     float subtitleY = titleY + 50.0f;
                     
-                    glColor4f(0.8f, 0.8f, 0.7f, backgroundAlpha);
-                    glRasterPos2f(subtitleX, subtitleY);
-                    for (const char* c = subtitle; *c != '\0'; c++) {
-                        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-                    }
+                    RenderState::color(0.8f, 0.8f, 0.7f, backgroundAlpha);
+                    BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, subtitleX, subtitleY, subtitle);
                     
                     // Mensaje inferior centrado (MEJORADO: ms grande, ms arriba, con iluminacin)
                     const char* pressKey = "Press any key to continue";
@@ -368,33 +311,18 @@ public:
                     // Efecto de iluminacin exterior (glow effect)
                     for (int offset = 1; offset <= 2; offset++) {
                         float glowAlpha = finalAlpha * (0.4f / offset);
-                        glColor4f(1.0f, 1.0f, 1.0f, glowAlpha);
+                        RenderState::color(1.0f, 1.0f, 1.0f, glowAlpha);
                         
                         // Renderizar texto con offset en todas las direcciones
-                        glRasterPos2f(pressKeyX + offset, pressKeyY);
-                        for (const char* c = pressKey; *c != '\0'; c++) {
-                            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-                        }
-                        glRasterPos2f(pressKeyX - offset, pressKeyY);
-                        for (const char* c = pressKey; *c != '\0'; c++) {
-                            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-                        }
-                        glRasterPos2f(pressKeyX, pressKeyY + offset);
-                        for (const char* c = pressKey; *c != '\0'; c++) {
-                            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-                        }
-                        glRasterPos2f(pressKeyX, pressKeyY - offset);
-                        for (const char* c = pressKey; *c != '\0'; c++) {
-                            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-                        }
+                        BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, pressKeyX + offset, pressKeyY, pressKey);
+                        BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, pressKeyX - offset, pressKeyY, pressKey);
+                        BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, pressKeyX, pressKeyY + offset, pressKey);
+                        BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, pressKeyX, pressKeyY - offset, pressKey);
                     }
                     
                     // Texto principal
-                    glColor4f(1.0f, 1.0f, 1.0f, finalAlpha);
-                    glRasterPos2f(pressKeyX, pressKeyY);
-                    for (const char* c = pressKey; *c != '\0'; c++) {
-                        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-                    }
+                    RenderState::color(1.0f, 1.0f, 1.0f, finalAlpha);
+                    BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, pressKeyX, pressKeyY, pressKey);
                 }
                 break;
                 
@@ -409,11 +337,8 @@ public:
                     
                     // Efecto de brillo en el ttulo
                     float titleGlow = 0.8f + 0.2f * sin(animationTimer * 0.03f);
-                    glColor4f(0.95f * titleGlow, 0.95f * titleGlow, 0.9f * titleGlow, backgroundAlpha);
-                    glRasterPos2f(titleX, titleY);
-                    for (const char* c = title; *c != '\0'; c++) {
-                        glutBitmapCharacter(GLUT_BITMAP_TIMES_ROMAN_24, *c);
-                    }
+                    RenderState::color(0.95f * titleGlow, 0.95f * titleGlow, 0.9f * titleGlow, backgroundAlpha);
+                    BitmapFont::drawText(GLUT_BITMAP_TIMES_ROMAN_24, titleX, titleY, title);
                     
                     // Subttulo "resident evil" centrado
                     const char* subtitle = "New Life";
@@ -422,11 +347,8 @@ public:
                     float subtitleX = (windowWidth - subtitleWidth) / 2.0f;
                     float subtitleY = titleY + 50.0f;
                     
-                    glColor4f(0.8f, 0.8f, 0.7f, backgroundAlpha);
-                    glRasterPos2f(subtitleX, subtitleY);
-                    for (const char* c = subtitle; *c != '\0'; c++) {
-                        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-                    }
+                    RenderState::color(0.8f, 0.8f, 0.7f, backgroundAlpha);
+                    BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, subtitleX, subtitleY, subtitle);
                     
                     // Items del men - posicionados verticalmente centrados
                     float startY = windowHeight / 2.0f - 30.0f;
@@ -448,16 +370,13 @@ public:
                     
                     float instrX = (windowWidth - instrWidth) / 2.0f;
                     
-                    glColor4f(0.8f, 0.8f, 0.8f, backgroundAlpha * 0.6f);
-                    glRasterPos2f(instrX, windowHeight - 80.0f);
-                    for (const char* c = instructions; *c != '\0'; c++) {
-                        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, *c);
-                    }
+                    RenderState::color(0.8f, 0.8f, 0.8f, backgroundAlpha * 0.6f);
+                    BitmapFont::drawText(GLUT_BITMAP_HELVETICA_12, instrX, windowHeight - 80.0f, instructions);
                 }
                 break;
         }
         
-        glDisable(GL_BLEND);
+        RenderState::disable(GL_BLEND);
     }
     
     MenuAction handleKeyboard(unsigned char key, int x, int y) {
@@ -0,0 +1,206 @@
+#ifndef MENUFOG_H
+#define MENUFOG_H
+
+#include <GL/glut.h>
+#include <windows.h>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "threadpool.h"
+#include "renderstate.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Los 60 cuadros de niebla del fondo del men. Se generan en un hilo aparte
+// (repartidos en un ThreadPool) mientras corre la presentacin de LoadingStart
+// y se suben a texturas de a pocos por frame desde el hilo de OpenGL.
+//
+// El ruido de cada texel es sin(fila) * cos(columna), as que alcanza con dos
+// tablas de senos y cosenos para todos los cuadros: cada cuadro es solo
+// multiplicar una fila por una columna, de a cuatro texels con SSE2.
+class MenuFog {
+public:
+    static const int FRAMES = 60;
+    static const int SIZE = 256;
+
+private:
+    static const int FRAME_BYTES = SIZE * SIZE * 3;
+    static const int ROW_STEP = 2;      // Desplazamiento por cuadro de cada eje
+    static const int COLUMN_STEP = 3;
+
+    // Reparte los cuadros entre los hilos del pool
+    class FrameTask : public ParallelTask {
+    public:
+        virtual void run(int begin, int end) {
+            for (int frame = begin; frame < end; frame++) {
+                generateFrame(frame);
+                InterlockedIncrement(&ready[frame]);
+            }
+        }
+    };
+
+    static float rowWave[SIZE + ROW_STEP * (FRAMES - 1)];
+    static float columnWave[SIZE + COLUMN_STEP * (FRAMES - 1)];
+    static std::vector<unsigned char> pixels;
+    static volatile LONG ready[FRAMES];
+    static bool uploaded[FRAMES];
+    static int uploadedCount;
+    static GLuint textures[FRAMES];
+    static bool texturesCreated;
+    static HANDLE thread;
+    static bool started;
+
+    // Una fila de texels: colores oscuros con toques de azul/verde (estilo RE)
+    static void generateRow(float row, const float* columns, unsigned char* out) {
+#ifdef __SSE2__
+        // SIZE es mltiplo de 4: no quedan texels sueltos al final de la fila
+        const __m128 vrow = _mm_set1_ps(row);
+        const __m128 base = _mm_set1_ps(0.1f);
+        const __m128 scale = _mm_set1_ps(0.05f);
+        int channels[12];
+        for (int j = 0; j < SIZE; j += 4) {
+            __m128 fog = _mm_add_ps(base, _mm_mul_ps(scale, _mm_mul_ps(vrow, _mm_loadu_ps(columns + j))));
+            __m128i r = _mm_cvttps_epi32(_mm_add_ps(_mm_set1_ps(20.0f), _mm_mul_ps(fog, _mm_set1_ps(30.0f))));
+            __m128i g = _mm_cvttps_epi32(_mm_add_ps(_mm_set1_ps(30.0f), _mm_mul_ps(fog, _mm_set1_ps(40.0f))));
+            __m128i b = _mm_cvttps_epi32(_mm_add_ps(_mm_set1_ps(50.0f), _mm_mul_ps(fog, _mm_set1_ps(50.0f))));
+            _mm_storeu_si128((__m128i*)channels, r);
+            _mm_storeu_si128((__m128i*)(channels + 4), g);
+            _mm_storeu_si128((__m128i*)(channels + 8), b);
+            for (int k = 0; k < 4; k++) {
+                out[(j + k) * 3] = (unsigned char)channels[k];
+                out[(j + k) * 3 + 1] = (unsigned char)channels[4 + k];
+                out[(j + k) * 3 + 2] = (unsigned char)channels[8 + k];
+            }
+        }
+#else
+        for (int j = 0; j < SIZE; j++) {
+            float fog = 0.1f + 0.05f * (row * columns[j]);
+            out[j * 3] = (unsigned char)(20 + fog * 30);     // R
+            out[j * 3 + 1] = (unsigned char)(30 + fog * 40); // G
+            out[j * 3 + 2] = (unsigned char)(50 + fog * 50); // B
+        }
+#endif
+    }
+
+    static void generateFrame(int frame) {
+        const float* rows = rowWave + frame * ROW_STEP;
+        const float* columns = columnWave + frame * COLUMN_STEP;
+        unsigned char* out = &pixels[frame * FRAME_BYTES];
+        for (int i = 0; i < SIZE; i++) {
+            generateRow(rows[i], columns, out + i * SIZE * 3);
+        }
+    }
+
+    static DWORD WINAPI threadMain(void*) {
+        // La fila i del cuadro f usa sin((i + 2f) * 0.1) y la columna j cos((j + 3f) * 0.08)
+        for (int k = 0; k < SIZE + ROW_STEP * (FRAMES - 1); k++) {
+            rowWave[k] = (float)sin(k * 0.1f);
+        }
+        for (int k = 0; k < SIZE + COLUMN_STEP * (FRAMES - 1); k++) {
+            columnWave[k] = (float)cos(k * 0.08f);
+        }
+
+        ThreadPool pool;
+        FrameTask task;
+        pool.parallelFor(FRAMES, 1, task);
+        return 0;
+    }
+
+    static void uploadFrame(int frame) {
+        RenderState::bindTexture(textures[frame]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, SIZE, SIZE, 0, GL_RGB, GL_UNSIGNED_BYTE,
+                     &pixels[frame * FRAME_BYTES]);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        uploaded[frame] = true;
+        uploadedCount++;
+    }
+
+public:
+    // Empezar a generar en segundo plano. Las siguientes llamadas no hacen nada.
+    static void start() {
+        if (started) return;
+        started = true;
+
+        pixels.resize(FRAMES * FRAME_BYTES);
+        thread = CreateThread(NULL, 0, threadMain, NULL, 0, NULL);
+        if (!thread) {
+            printf("Error: No se pudo crear el hilo de la niebla del menu\n");
+            threadMain(NULL);
+        }
+    }
+
+    // Subir a lo sumo 'maxFrames' cuadros ya generados. Necesita el contexto
+    // de OpenGL. Cuando estn todos se libera la memoria del hilo.
+    static void upload(int maxFrames) {
+        if (!started || uploadedCount == FRAMES) return;
+
+        if (!texturesCreated) {
+            glGenTextures(FRAMES, textures);
+            texturesCreated = true;
+        }
+
+        int count = 0;
+        for (int frame = 0; frame < FRAMES && count < maxFrames; frame++) {
+            if (uploaded[frame] || ready[frame] == 0) continue;
+            uploadFrame(frame);
+            count++;
+        }
+
+        if (uploadedCount == FRAMES) {
+            if (thread) {
+                WaitForSingleObject(thread, INFINITE);
+                CloseHandle(thread);
+                thread = NULL;
+            }
+            std::vector<unsigned char>().swap(pixels);
+            printf("Niebla del menu lista (%d cuadros)\n", FRAMES);
+        }
+    }
+
+    // Textura del cuadro pedido; si todava no se subi, la del ltimo que s.
+    // 0 si no hay ninguno.
+    static GLuint getTexture(int frame) {
+        for (int f = frame; f >= 0; f--) {
+            if (uploaded[f]) return textures[f];
+        }
+        for (int f = FRAMES - 1; f > frame; f--) {
+            if (uploaded[f]) return textures[f];
+        }
+        return 0;
+    }
+
+    static void release() {
+        if (thread) {
+            WaitForSingleObject(thread, INFINITE);
+            CloseHandle(thread);
+            thread = NULL;
+        }
+        if (texturesCreated) {
+            RenderState::deleteTextures(FRAMES, textures);
+            texturesCreated = false;
+        }
+        std::vector<unsigned char>().swap(pixels);
+        for (int f = 0; f < FRAMES; f++) {
+            ready[f] = 0;
+            uploaded[f] = false;
+        }
+        uploadedCount = 0;
+        started = false;
+    }
+};
+
+float MenuFog::rowWave[MenuFog::SIZE + MenuFog::ROW_STEP * (MenuFog::FRAMES - 1)];
+float MenuFog::columnWave[MenuFog::SIZE + MenuFog::COLUMN_STEP * (MenuFog::FRAMES - 1)];
+std::vector<unsigned char> MenuFog::pixels;
+volatile LONG MenuFog::ready[MenuFog::FRAMES];
+bool MenuFog::uploaded[MenuFog::FRAMES];
+int MenuFog::uploadedCount = 0;
+GLuint MenuFog::textures[MenuFog::FRAMES];
+bool MenuFog::texturesCreated = false;
+HANDLE MenuFog::thread = NULL;
+bool MenuFog::started = false;
+
+#endif // MENUFOG_H
@@ -0,0 +1,140 @@
+#ifndef MESHBUFFER_H
+#define MESHBUFFER_H
+
+#include <GL/glut.h>
+#include <vector>
+#include "glextensions.h"
+#include "meshbuilder.h"
+#include "renderstate.h"
+
+// Malla grabada con MeshBuilder que se sube una sola vez y se dibuja muchas
+// veces con distintas matrices (una por instancia). A diferencia de
+// StaticBatch no aplica materiales: textura, culling y brillo los pone quien
+// dibuja, y si se construye sin colores cada instancia usa el glColor actual.
+//
+//     malla.bind();
+//     for (...) { glPushMatrix(); ...; malla.draw(); glPopMatrix(); }
+//     malla.unbind();
+class MeshBuffer {
+private:
+    GLuint vertexBuffer;
+    GLuint indexBuffer;
+    int indexCount;
+    bool withColors;
+    bool useBuffers;
+    bool built;
+
+    // Copia en memoria si el driver no tiene vertex buffer objects
+    std::vector<MeshVertex> vertices;
+    std::vector<GLuint> indices;
+
+    // Sin copias: los buffers de OpenGL tienen un solo dueo
+    MeshBuffer(const MeshBuffer&);
+    MeshBuffer& operator=(const MeshBuffer&);
+
+public:
+    MeshBuffer() : vertexBuffer(0), indexBuffer(0), indexCount(0),
+                   withColors(true), useBuffers(false), built(false) {}
+
+    ~MeshBuffer() {
+        release();
+    }
+
+    bool isBuilt() const {
+        return built;
+    }
+
+    // Juntar todos los tringulos de 'mesh' en un solo buffer (las lneas se
+    // ignoran). Necesita el contexto de OpenGL activo.
+    void build(const MeshBuilder& mesh, bool useVertexColors) {
+        release();
+
+        GLExtensions::load();
+        useBuffers = GLExtensions::hasVertexBuffers();
+        withColors = useVertexColors;
+
+        const std::vector<MeshBucket>& buckets = mesh.getBuckets();
+        for (size_t i = 0; i < buckets.size(); i++) {
+            const MeshBucket& bucket = buckets[i];
+            if (bucket.material.primitive != GL_TRIANGLES) continue;
+
+            GLuint base = (GLuint)vertices.size();
+            vertices.insert(vertices.end(), bucket.vertices.begin(), bucket.vertices.end());
+            for (size_t k = 0; k < bucket.indices.size(); k++) {
+                indices.push_back(base + bucket.indices[k]);
+            }
+        }
+        indexCount = (int)indices.size();
+
+        if (useBuffers && indexCount > 0) {
+            GLExtensions::genBuffers(1, &vertexBuffer);
+            GLExtensions::bindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+            GLExtensions::bufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(MeshVertex),
+                                     &vertices[0], GL_STATIC_DRAW);
+            GLExtensions::bindBuffer(GL_ARRAY_BUFFER, 0);
+
+            GLExtensions::genBuffers(1, &indexBuffer);
+            GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+            GLExtensions::bufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint),
+                                     &indices[0], GL_STATIC_DRAW);
+            GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+            // Ya est en la placa de video
+            vertices.clear();
+            indices.clear();
+        }
+
+        built = true;
+    }
+
+    void release() {
+        if (vertexBuffer) GLExtensions::deleteBuffers(1, &vertexBuffer);
+        if (indexBuffer) GLExtensions::deleteBuffers(1, &indexBuffer);
+        vertexBuffer = 0;
+        indexBuffer = 0;
+        indexCount = 0;
+        vertices.clear();
+        indices.clear();
+        built = false;
+    }
+
+    // Dejar puestos los arrays para una tanda de draw()
+    void bind() const {
+        glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+        if (indexCount == 0) return;
+
+        if (useBuffers) {
+            GLExtensions::bindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+            GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+            MeshBuilder::setVertexArrays(NULL, true);
+        } else {
+            MeshBuilder::setVertexArrays(&vertices[0], true);
+        }
+        if (!withColors) {
+            glDisableClientState(GL_COLOR_ARRAY);
+        }
+    }
+
+    // Una instancia con la matriz y el estado actuales. Va entre bind() y unbind().
+    void draw() const {
+        if (indexCount == 0) return;
+        if (useBuffers) {
+            glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, NULL);
+        } else {
+            glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, &indices[0]);
+        }
+    }
+
+    void unbind() const {
+        if (useBuffers && indexCount > 0) {
+            GLExtensions::bindBuffer(GL_ARRAY_BUFFER, 0);
+            GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+        glPopClientAttrib();
+        if (withColors) {
+            RenderState::invalidateColor();
+        }
+    }
+};
+
+#endif // MESHBUFFER_H
@@ -0,0 +1,648 @@
+#ifndef MESHBUILDER_H
+#define MESHBUILDER_H
+
+#include <GL/glut.h>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "renderstate.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Vrtice final: posicin y normal ya transformadas por la matriz del builder
+struct MeshVertex {
+    float position[3];
+    float normal[3];
+    float color[4];
+    float texCoord[2];
+};
+
+// Estado de OpenGL con el que se dibuja un grupo de vrtices. Todo lo que
+// comparte material se dibuja con una sola llamada.
+struct MeshMaterial {
+    GLuint texture;     // 0 = sin textura
+    GLenum primitive;   // GL_TRIANGLES o GL_LINES
+    float lineWidth;    // Solo cuenta para GL_LINES
+    bool cullFace;
+    float shininess;
+
+    bool operator==(const MeshMaterial& other) const {
+        return texture == other.texture && primitive == other.primitive &&
+               lineWidth == other.lineWidth && cullFace == other.cullFace &&
+               shininess == other.shininess;
+    }
+
+    void apply() const {
+        if (texture != 0) {
+            RenderState::enable(GL_TEXTURE_2D);
+            RenderState::bindTexture(texture);
+        } else {
+            RenderState::disable(GL_TEXTURE_2D);
+        }
+        if (cullFace) {
+            RenderState::enable(GL_CULL_FACE);
+        } else {
+            RenderState::disable(GL_CULL_FACE);
+        }
+        if (primitive == GL_LINES) {
+            glLineWidth(lineWidth);
+        }
+        glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, shininess);
+    }
+};
+
+// Vrtices e ndices de un mismo material
+struct MeshBucket {
+    MeshMaterial material;
+    std::vector<MeshVertex> vertices;
+    std::vector<GLuint> indices;
+};
+
+// Parte de un objeto dentro de un bucket
+struct MeshRange {
+    int bucket;
+    int firstIndex;
+    int indexCount;
+};
+
+// Objeto registrado con beginObject()/endObject(): sus rangos y su caja
+struct MeshObject {
+    int firstRange;
+    int rangeCount;
+    float minX, minY, minZ;
+    float maxX, maxY, maxZ;
+};
+
+// Graba geometra con la misma interfaz que el modo inmediato de OpenGL
+// (begin/vertex/end, pila de matrices, color y normal actuales) pero en vez
+// de dibujarla la transforma en la CPU y la agrupa por material. As la
+// geometra esttica se puede hornear en coordenadas de mundo.
+class MeshBuilder {
+private:
+    struct Matrix {
+        float m[16]; // Column-major, como OpenGL
+    };
+
+    std::vector<Matrix> matrixStack;
+
+    // Estado actual, igual que en OpenGL se arrastra de una primitiva a la siguiente
+    float currentNormal[3];
+    float currentColor[4];
+    float currentTexCoord[2];
+    float textureRect[4];    // u0, v0, u1, v1: adnde cae el 0..1 de la textura enlazada
+    MeshMaterial currentMaterial;
+
+    // Primitiva entre begin() y end()
+    GLenum currentMode;
+    std::vector<MeshVertex> pending;
+
+    std::vector<MeshBucket> buckets;
+    std::vector<MeshRange> ranges;
+    std::vector<MeshObject> objects;
+
+    // Objeto abierto: cantidad de ndices de cada bucket al empezar
+    bool objectOpen;
+    std::vector<int> objectStart;
+    MeshObject openObject;
+
+    Matrix& top() {
+        return matrixStack.back();
+    }
+
+    // M = M * R, como glMultMatrix
+    void multiply(const float* r) {
+        float* m = top().m;
+        float result[16];
+        for (int col = 0; col < 4; col++) {
+            for (int row = 0; row < 4; row++) {
+                result[col * 4 + row] = m[row] * r[col * 4] +
+                                        m[4 + row] * r[col * 4 + 1] +
+                                        m[8 + row] * r[col * 4 + 2] +
+                                        m[12 + row] * r[col * 4 + 3];
+            }
+        }
+        for (int i = 0; i < 16; i++) m[i] = result[i];
+    }
+
+    void transformPoint(float x, float y, float z, float* out) {
+        const float* m = top().m;
+        out[0] = m[0] * x + m[4] * y + m[8] * z + m[12];
+        out[1] = m[1] * x + m[5] * y + m[9] * z + m[13];
+        out[2] = m[2] * x + m[6] * y + m[10] * z + m[14];
+    }
+
+    // Normal por la inversa transpuesta de la parte 3x3 (con escalas no
+    // uniformes no alcanza con la matriz), normalizada como con GL_NORMALIZE
+    void transformNormal(const float* n, float* out) {
+        const float* m = top().m;
+        float a00 = m[0], a01 = m[4], a02 = m[8];
+        float a10 = m[1], a11 = m[5], a12 = m[9];
+        float a20 = m[2], a21 = m[6], a22 = m[10];
+
+        float c00 = a11 * a22 - a12 * a21;
+        float c01 = a12 * a20 - a10 * a22;
+        float c02 = a10 * a21 - a11 * a20;
+        float c10 = a02 * a21 - a01 * a22;
+        float c11 = a00 * a22 - a02 * a20;
+        float c12 = a01 * a20 - a00 * a21;
+        float c20 = a01 * a12 - a02 * a11;
+        float c21 = a02 * a10 - a00 * a12;
+        float c22 = a00 * a11 - a01 * a10;
+        float det = a00 * c00 + a01 * c01 + a02 * c02;
+        float sign = det < 0.0f ? -1.0f : 1.0f;
+
+        out[0] = sign * (c00 * n[0] + c01 * n[1] + c02 * n[2]);
+        out[1] = sign * (c10 * n[0] + c11 * n[1] + c12 * n[2]);
+        out[2] = sign * (c20 * n[0] + c21 * n[1] + c22 * n[2]);
+
+        float length = sqrtf(out[0] * out[0] + out[1] * out[1] + out[2] * out[2]);
+        if (length > 0.0f) {
+            out[0] /= length;
+            out[1] /= length;
+            out[2] /= length;
+        }
+    }
+
+    int findBucket(const MeshMaterial& material) {
+        for (size_t i = 0; i < buckets.size(); i++) {
+            if (buckets[i].material == material) return (int)i;
+        }
+        MeshBucket bucket;
+        bucket.material = material;
+        buckets.push_back(bucket);
+        return (int)buckets.size() - 1;
+    }
+
+    void addIndex(MeshBucket& bucket, GLuint base, int i) {
+        bucket.indices.push_back(base + (GLuint)i);
+    }
+
+    // Pasar la primitiva grabada a tringulos (o lneas) sueltos
+    void flushPrimitive() {
+        int count = (int)pending.size();
+        if (count == 0) return;
+
+        bool lines = currentMode == GL_LINES || currentMode == GL_LINE_STRIP ||
+                     currentMode == GL_LINE_LOOP;
+        MeshMaterial material = currentMaterial;
+        if (lines) {
+            material.primitive = GL_LINES;
+            material.cullFace = false;
+        } else {
+            material.primitive = GL_TRIANGLES;
+            material.lineWidth = 1.0f;
+        }
+
+        MeshBucket& bucket = buckets[findBucket(material)];
+        GLuint base = (GLuint)bucket.vertices.size();
+        bucket.vertices.insert(bucket.vertices.end(), pending.begin(), pending.end());
+
+        switch (currentMode) {
+            case GL_TRIANGLES:
+                for (int i = 0; i + 2 < count; i += 3) {
+                    addIndex(bucket, base, i);
+                    addIndex(bucket, base, i + 1);
+                    addIndex(bucket, base, i + 2);
+                }
+                break;
+            case GL_QUADS:
+                for (int i = 0; i + 3 < count; i += 4) {
+                    addIndex(bucket, base, i);
+                    addIndex(bucket, base, i + 1);
+                    addIndex(bucket, base, i + 2);
+                    addIndex(bucket, base, i);
+                    addIndex(bucket, base, i + 2);
+                    addIndex(bucket, base, i + 3);
+                }
+                break;
+            case GL_QUAD_STRIP:
+                for (int i = 0; i + 3 < count; i += 2) {
+                    addIndex(bucket, base, i);
+                    addIndex(bucket, base, i + 1);
+                    addIndex(bucket, base, i + 3);
+                    addIndex(bucket, base, i);
+                    addIndex(bucket, base, i + 3);
+                    addIndex(bucket, base, i + 2);
+                }
+                break;
+            case GL_TRIANGLE_STRIP:
+                for (int i = 0; i + 2 < count; i++) {
+                    // Los impares se invierten para conservar el sentido
+                    addIndex(bucket, base, (i % 2 == 0) ? i : i + 1);
+                    addIndex(bucket, base, (i % 2 == 0) ? i + 1 : i);
+                    addIndex(bucket, base, i + 2);
+                }
+                break;
+            case GL_TRIANGLE_FAN:
+            case GL_POLYGON:
+                for (int i = 1; i + 1 < count; i++) {
+                    addIndex(bucket, base, 0);
+                    addIndex(bucket, base, i);
+                    addIndex(bucket, base, i + 1);
+                }
+                break;
+            case GL_LINES:
+                for (int i = 0; i + 1 < count; i += 2) {
+                    addIndex(bucket, base, i);
+                    addIndex(bucket, base, i + 1);
+                }
+                break;
+            case GL_LINE_STRIP:
+            case GL_LINE_LOOP:
+                for (int i = 0; i + 1 < count; i++) {
+                    addIndex(bucket, base, i);
+                    addIndex(bucket, base, i + 1);
+                }
+                if (currentMode == GL_LINE_LOOP && count > 2) {
+                    addIndex(bucket, base, count - 1);
+                    addIndex(bucket, base, 0);
+                }
+                break;
+        }
+        pending.clear();
+    }
+
+public:
+    MeshBuilder() : currentMode(GL_TRIANGLES), objectOpen(false) {
+        Matrix identity;
+        for (int i = 0; i < 16; i++) identity.m[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+        matrixStack.push_back(identity);
+
+        currentNormal[0] = 0.0f; currentNormal[1] = 0.0f; currentNormal[2] = 1.0f;
+        currentColor[0] = currentColor[1] = currentColor[2] = currentColor[3] = 1.0f;
+        currentTexCoord[0] = currentTexCoord[1] = 0.0f;
+        textureRect[0] = textureRect[1] = 0.0f;
+        textureRect[2] = textureRect[3] = 1.0f;
+
+        currentMaterial.texture = 0;
+        currentMaterial.primitive = GL_TRIANGLES;
+        currentMaterial.lineWidth = 1.0f;
+        currentMaterial.cullFace = true;
+        currentMaterial.shininess = 32.0f; // El de Lightning::setup()
+    }
+
+    // ---- Primitivas, como glBegin/glEnd ----
+
+    void begin(GLenum mode) {
+        currentMode = mode;
+        pending.clear();
+    }
+
+    void end() {
+        flushPrimitive();
+    }
+
+    void vertex(float x, float y, float z) {
+        MeshVertex v;
+        transformPoint(x, y, z, v.position);
+        transformNormal(currentNormal, v.normal);
+        for (int i = 0; i < 4; i++) v.color[i] = currentColor[i];
+        v.texCoord[0] = textureRect[0] + currentTexCoord[0] * (textureRect[2] - textureRect[0]);
+        v.texCoord[1] = textureRect[1] + currentTexCoord[1] * (textureRect[3] - textureRect[1]);
+        pending.push_back(v);
+
+        if (objectOpen) {
+            openObject.minX = fminf(openObject.minX, v.position[0]);
+            openObject.minY = fminf(openObject.minY, v.position[1]);
+            openObject.minZ = fminf(openObject.minZ, v.position[2]);
+            openObject.maxX = fmaxf(openObject.maxX, v.position[0]);
+            openObject.maxY = fmaxf(openObject.maxY, v.position[1]);
+            openObject.maxZ = fmaxf(openObject.maxZ, v.position[2]);
+        }
+    }
+
+    void normal(float x, float y, float z) {
+        currentNormal[0] = x;
+        currentNormal[1] = y;
+        currentNormal[2] = z;
+    }
+
+    void color(float r, float g, float b, float a = 1.0f) {
+        currentColor[0] = r;
+        currentColor[1] = g;
+        currentColor[2] = b;
+        currentColor[3] = a;
+    }
+
+    void texCoord(float u, float v) {
+        currentTexCoord[0] = u;
+        currentTexCoord[1] = v;
+    }
+
+    // ---- Matrices, como glPushMatrix/glTranslatef/... ----
+
+    void pushMatrix() {
+        matrixStack.push_back(matrixStack.back());
+    }
+
+    void popMatrix() {
+        if (matrixStack.size() > 1) {
+            matrixStack.pop_back();
+        }
+    }
+
+    void translate(float x, float y, float z) {
+        float* m = top().m;
+        for (int row = 0; row < 4; row++) {
+            m[12 + row] += m[row] * x + m[4 + row] * y + m[8 + row] * z;
+        }
+    }
+
+    void scale(float x, float y, float z) {
+        float* m = top().m;
+        for (int row = 0; row < 4; row++) {
+            m[row] *= x;
+            m[4 + row] *= y;
+            m[8 + row] *= z;
+        }
+    }
+
+    // Misma matriz que glRotatef (ngulo en grados)
+    void rotate(float angle, float x, float y, float z) {
+        float length = sqrtf(x * x + y * y + z * z);
+        if (length == 0.0f) return;
+        x /= length; y /= length; z /= length;
+
+        float radians = angle * (float)M_PI / 180.0f;
+        float c = cosf(radians);
+        float s = sinf(radians);
+        float t = 1.0f - c;
+
+        float r[16] = {
+            x * x * t + c,     y * x * t + z * s, x * z * t - y * s, 0.0f,
+            x * y * t - z * s, y * y * t + c,     y * z * t + x * s, 0.0f,
+            x * z * t + y * s, y * z * t - x * s, z * z * t + c,     0.0f,
+            0.0f,              0.0f,              0.0f,              1.0f
+        };
+        multiply(r);
+    }
+
+    // ---- Estado que separa materiales ----
+
+    // 0 = sin textura (como TextureManager::unbindTexture)
+    void bindTexture(GLuint texture) {
+        bindTexture(texture, 0.0f, 0.0f, 1.0f, 1.0f);
+    }
+
+    // Solo un rectngulo de la textura (una regin de un atlas): como con la
+    // matriz de textura, las coordenadas 0..1 de los vrtices que siguen se
+    // llevan a (u0, v0)-(u1, v1)
+    void bindTexture(GLuint texture, float u0, float v0, float u1, float v1) {
+        currentMaterial.texture = texture;
+        textureRect[0] = u0;
+        textureRect[1] = v0;
+        textureRect[2] = u1;
+        textureRect[3] = v1;
+    }
+
+    void lineWidth(float width) {
+        currentMaterial.lineWidth = width;
+    }
+
+    void cullFace(bool enabled) {
+        currentMaterial.cullFace = enabled;
+    }
+
+    void shininess(float value) {
+        currentMaterial.shininess = value;
+    }
+
+    // ---- Slidos de GLUT (misma teselacin que gluSphere/gluCylinder) ----
+
+    void solidSphere(float radius, int slices, int stacks) {
+        std::vector<float> sinA(slices + 1), cosA(slices + 1);
+        std::vector<float> sinB(stacks + 1), cosB(stacks + 1);
+        for (int i = 0; i < slices; i++) {
+            float angle = 2.0f * (float)M_PI * i / slices;
+            sinA[i] = sinf(angle);
+            cosA[i] = cosf(angle);
+        }
+        sinA[slices] = sinA[0];
+        cosA[slices] = cosA[0];
+        for (int j = 0; j <= stacks; j++) {
+            float angle = (float)M_PI * j / stacks;
+            sinB[j] = sinf(angle);
+            cosB[j] = cosf(angle);
+        }
+        sinB[0] = 0.0f;
+        sinB[stacks] = 0.0f;
+
+        // Polo superior en abanico
+        begin(GL_TRIANGLE_FAN);
+        normal(0.0f, 0.0f, 1.0f);
+        vertex(0.0f, 0.0f, radius);
+        for (int i = slices; i >= 0; i--) {
+            normal(sinA[i] * sinB[1], cosA[i] * sinB[1], cosB[1]);
+            vertex(radius * sinB[1] * sinA[i], radius * sinB[1] * cosA[i], radius * cosB[1]);
+        }
+        end();
+
+        // Polo inferior en abanico
+        begin(GL_TRIANGLE_FAN);
+        normal(0.0f, 0.0f, -1.0f);
+        vertex(0.0f, 0.0f, -radius);
+        for (int i = 0; i <= slices; i++) {
+            normal(sinA[i] * sinB[stacks - 1], cosA[i] * sinB[stacks - 1], cosB[stacks - 1]);
+            vertex(radius * sinB[stacks - 1] * sinA[i], radius * sinB[stacks - 1] * cosA[i],
+                   radius * cosB[stacks - 1]);
+        }
+        end();
+
+        // Bandas intermedias
+        for (int j = 1; j < stacks - 1; j++) {
+            begin(GL_QUAD_STRIP);
+            for (int i = 0; i <= slices; i++) {
+                normal(sinA[i] * sinB[j + 1], cosA[i] * sinB[j + 1], cosB[j + 1]);
+                vertex(radius * sinB[j + 1] * sinA[i], radius * sinB[j + 1] * cosA[i],
+                       radius * cosB[j + 1]);
+                normal(sinA[i] * sinB[j], cosA[i] * sinB[j], cosB[j]);
+                vertex(radius * sinB[j] * sinA[i], radius * sinB[j] * cosA[i], radius * cosB[j]);
+            }
+            end();
+        }
+    }
+
+    // Cilindro a lo largo de +Z sin tapas, con la misma teselacin que gluCylinder.
+    // Con topRadius = 0 es un cono.
+    void solidCylinder(float baseRadius, float topRadius, float height, int slices, int stacks) {
+        float deltaRadius = baseRadius - topRadius;
+        float length = sqrtf(deltaRadius * deltaRadius + height * height);
+        float zNormal = deltaRadius / length;
+        float xyNormal = height / length;
+
+        std::vector<float> sinA(slices + 1), cosA(slices + 1);
+        for (int i = 0; i < slices; i++) {
+            float angle = 2.0f * (float)M_PI * i / slices;
+            sinA[i] = sinf(angle);
+            cosA[i] = cosf(angle);
+        }
+        sinA[slices] = sinA[0];
+        cosA[slices] = cosA[0];
+
+        for (int j = 0; j < stacks; j++) {
+            float zLow = j * height / stacks;
+            float zHigh = (j + 1) * height / stacks;
+            float radiusLow = baseRadius - deltaRadius * ((float)j / stacks);
+            float radiusHigh = baseRadius - deltaRadius * ((float)(j + 1) / stacks);
+
+            begin(GL_QUAD_STRIP);
+            for (int i = 0; i <= slices; i++) {
+                normal(xyNormal * sinA[i], xyNormal * cosA[i], zNormal);
+                vertex(radiusLow * sinA[i], radiusLow * cosA[i], zLow);
+                vertex(radiusHigh * sinA[i], radiusHigh * cosA[i], zHigh);
+            }
+            end();
+        }
+    }
+
+    // Cono a lo largo de +Z, sin tapa en la base (como glutSolidCone)
+    void solidCone(float base, float height, int slices, int stacks) {
+        solidCylinder(base, 0.0f, height, slices, stacks);
+    }
+
+    // Disco en el plano Z = 0 mirando a +Z (como gluDisk)
+    void solidDisk(float innerRadius, float outerRadius, int slices, int loops) {
+        float deltaRadius = outerRadius - innerRadius;
+
+        std::vector<float> sinA(slices + 1), cosA(slices + 1);
+        for (int i = 0; i < slices; i++) {
+            float angle = 2.0f * (float)M_PI * i / slices;
+            sinA[i] = sinf(angle);
+            cosA[i] = cosf(angle);
+        }
+        sinA[slices] = sinA[0];
+        cosA[slices] = cosA[0];
+
+        normal(0.0f, 0.0f, 1.0f);
+
+        // Sin agujero el anillo de adentro es un abanico
+        int finish = loops;
+        if (innerRadius == 0.0f) {
+            finish = loops - 1;
+            float radius = outerRadius - deltaRadius * ((float)(loops - 1) / loops);
+            begin(GL_TRIANGLE_FAN);
+            vertex(0.0f, 0.0f, 0.0f);
+            for (int i = slices; i >= 0; i--) {
+                vertex(radius * sinA[i], radius * cosA[i], 0.0f);
+            }
+            end();
+        }
+
+        for (int j = 0; j < finish; j++) {
+            float radiusLow = outerRadius - deltaRadius * ((float)j / loops);
+            float radiusHigh = outerRadius - deltaRadius * ((float)(j + 1) / loops);
+            begin(GL_QUAD_STRIP);
+            for (int i = 0; i <= slices; i++) {
+                vertex(radiusLow * sinA[i], radiusLow * cosA[i], 0.0f);
+                vertex(radiusHigh * sinA[i], radiusHigh * cosA[i], 0.0f);
+            }
+            end();
+        }
+    }
+
+    void solidCube(float size) {
+        static const float normals[6][3] = {
+            {-1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f},
+            {0.0f, -1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f}
+        };
+        static const int faces[6][4] = {
+            {0, 1, 2, 3}, {3, 2, 6, 7}, {7, 6, 5, 4},
+            {4, 5, 1, 0}, {5, 6, 2, 1}, {7, 4, 0, 3}
+        };
+        float h = size / 2.0f;
+        float v[8][3];
+        for (int i = 0; i < 8; i++) {
+            v[i][0] = (i < 4) ? -h : h;
+            v[i][1] = (i % 4 < 2) ? -h : h;
+            v[i][2] = (i % 4 == 0 || i % 4 == 3) ? -h : h;
+        }
+
+        for (int f = 5; f >= 0; f--) {
+            begin(GL_QUADS);
+            normal(normals[f][0], normals[f][1], normals[f][2]);
+            for (int k = 0; k < 4; k++) {
+                const float* p = v[faces[f][k]];
+                vertex(p[0], p[1], p[2]);
+            }
+            end();
+        }
+    }
+
+    // ---- Objetos (rangos direccionables para culling) ----
+
+    int beginObject() {
+        objectStart.resize(buckets.size());
+        for (size_t i = 0; i < buckets.size(); i++) {
+            objectStart[i] = (int)buckets[i].indices.size();
+        }
+        openObject.firstRange = (int)ranges.size();
+        openObject.rangeCount = 0;
+        openObject.minX = openObject.minY = openObject.minZ = 1e30f;
+        openObject.maxX = openObject.maxY = openObject.maxZ = -1e30f;
+        objectOpen = true;
+        return (int)objects.size();
+    }
+
+    void endObject() {
+        if (!objectOpen) return;
+        for (size_t i = 0; i < buckets.size(); i++) {
+            int start = (i < objectStart.size()) ? objectStart[i] : 0;
+            int count = (int)buckets[i].indices.size() - start;
+            if (count > 0) {
+                MeshRange range;
+                range.bucket = (int)i;
+                range.firstIndex = start;
+                range.indexCount = count;
+                ranges.push_back(range);
+                openObject.rangeCount++;
+            }
+        }
+        objects.push_back(openObject);
+        objectOpen = false;
+    }
+
+    // ---- Resultado ----
+
+    const std::vector<MeshBucket>& getBuckets() const { return buckets; }
+    const std::vector<MeshRange>& getRanges() const { return ranges; }
+    const std::vector<MeshObject>& getObjects() const { return objects; }
+
+    // Apuntar los arrays de OpenGL a 'vertices' (o a un offset dentro del
+    // buffer enlazado si es NULL). Quien llama guarda el estado con
+    // glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT).
+    static void setVertexArrays(const MeshVertex* vertices, bool textured) {
+        const char* base = (const char*)vertices;
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(3, GL_FLOAT, sizeof(MeshVertex), base + offsetof(MeshVertex, position));
+        glNormalPointer(GL_FLOAT, sizeof(MeshVertex), base + offsetof(MeshVertex, normal));
+        glColorPointer(4, GL_FLOAT, sizeof(MeshVertex), base + offsetof(MeshVertex, color));
+        if (textured) {
+            glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+            glTexCoordPointer(2, GL_FLOAT, sizeof(MeshVertex), base + offsetof(MeshVertex, texCoord));
+        } else {
+            glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        }
+    }
+
+    // Dibujar todo desde memoria con vertex arrays (sirve para grabar una
+    // display list). Deja puesto el estado del ltimo material.
+    void draw() const {
+        glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+        for (size_t i = 0; i < buckets.size(); i++) {
+            const MeshBucket& bucket = buckets[i];
+            if (bucket.indices.empty()) continue;
+            bucket.material.apply();
+            setVertexArrays(&bucket.vertices[0], bucket.material.texture != 0);
+            glDrawElements(bucket.material.primitive, (GLsizei)bucket.indices.size(),
+                           GL_UNSIGNED_INT, &bucket.indices[0]);
+        }
+        glPopClientAttrib();
+        RenderState::invalidateColor();
+    }
+};
+
+#endif // MESHBUILDER_H
@@ -10,6 +10,9 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include "primitivecache.h"
+#include "renderstate.h"
+#include "bitmapfont.h"
 
 // Estructura para posiciones 3D
 struct Vector3 {
@@ -55,6 +58,7 @@ private:
     float distance2D(const Vector3& a, const Vector3& b);
     void generateRandomSpheres();
     void drawMissionPoint();
+    void drawGlowDisk(float y, float radius);
     void drawSphere(const Vector3& pos, float radius, float r, float g, float b);
     void drawText(const std::string& text, float x, float y);
     void drawCenteredText(const std::string& text, float y);
@@ -196,63 +200,47 @@ void MiniGame::generateRandomSpheres() {
     }
 }
 
+// Disco de 32 segmentos a la altura 'y' (un poco sobre el suelo)
+void MiniGame::drawGlowDisk(float y, float radius) {
+    glPushMatrix();
+    glTranslatef(0.0f, y, 0.0f);
+    PrimitiveCache::drawDisk(radius, 32);
+    glPopMatrix();
+}
+
 void MiniGame::drawMissionPoint() {
     glPushMatrix();
     glTranslatef(missionPoint.x, missionPoint.y, missionPoint.z);
     
     // Dibujar crculo en el suelo con efecto de brillo
-    glDisable(GL_LIGHTING);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    RenderState::disable(GL_LIGHTING);
+    RenderState::enable(GL_BLEND);
+    RenderState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     // Crculo exterior con brillo
     float outerGlow = 0.3f + glowIntensity * 0.4f;
-    glColor4f(1.0f, 0.2f, 0.2f, outerGlow);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex3f(0.0f, 0.01f, 0.0f);
-    for (int i = 0; i <= 32; i++) {
-        float angle = (float)i * 2.0f * 3.14159f / 32.0f;
-        float x = cos(angle) * missionRadius;
-        float z = sin(angle) * missionRadius;
-        glVertex3f(x, 0.01f, z);
-    }
-    glEnd();
+    RenderState::color(1.0f, 0.2f, 0.2f, outerGlow);
+    drawGlowDisk(0.01f, missionRadius);
     
     // Crculo interior ms brillante
     float innerGlow = 0.6f + glowIntensity * 0.4f;
-    glColor4f(1.0f, 0.4f, 0.4f, innerGlow);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex3f(0.0f, 0.02f, 0.0f);
-    for (int i = 0; i <= 32; i++) {
-        float angle = (float)i * 2.0f * 3.14159f / 32.0f;
-        float x = cos(angle) * (missionRadius * 0.6f);
-        float z = sin(angle) * (missionRadius * 0.6f);
-        glVertex3f(x, 0.02f, z);
-    }
-    glEnd();
+    RenderState::color(1.0f, 0.4f, 0.4f, innerGlow);
+    drawGlowDisk(0.02f, missionRadius * 0.6f);
     
     // Crculo central muy brillante
-    glColor4f(1.0f, 0.8f, 0.8f, 0.8f + glowIntensity * 0.2f);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex3f(0.0f, 0.03f, 0.0f);
-    for (int i = 0; i <= 32; i++) {
-        float angle = (float)i * 2.0f * 3.14159f / 32.0f;
-        float x = cos(angle) * (missionRadius * 0.3f);
-        float z = sin(angle) * (missionRadius * 0.3f);
-        glVertex3f(x, 0.03f, z);
-    }
-    glEnd();
+    RenderState::color(1.0f, 0.8f, 0.8f, 0.8f + glowIntensity * 0.2f);
+    drawGlowDisk(0.03f, missionRadius * 0.3f);
     
-    glDisable(GL_BLEND);
-    glEnable(GL_LIGHTING);
+    RenderState::disable(GL_BLEND);
+    RenderState::enable(GL_LIGHTING);
     glPopMatrix();
 }
 
 void MiniGame::drawSphere(const Vector3& pos, float radius, float r, float g, float b) {
     glPushMatrix();
     glTranslatef(pos.x, pos.y, pos.z);
-    glColor3f(r, g, b);
-    glutSolidSphere(radius, 16, 16);
+    RenderState::color(r, g, b);
+    PrimitiveCache::drawSphere(radius, 16, 16);
     glPopMatrix();
 }
 
@@ -266,15 +254,11 @@ void MiniGame::drawText(const std::string& text, float x, float y) {
     glPushMatrix();
     glLoadIdentity();
     
-    glDisable(GL_LIGHTING);
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glRasterPos2f(x, y);
-    
-    for (size_t i = 0; i < text.length(); i++) {
-        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, text[i]);
-    }
+    RenderState::disable(GL_LIGHTING);
+    RenderState::color(1.0f, 1.0f, 1.0f);
+    BitmapFont::drawText(GLUT_BITMAP_HELVETICA_18, x, y, text.c_str());
     
-    glEnable(GL_LIGHTING);
+    RenderState::enable(GL_LIGHTING);
     glPopMatrix();
     glMatrixMode(GL_PROJECTION);
     glPopMatrix();
@@ -291,23 +275,16 @@ void MiniGame::drawCenteredText(const std::string& text, float y) {
     glPushMatrix();
     glLoadIdentity();
     
-    glDisable(GL_LIGHTING);
-    glColor3f(1.0f, 1.0f, 0.0f); // Amarillo brillante
+    RenderState::disable(GL_LIGHTING);
+    RenderState::color(1.0f, 1.0f, 0.0f); // Amarillo brillante
     
     // Calcular posicin centrada
-    float textWidth = 0;
-    for (size_t i = 0; i < text.length(); i++) {
-        textWidth += glutBitmapWidth(GLUT_BITMAP_TIMES_ROMAN_24, text[i]);
-    }
+    float textWidth = (float)BitmapFont::getTextWidth(GLUT_BITMAP_TIMES_ROMAN_24, text.c_str());
     
     float centerX = (glutGet(GLUT_WINDOW_WIDTH) - textWidth) / 2.0f;
-    glRasterPos2f(centerX, y);
-    
-    for (size_t i = 0; i < text.length(); i++) {
-        glutBitmapCharacter(GLUT_BITMAP_TIMES_ROMAN_24, text[i]);
-    }
+    BitmapFont::drawText(GLUT_BITMAP_TIMES_ROMAN_24, centerX, y, text.c_str());
     
-    glEnable(GL_LIGHTING);
+    RenderState::enable(GL_LIGHTING);
     glPopMatrix();
     glMatrixMode(GL_PROJECTION);
     glPopMatrix();
@@ -4,6 +4,7 @@
 #include "car.h"
 #include <vector>
 #include <random>
+#include "renderstate.h"
 
 // Estructura para representar un carro individual
 struct CarInstance {
@@ -167,7 +168,7 @@ public:
     
     // Funcin para dibujar la ruta
     void drawPath() {
-        glColor3f(1.0f, 1.0f, 1.0f);
+        RenderState::color(1.0f, 1.0f, 1.0f);
         glLineWidth(2.0f);
         glBegin(GL_LINE_LOOP);
         glVertex3f(-baseSquareSize, -0.01f, -baseSquareSize);
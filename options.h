@@ -11,6 +11,8 @@
 #include <sstream>
 #include <cstdlib>  // Para atoi
 #include <cmath>    // Para sin()
+#include "renderstate.h"
+#include "bitmapfont.h"
 
 enum OptionsAction {
     OPTIONS_NONE,
@@ -61,10 +63,31 @@ private:
     int currentVolume;          // 0-100
     int currentResolutionIndex; // ndice en availableResolutions
     bool isFullscreen;
+    int currentLodBias;         // -1 (Low) a 2 (Ultra), ver LevelOfDetail
+    int currentAnisotropy;      // 1 (Off), 2, 4, 8 o 16, ver TextureManager
     
     // Archivo de configuracin
     std::string configFileName;
     
+    static const int MIN_LOD_BIAS = -1;
+    static const int MAX_LOD_BIAS = 2;
+    static const int MIN_ANISOTROPY = 1;
+    static const int MAX_ANISOTROPY = 16;
+    
+    static std::string lodBiasName(int bias) {
+        switch (bias) {
+            case -1: return "Low";
+            case 1:  return "High";
+            case 2:  return "Ultra";
+            default: return "Normal";
+        }
+    }
+    
+    static std::string anisotropyName(int level) {
+        if (level <= MIN_ANISOTROPY) return "Off";
+        return intToString(level) + "x";
+    }
+    
     void initializeResolutions() {
         availableResolutions.clear();
         availableResolutions.push_back(Resolution(800, 600, "800x600"));
@@ -93,6 +116,12 @@ private:
         // Fullscreen
         optionItems.push_back(OptionItem("Fullscreen", isFullscreen ? "ON" : "OFF"));
         
+        // Nivel de detalle de los objetos redondos
+        optionItems.push_back(OptionItem("Detail", lodBiasName(currentLodBias)));
+        
+        // Filtrado anisotrpico de las texturas
+        optionItems.push_back(OptionItem("Anisotropy", anisotropyName(currentAnisotropy)));
+        
         // Opciones de control
         optionItems.push_back(OptionItem("Apply Settings", ""));
         optionItems.push_back(OptionItem("Reset to Defaults", ""));
@@ -179,6 +208,19 @@ private:
             else if (key == "fullscreen") {
                 isFullscreen = (value == "true" || value == "1");
             }
+            else if (key == "lod_bias") {
+                currentLodBias = stringToInt(value);
+                if (currentLodBias < MIN_LOD_BIAS) currentLodBias = MIN_LOD_BIAS;
+                if (currentLodBias > MAX_LOD_BIAS) currentLodBias = MAX_LOD_BIAS;
+            }
+            else if (key == "anisotropy") {
+                // Solo potencias de 2 entre 1 y 16
+                int level = stringToInt(value);
+                currentAnisotropy = MIN_ANISOTROPY;
+                while (currentAnisotropy * 2 <= level && currentAnisotropy < MAX_ANISOTROPY) {
+                    currentAnisotropy *= 2;
+                }
+            }
         }
         
         file.close();
@@ -204,6 +246,8 @@ private:
         }
         
         file << "fullscreen=" << (isFullscreen ? "true" : "false") << "\n";
+        file << "lod_bias=" << currentLodBias << "\n";
+        file << "anisotropy=" << currentAnisotropy << "\n";
         
         file.close();
         std::cout << "Configuration saved successfully" << std::endl;
@@ -213,13 +257,15 @@ private:
         currentVolume = 50;
         currentResolutionIndex = 0; // 800x600
         isFullscreen = false;
+        currentLodBias = 0;
+        currentAnisotropy = MIN_ANISOTROPY;
         
         std::cout << "Default configuration applied" << std::endl;
     }
     
     // FUNCIN CORREGIDA: Solo actualiza valores sin reiniciar animaciones
     void updateOptionValues() {
-        if (optionItems.size() >= 3) {
+        if (optionItems.size() >= 5) {
             // Actualizar volumen
             optionItems[0].value = intToString(currentVolume) + "%";
             
@@ -230,24 +276,23 @@ private:
             
             // Actualizar fullscreen
             optionItems[2].value = isFullscreen ? "ON" : "OFF";
+            
+            // Actualizar nivel de detalle
+            optionItems[3].value = lodBiasName(currentLodBias);
+            
+            // Actualizar filtrado anisotrpico
+            optionItems[4].value = anisotropyName(currentAnisotropy);
         }
         // NO llamar a initializeOptions() aqu - esa era la causa del problema
     }
     
     int getTextWidth(const char* text, void* font) {
-        int width = 0;
-        for (const char* c = text; *c != '\0'; c++) {
-            width += glutBitmapWidth(font, *c);
-        }
-        return width;
+        return BitmapFont::getTextWidth(font, text);
     }
     
     void renderText(float x, float y, const char* text, void* font, float r, float g, float b, float alpha) {
-        glColor4f(r, g, b, alpha);
-        glRasterPos2f(x, y);
-        for (const char* c = text; *c != '\0'; c++) {
-            glutBitmapCharacter(font, *c);
-        }
+        RenderState::color(r, g, b, alpha);
+        BitmapFont::drawText(font, x, y, text);
     }
     
     void renderOptionItem(float x, float y, const OptionItem& item, int index) {
@@ -260,7 +305,7 @@ private:
                 int valueWidth = getTextWidth(item.value.c_str(), GLUT_BITMAP_HELVETICA_18);
                 int totalWidth = labelWidth + 20 + valueWidth;
                 
-                glColor4f(1.0f, 1.0f, 1.0f, alpha * 0.6f);
+                RenderState::color(1.0f, 1.0f, 1.0f, alpha * 0.6f);
                 glLineWidth(1.0f);
                 glBegin(GL_LINES);
                     glVertex2f(x, y + 3.0f);
@@ -268,7 +313,7 @@ private:
                 glEnd();
             } else {
                 int labelWidth = getTextWidth(item.label.c_str(), GLUT_BITMAP_HELVETICA_18);
-                glColor4f(1.0f, 1.0f, 1.0f, alpha * 0.6f);
+                RenderState::color(1.0f, 1.0f, 1.0f, alpha * 0.6f);
                 glLineWidth(1.0f);
                 glBegin(GL_LINES);
                     glVertex2f(x, y + 3.0f);
@@ -305,6 +350,8 @@ public:
         animationTimer = 0;
         animationCompleted = false;
         configFileName = "game_config.txt";
+        currentLodBias = 0;
+        currentAnisotropy = MIN_ANISOTROPY;
         
         initializeResolutions();
         loadConfiguration();
@@ -352,8 +399,8 @@ public:
     }
     
     void render() {
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        RenderState::enable(GL_BLEND);
+        RenderState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         
         int viewport[4];
         glGetIntegerv(GL_VIEWPORT, viewport);
@@ -361,7 +408,7 @@ public:
         float windowHeight = (float)viewport[3];
         
         // Fondo semi-transparente
-        glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
+        RenderState::color(0.0f, 0.0f, 0.0f, 0.7f);
         glBegin(GL_QUADS);
             glVertex2f(0.0f, 0.0f);
             glVertex2f(windowWidth, 0.0f);
@@ -378,7 +425,7 @@ public:
         renderText(titleX, titleY, title, GLUT_BITMAP_TIMES_ROMAN_24, 1.0f, 1.0f, 1.0f, 1.0f);
         
         // Lnea decorativa debajo del ttulo
-        glColor4f(1.0f, 1.0f, 1.0f, 0.5f);
+        RenderState::color(1.0f, 1.0f, 1.0f, 0.5f);
         glLineWidth(2.0f);
         glBegin(GL_LINES);
             glVertex2f(titleX, titleY + 10.0f);
@@ -387,8 +434,8 @@ public:
         glLineWidth(1.0f);
         
         // Opciones del men
-        float startY = windowHeight / 2.0f - 50.0f;
-        float itemSpacing = 45.0f;
+        float startY = windowHeight / 2.0f - 70.0f;
+        float itemSpacing = 40.0f;
         
         for (size_t i = 0; i < optionItems.size(); i++) {
             float itemY = startY + (float)i * itemSpacing;
@@ -404,7 +451,7 @@ public:
         
         renderText(instrX, windowHeight - 60.0f, instructions, GLUT_BITMAP_HELVETICA_12, 0.8f, 0.8f, 0.8f, 0.8f);
         
-        glDisable(GL_BLEND);
+        RenderState::disable(GL_BLEND);
     }
     
     OptionsAction handleKeyboard(unsigned char key, int x, int y) {
@@ -448,6 +495,14 @@ public:
                     isFullscreen = !isFullscreen;
                     updateOptionValues(); // Solo actualiza valores, no reinicia animaciones
                 }
+                else if (selectedIndex == 3) { // Nivel de detalle
+                    if (currentLodBias > MIN_LOD_BIAS) currentLodBias--;
+                    updateOptionValues();
+                }
+                else if (selectedIndex == 4) { // Filtrado anisotrpico
+                    if (currentAnisotropy > MIN_ANISOTROPY) currentAnisotropy /= 2;
+                    updateOptionValues();
+                }
                 break;
                 
             case 'd':
@@ -467,22 +522,30 @@ public:
                     isFullscreen = !isFullscreen;
                     updateOptionValues(); // Solo actualiza valores, no reinicia animaciones
                 }
+                else if (selectedIndex == 3) { // Nivel de detalle
+                    if (currentLodBias < MAX_LOD_BIAS) currentLodBias++;
+                    updateOptionValues();
+                }
+                else if (selectedIndex == 4) { // Filtrado anisotrpico
+                    if (currentAnisotropy < MAX_ANISOTROPY) currentAnisotropy *= 2;
+                    updateOptionValues();
+                }
                 break;
                 
             case 13: // ENTER
                 std::cout << "DEBUG: ENTER pressed on option " << selectedIndex << std::endl;
-                if (selectedIndex == 3) { // Apply Settings
+                if (selectedIndex == 5) { // Apply Settings
                     saveConfiguration();
                     std::cout << "Settings saved! Main will apply them." << std::endl;
                     return OPTIONS_APPLY;
                 }
-                else if (selectedIndex == 4) { // Reset to Defaults
+                else if (selectedIndex == 6) { // Reset to Defaults
                     setDefaults();
                     updateOptionValues(); // Solo actualiza valores, no reinicia animaciones
                     std::cout << "Settings reset to defaults" << std::endl;
                     return OPTIONS_RESET_DEFAULTS;
                 }
-                else if (selectedIndex == 5) { // Back to Menu
+                else if (selectedIndex == 7) { // Back to Menu
                     return OPTIONS_BACK;
                 }
                 break;
@@ -502,6 +565,8 @@ public:
     // Mtodos para obtener configuracin actual
     int getCurrentVolume() const { return currentVolume; }
     bool getIsFullscreen() const { return isFullscreen; }
+    int getLodBias() const { return currentLodBias; }
+    int getAnisotropy() const { return currentAnisotropy; }
     Resolution getCurrentResolution() const {
         if (currentResolutionIndex >= 0 && currentResolutionIndex < (int)availableResolutions.size()) {
             return availableResolutions[currentResolutionIndex];
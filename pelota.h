@@ -7,15 +7,21 @@
 #include <cmath>
 #include <iostream>
 #include "texture.h"
+#include "textureatlas.h"
+#include "primitivecache.h"
+#include "levelofdetail.h"
+#include "renderstate.h"
+#include "renderqueue.h"
 
 // Pelota Class with texture support
-class Pelota {
+class Pelota : public Drawable {
 private:
-    GLuint textureID;
+    AtlasRegion texture;   // Its rectangle in the prop atlas, or a texture of its own
     float radius;
     int slices;
     int stacks;
     bool textureLoaded;
+    LevelOfDetail lod; // Baja slices/stacks cuando la pelota se ve chica
     
     // Default color (celeste)
     float defaultR, defaultG, defaultB;
@@ -35,7 +41,7 @@ private:
 
     // Reset OpenGL state to neutral
     void resetGLState() {
-        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+        RenderState::color(1.0f, 1.0f, 1.0f, 1.0f);
         
         GLfloat white[4] = {1.0f, 1.0f, 1.0f, 1.0f};
         GLfloat black[4] = {0.0f, 0.0f, 0.0f, 1.0f};
@@ -48,78 +54,58 @@ private:
         glMaterialfv(GL_FRONT_AND_BACK, GL_SHININESS, defaultShininess);
     }
 
+    // Teselacin segn el tamao en pantalla (la matriz actual ya tiene la escala)
+    void selectDetail(float sphereRadius, int& lodSlices, int& lodStacks) {
+        ScreenProjection screen;
+        int level = lod.select(screen.pixelRadius(0.0f, 0.0f, 0.0f, sphereRadius));
+        lodSlices = LevelOfDetail::scaleDetail(slices, level, 8);
+        lodStacks = LevelOfDetail::scaleDetail(stacks, level, 6);
+    }
+
     // Draw textured sphere manually for better texture mapping
     void drawTexturedSphere() {
-        for (int i = 0; i < stacks; i++) {
-            float phi1 = static_cast<float>(M_PI) * i / stacks;
-            float phi2 = static_cast<float>(M_PI) * (i + 1) / stacks;
-            
-            glBegin(GL_QUAD_STRIP);
-            for (int j = 0; j <= slices; j++) {
-                float theta = 2.0f * static_cast<float>(M_PI) * j / slices;
-                
-                // First vertex
-                float x1 = radius * sin(phi1) * cos(theta);
-                float y1 = radius * cos(phi1);
-                float z1 = radius * sin(phi1) * sin(theta);
-                
-                // Second vertex
-                float x2 = radius * sin(phi2) * cos(theta);
-                float y2 = radius * cos(phi2);
-                float z2 = radius * sin(phi2) * sin(theta);
-                
-                // Texture coordinates
-                float u = static_cast<float>(j) / slices;
-                float v1 = static_cast<float>(i) / stacks;
-                float v2 = static_cast<float>(i + 1) / stacks;
-                
-                // First vertex with normal and texture
-                glNormal3f(x1/radius, y1/radius, z1/radius);
-                glTexCoord2f(u, v1);
-                glVertex3f(x1, y1, z1);
-                
-                // Second vertex with normal and texture
-                glNormal3f(x2/radius, y2/radius, z2/radius);
-                glTexCoord2f(u, v2);
-                glVertex3f(x2, y2, z2);
-            }
-            glEnd();
-        }
+        int lodSlices, lodStacks;
+        selectDetail(radius, lodSlices, lodStacks);
+        PrimitiveCache::drawTexturedSphere(radius, lodSlices, lodStacks);
+    }
+
+    void drawSphere(float sphereRadius) {
+        int lodSlices, lodStacks;
+        selectDetail(sphereRadius, lodSlices, lodStacks);
+        PrimitiveCache::drawSphere(sphereRadius, lodSlices, lodStacks);
     }
 
 public:
     // Constructor with automatic texture loading
-    Pelota() : textureID(0), radius(1.0f), slices(50), stacks(50), textureLoaded(false),
+    Pelota() : radius(1.0f), slices(50), stacks(50), textureLoaded(false),
                defaultR(0.3f), defaultG(0.5f), defaultB(0.8f) {
         loadTexture("pelotatexture.bmp");
     }
 
     // Constructor with custom texture path
-    Pelota(const char* texturePath) : textureID(0), radius(1.0f), slices(50), stacks(50), textureLoaded(false),
+    Pelota(const char* texturePath) : radius(1.0f), slices(50), stacks(50), textureLoaded(false),
                                       defaultR(0.3f), defaultG(0.5f), defaultB(0.8f) {
         loadTexture(texturePath);
     }
 
     // Constructor with custom radius
-    Pelota(float r) : textureID(0), radius(r), slices(50), stacks(50), textureLoaded(false),
+    Pelota(float r) : radius(r), slices(50), stacks(50), textureLoaded(false),
                       defaultR(0.3f), defaultG(0.5f), defaultB(0.8f) {
         loadTexture("pelotatexture.bmp");
     }
 
     // Constructor with custom radius and texture
-    Pelota(float r, const char* texturePath) : textureID(0), radius(r), slices(50), stacks(50), textureLoaded(false),
+    Pelota(float r, const char* texturePath) : radius(r), slices(50), stacks(50), textureLoaded(false),
                                                defaultR(0.3f), defaultG(0.5f), defaultB(0.8f) {
         loadTexture(texturePath);
     }
 
     // Load texture method
     void loadTexture(const char* texturePath) {
-        if (textureID != 0) {
-            TextureManager::deleteTexture(textureID);
-        }
+        PropAtlas::unload(texture);
         
-        textureID = TextureManager::loadTexture(texturePath);
-        textureLoaded = (textureID != 0);
+        texture = PropAtlas::load(texturePath);
+        textureLoaded = (texture.texture != 0);
         
         if (!textureLoaded) {
             std::cerr << "Failed to load pelota texture: " << texturePath << std::endl;
@@ -137,6 +123,11 @@ public:
         return textureLoaded;
     }
 
+    // Texture used by render(), 0 if none (sort key for the render queue)
+    GLuint getTextureID() const {
+        return textureLoaded ? texture.texture : 0;
+    }
+
     // Set default color
     void setDefaultColor(float r, float g, float b) {
         defaultR = r;
@@ -160,66 +151,77 @@ public:
         return radius;
     }
 
+    // Sesgo propio del nivel de detalle (positivo = ms detalle)
+    void setDetailBias(int bias) {
+        lod.setBias(bias);
+    }
+
     // Render pelota with texture (if available) or default color
     void render() {
-        glPushAttrib(GL_ALL_ATTRIB_BITS);
+        RenderState::pushAttrib(GL_ALL_ATTRIB_BITS);
         glPushMatrix();
         
-        glEnable(GL_NORMALIZE);
+        RenderState::enable(GL_NORMALIZE);
         resetGLState();
 
         if (textureLoaded) {
             // Render with texture
-            TextureManager::bindTexture(textureID);
-            glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+            texture.bind();
+            RenderState::color(1.0f, 1.0f, 1.0f, 1.0f);
             setMaterial(1.0f, 1.0f, 1.0f, 0.3f, 0.3f, 0.3f, 80.0f);
             drawTexturedSphere();
+            texture.unbind();
         } else {
             // Render with default color
             TextureManager::unbindTexture();
             setMaterial(defaultR, defaultG, defaultB, 1.0f, 1.0f, 1.0f, 80.0f);
-            glutSolidSphere(radius, slices, stacks);
+            drawSphere(radius);
         }
 
         glPopMatrix();
-        glPopAttrib();
+        RenderState::popAttrib();
+    }
+
+    // Render queue entry point: the whole object is a single part
+    virtual void drawPart(int part) {
+        render();
     }
 
     // Render pelota with custom color (ignores texture)
     void renderWithColor(float r, float g, float b) {
-        glPushAttrib(GL_ALL_ATTRIB_BITS);
+        RenderState::pushAttrib(GL_ALL_ATTRIB_BITS);
         glPushMatrix();
         
-        glEnable(GL_NORMALIZE);
+        RenderState::enable(GL_NORMALIZE);
         resetGLState();
         TextureManager::unbindTexture();
         
         setMaterial(r, g, b, 1.0f, 1.0f, 1.0f, 80.0f);
-        glutSolidSphere(radius, slices, stacks);
+        drawSphere(radius);
 
         glPopMatrix();
-        glPopAttrib();
+        RenderState::popAttrib();
     }
 
     // Render pelota with custom radius and color
     void renderCustom(float customRadius, float r, float g, float b) {
-        glPushAttrib(GL_ALL_ATTRIB_BITS);
+        RenderState::pushAttrib(GL_ALL_ATTRIB_BITS);
         glPushMatrix();
         
-        glEnable(GL_NORMALIZE);
+        RenderState::enable(GL_NORMALIZE);
         resetGLState();
         TextureManager::unbindTexture();
         
         setMaterial(r, g, b, 1.0f, 1.0f, 1.0f, 80.0f);
-        glutSolidSphere(customRadius, slices, stacks);
+        drawSphere(customRadius);
 
         glPopMatrix();
-        glPopAttrib();
+        RenderState::popAttrib();
     }
 
     // Destructor to clean up OpenGL resources
     ~Pelota() {
-        TextureManager::deleteTexture(textureID);
+        PropAtlas::unload(texture);
     }
 };
 
@@ -238,36 +240,36 @@ namespace PelotaLegacy {
     // Funcin principal para dibujar la pelota (color celeste por defecto)
     void DrawPelota() {
         glPushMatrix();
-        glEnable(GL_NORMALIZE);
+        RenderState::enable(GL_NORMALIZE);
         setPelotaMaterial(0.3f, 0.5f, 0.8f);
-        glutSolidSphere(1.0, 50, 50);
+        PrimitiveCache::drawSphere(1.0f, 50, 50);
         glPopMatrix();
     }
 
     // Pelota con radio personalizado (color celeste)
     void DrawPelotaCustom(float radio) {
         glPushMatrix();
-        glEnable(GL_NORMALIZE);
+        RenderState::enable(GL_NORMALIZE);
         setPelotaMaterial(0.3f, 0.5f, 0.8f);
-        glutSolidSphere(radio, 50, 50);
+        PrimitiveCache::drawSphere(radio, 50, 50);
         glPopMatrix();
     }
 
     // Pelota con color personalizado
     void DrawPelotaColor(float r, float g, float b) {
         glPushMatrix();
-        glEnable(GL_NORMALIZE);
+        RenderState::enable(GL_NORMALIZE);
         setPelotaMaterial(r, g, b);
-        glutSolidSphere(1.0, 50, 50);
+        PrimitiveCache::drawSphere(1.0f, 50, 50);
         glPopMatrix();
     }
 
     // Pelota con color y radio personalizados
     void DrawPelotaCompleta(float radio, float r, float g, float b) {
         glPushMatrix();
-        glEnable(GL_NORMALIZE);
+        RenderState::enable(GL_NORMALIZE);
         setPelotaMaterial(r, g, b);
-        glutSolidSphere(radio, 50, 50);
+        PrimitiveCache::drawSphere(radio, 50, 50);
         glPopMatrix();
     }
 }
@@ -8,13 +8,18 @@
 #include <GL/glu.h>
 #include <GL/glut.h>
 #include "texture.h"
+#include "textureatlas.h"
+#include "primitivecache.h"
+#include "watermesh.h"
+#include "renderstate.h"
+#include "renderqueue.h"
 
 // Define M_PI if not already defined
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-class Pileta {
+class Pileta : public Drawable {
 private:
     float tiempoAgua;
     clock_t tiempoInicio;
@@ -22,7 +27,7 @@ private:
     
     // IDs de texturas
     GLuint texturaAzulejos;
-    GLuint texturaLadrillos;
+    AtlasRegion texturaLadrillos;   // En el atlas de los objetos; las otras dos se repiten
     GLuint texturaPiso;
     bool texturasInicializadas;
     
@@ -30,11 +35,16 @@ private:
     float velocidadAnimacion;
     float amplitudOndas;
     
+    // Superficie del agua: la malla se arma una vez y solo se recalculan las ondas
+    static const int ANILLOS_AGUA = 40;
+    static const int SEGMENTOS_AGUA = 72;
+    WaterMesh agua;
+    
     void inicializarTexturas() {
         if (!texturasInicializadas) {
             // Cargar texturas si existen los archivos (silenciosamente)
             texturaAzulejos = TextureManager::loadTexture("azulejos.bmp");
-            texturaLadrillos = TextureManager::loadTexture("ladrillos.bmp");
+            texturaLadrillos = PropAtlas::load("ladrillos.bmp");
             texturaPiso = TextureManager::loadTexture("piso.bmp");
             texturasInicializadas = true;
         }
@@ -52,46 +62,7 @@ private:
     }
     
     void dibujarCilindro(float radio, float altura, int segmentos) {
-        float angulo = 2.0f * M_PI / segmentos;
-        
-        // Tapa superior
-        glBegin(GL_TRIANGLE_FAN);
-        glNormal3f(0.0f, 1.0f, 0.0f);
-        glTexCoord2f(0.5f, 0.5f);
-        glVertex3f(0.0f, altura/2, 0.0f);
-        for(int i = 0; i <= segmentos; i++) {
-            float x = radio * cos(i * angulo);
-            float z = radio * sin(i * angulo);
-            glTexCoord2f(0.5f + 0.5f * cos(i * angulo), 0.5f + 0.5f * sin(i * angulo));
-            glVertex3f(x, altura/2, z);
-        }
-        glEnd();
-        
-        // Tapa inferior
-        glBegin(GL_TRIANGLE_FAN);
-        glNormal3f(0.0f, -1.0f, 0.0f);
-        glTexCoord2f(0.5f, 0.5f);
-        glVertex3f(0.0f, -altura/2, 0.0f);
-        for(int i = segmentos; i >= 0; i--) {
-            float x = radio * cos(i * angulo);
-            float z = radio * sin(i * angulo);
-            glTexCoord2f(0.5f + 0.5f * cos(i * angulo), 0.5f + 0.5f * sin(i * angulo));
-            glVertex3f(x, -altura/2, z);
-        }
-        glEnd();
-        
-        // Lados
-        glBegin(GL_QUAD_STRIP);
-        for(int i = 0; i <= segmentos; i++) {
-            float x = radio * cos(i * angulo);
-            float z = radio * sin(i * angulo);
-            glNormal3f(x/radio, 0.0f, z/radio);
-            glTexCoord2f((float)i/segmentos, 1.0f);
-            glVertex3f(x, altura/2, z);
-            glTexCoord2f((float)i/segmentos, 0.0f);
-            glVertex3f(x, -altura/2, z);
-        }
-        glEnd();
+        PrimitiveCache::drawCylinder(radio, altura, segmentos);
     }
     
     void dibujarAguaAnimada() {
@@ -99,53 +70,20 @@ private:
         actualizarTiempoAutomatico();
         
         // Habilitar transparencia
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        RenderState::enable(GL_BLEND);
+        RenderState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         
-        int resolucion = 30;
         float radioAgua = 1.9f;
         
         // Agua principal con ondas automticas
-        for(int i = 0; i < resolucion-1; i++) {
-            glBegin(GL_TRIANGLE_STRIP);
-            for(int j = 0; j <= resolucion; j++) {
-                for(int k = 0; k < 2; k++) {
-                    float angulo = 2.0f * M_PI * j / resolucion;
-                    float radio = radioAgua * (i + k) / (resolucion-1);
-                    
-                    float x = radio * cos(angulo);
-                    float z = radio * sin(angulo);
-                    
-                    // Ondas automticas con mltiples frecuencias
-                    float onda1 = amplitudOndas * sin(tiempoAgua * 2.5f + radio * 6.0f);
-                    float onda2 = amplitudOndas * 0.6f * sin(tiempoAgua * 1.8f + angulo * 3.0f);
-                    float onda3 = amplitudOndas * 0.5f * sin(tiempoAgua * 3.2f + x * 4.0f + z * 4.0f);
-                    float onda4 = amplitudOndas * 0.3f * sin(tiempoAgua * 4.1f + radio * 2.0f);
-                    float y = onda1 + onda2 + onda3 + onda4;
-                    
-                    // Color dinmico del agua
-                    float profundidad = 1.0f - radio / radioAgua;
-                    float brillo = 0.5f + 0.3f * sin(tiempoAgua * 1.5f + radio * 3.0f);
-                    glColor4f(0.05f + 0.15f * profundidad * brillo, 
-                             0.25f + 0.35f * profundidad * brillo, 
-                             0.7f + 0.2f * profundidad * brillo, 
-                             0.65f + 0.25f * profundidad);
-                    
-                    // Normal dinmica para iluminacin
-                    float dx = 0.4f * cos(tiempoAgua * 2.5f + radio * 6.0f) * cos(angulo);
-                    float dz = 0.4f * cos(tiempoAgua * 2.5f + radio * 6.0f) * sin(angulo);
-                    glNormal3f(-dx, 1.0f, -dz);
-                    
-                    glTexCoord2f(x * 0.5f + 0.5f + 0.1f * sin(tiempoAgua + radio), 
-                                z * 0.5f + 0.5f + 0.1f * cos(tiempoAgua + angulo));
-                    glVertex3f(x, y, z);
-                }
-            }
-            glEnd();
+        if (!agua.isBuilt()) {
+            agua.build(ANILLOS_AGUA, SEGMENTOS_AGUA, radioAgua);
         }
+        agua.update(tiempoAgua, amplitudOndas);
+        agua.draw();
         
         // Reflejos automticos brillantes
-        glColor4f(1.0f, 1.0f, 1.0f, 0.4f);
+        RenderState::color(1.0f, 1.0f, 1.0f, 0.4f);
         for(int i = 0; i < 8; i++) {
             float anguloReflejo = tiempoAgua * 1.3f + i * M_PI * 0.25f;
             float radioReflejo = 0.2f + 0.6f * sin(tiempoAgua * 0.8f + i * 0.7f);
@@ -172,14 +110,14 @@ private:
         }
         
         // Ondas concntricas adicionales
-        glColor4f(0.8f, 0.9f, 1.0f, 0.2f);
+        RenderState::color(0.8f, 0.9f, 1.0f, 0.2f);
         for(int i = 0; i < 3; i++) {
             float radioOnda = 0.5f + (tiempoAgua * 0.3f + i * 0.8f);
             radioOnda = fmod(radioOnda, 2.0f);
             if(radioOnda > 1.8f) continue;
             
             float alpha = 0.3f * (1.0f - radioOnda / 1.8f);
-            glColor4f(1.0f, 1.0f, 1.0f, alpha);
+            RenderState::color(1.0f, 1.0f, 1.0f, alpha);
             
             glBegin(GL_LINE_LOOP);
             for(int j = 0; j < 32; j++) {
@@ -192,13 +130,13 @@ private:
             glEnd();
         }
         
-        glDisable(GL_BLEND);
+        RenderState::disable(GL_BLEND);
     }
 
 public:
     Pileta() : tiempoAgua(0.0f), tiempoAnterior(0), velocidadAnimacion(1.0f), 
                amplitudOndas(0.04f), texturasInicializadas(false),
-               texturaAzulejos(0), texturaLadrillos(0), texturaPiso(0) {
+               texturaAzulejos(0), texturaPiso(0) {
         tiempoInicio = clock();
         inicializarTexturas();
     }
@@ -210,17 +148,50 @@ public:
     void limpiarTexturas() {
         if (texturasInicializadas) {
             TextureManager::deleteTexture(texturaAzulejos);
-            TextureManager::deleteTexture(texturaLadrillos);
+            PropAtlas::unload(texturaLadrillos);
             TextureManager::deleteTexture(texturaPiso);
             texturasInicializadas = false;
         }
     }
     
+    // Partes para la cola de dibujo: el agua es transparente y va al final
+    enum Parte {
+        PARTE_BASE,
+        PARTE_AGUA
+    };
+
+    virtual void drawPart(int parte) {
+        if (parte == PARTE_AGUA) {
+            renderAgua();
+        } else {
+            renderBase();
+        }
+    }
+
     void render() {
+        renderBase();
+        renderAgua();
+    }
+
+    // Agua de la pileta con animacin automtica
+    void renderAgua() {
+        glPushMatrix();
+        glTranslatef(0.0f, 0.6f, 0.0f);
+        TextureManager::unbindTexture();
+        dibujarAguaAnimada();
+        glPopMatrix();
+    }
+
+    GLuint getTexturaAzulejos() const {
+        return texturaAzulejos;
+    }
+
+    // Todo menos el agua
+    void renderBase() {
         glPushMatrix();
         
         // Base exterior de la pileta (concreto)
-        glColor3f(0.7f, 0.7f, 0.7f);
+        RenderState::color(0.7f, 0.7f, 0.7f);
         TextureManager::unbindTexture();
         dibujarCilindro(2.8f, 0.4f, 32);
         
@@ -230,9 +201,9 @@ public:
         // Pared interior de la pileta (azulejos celestes)
         if (texturaAzulejos != 0) {
             TextureManager::bindTexture(texturaAzulejos);
-            glColor3f(0.9f, 0.95f, 1.0f);
+            RenderState::color(0.9f, 0.95f, 1.0f);
         } else {
-            glColor3f(0.4f, 0.7f, 0.9f);
+            RenderState::color(0.4f, 0.7f, 0.9f);
         }
         
         float radioExterior = 2.2f;
@@ -254,22 +225,14 @@ public:
         glEnd();
         
         // Fondo de la pileta (azulejos azules ms oscuros)
-        glColor3f(0.2f, 0.4f, 0.7f);
-        glBegin(GL_TRIANGLE_FAN);
-        glNormal3f(0.0f, 1.0f, 0.0f);
-        glTexCoord2f(0.5f, 0.5f);
-        glVertex3f(0.0f, -alturaParedes/2, 0.0f);
-        for(int i = 0; i <= 32; i++) {
-            float angulo = 2.0f * M_PI * i / 32;
-            float x = radioInterior * cos(angulo);
-            float z = radioInterior * sin(angulo);
-            glTexCoord2f(0.5f + 0.5f * cos(angulo), 0.5f + 0.5f * sin(angulo));
-            glVertex3f(x, -alturaParedes/2, z);
-        }
-        glEnd();
+        RenderState::color(0.2f, 0.4f, 0.7f);
+        glPushMatrix();
+        glTranslatef(0.0f, -alturaParedes/2, 0.0f);
+        PrimitiveCache::drawDisk(radioInterior, 32);
+        glPopMatrix();
         
         // Borde superior de la pileta
-        glColor3f(0.85f, 0.85f, 0.85f);
+        RenderState::color(0.85f, 0.85f, 0.85f);
         glBegin(GL_QUAD_STRIP);
         for(int i = 0; i <= 32; i++) {
             float angulo = 2.0f * M_PI * i / 32;
@@ -285,19 +248,14 @@ public:
         }
         glEnd();
         
-        // Agua de la pileta con animacin automtica
-        glTranslatef(0.0f, 0.4f, 0.0f);
-        TextureManager::unbindTexture();
-        dibujarAguaAnimada();
-        
         // Borde decorativo de ladrillos
-        glTranslatef(0.0f, -0.8f, 0.0f);
+        glTranslatef(0.0f, -0.4f, 0.0f);
         
-        if (texturaLadrillos != 0) {
-            TextureManager::bindTexture(texturaLadrillos);
-            glColor3f(0.95f, 0.9f, 0.85f);
+        if (texturaLadrillos.texture != 0) {
+            texturaLadrillos.bind();
+            RenderState::color(0.95f, 0.9f, 0.85f);
         } else {
-            glColor3f(0.8f, 0.4f, 0.3f);
+            RenderState::color(0.8f, 0.4f, 0.3f);
         }
         
         int numLadrillos = 20;
@@ -349,16 +307,16 @@ public:
             glPopMatrix();
         }
         
-        TextureManager::unbindTexture();
+        texturaLadrillos.unbind();
         glPopMatrix();
     }
     
     void dibujarPiso() {
         if (texturaPiso != 0) {
             TextureManager::bindTexture(texturaPiso);
-            glColor3f(1.0f, 1.0f, 1.0f);
+            RenderState::color(1.0f, 1.0f, 1.0f);
         } else {
-            glColor3f(0.9f, 0.9f, 0.8f);
+            RenderState::color(0.9f, 0.9f, 0.8f);
         }
         
         glBegin(GL_QUADS);
@@ -5,6 +5,7 @@
 #include <GL/gl.h>
 #include <GL/glu.h>
 #include <cmath> // Required for sqrt
+#include "meshbuilder.h"
 
 class Pista {
 private:
@@ -24,9 +25,9 @@ public:
     // Destructor
     ~Pista() {}
     
-    // Mtodo para dibujar la pista cuadrada
-    void draw() {
-        drawSquareTrack();
+    // Grabar la pista en 'mesh' (para el batch esttico de World)
+    void buildGeometry(MeshBuilder& mesh) {
+        drawSquareTrack(mesh);
     }
     
     // Getters para acceder a las dimensiones
@@ -46,7 +47,7 @@ public:
 private:
     // Funcin auxiliar para dibujar un segmento de lnea discontinua
     // Dibuja una serie de pequeos quads para simular una lnea discontinua
-    void drawDashedLine(float x1, float z1, float x2, float z2, float y, float segmentLength, float gapLength) {
+    void drawDashedLine(MeshBuilder& mesh, float x1, float z1, float x2, float z2, float y, float segmentLength, float gapLength) {
         float dx = x2 - x1;
         float dz = z2 - z1;
         float totalLength = sqrt(dx * dx + dz * dz); // Calcula la longitud total de la lnea
@@ -77,101 +78,101 @@ private:
             float perpDz = unitDx * halfLineWidth;
 
             // Dibuja el quad para el segmento de lnea
-            glBegin(GL_QUADS);
-            glNormal3f(0.0f, 1.0f, 0.0f); // Normal para una superficie plana
-            glVertex3f(currentX1 - perpDx, y, currentZ1 - perpDz);
-            glVertex3f(currentX1 + perpDx, y, currentZ1 + perpDz);
-            glVertex3f(currentX2 + perpDx, y, currentZ2 + perpDz);
-            glVertex3f(currentX2 - perpDx, y, currentZ2 - perpDz);
-            glEnd();
+            mesh.begin(GL_QUADS);
+            mesh.normal(0.0f, 1.0f, 0.0f); // Normal para una superficie plana
+            mesh.vertex(currentX1 - perpDx, y, currentZ1 - perpDz);
+            mesh.vertex(currentX1 + perpDx, y, currentZ1 + perpDz);
+            mesh.vertex(currentX2 + perpDx, y, currentZ2 + perpDz);
+            mesh.vertex(currentX2 - perpDx, y, currentZ2 - perpDz);
+            mesh.end();
 
             currentLength += (segmentLength + gapLength); // Avanza al inicio del siguiente segmento
         }
     }
 
     // Funcin para dibujar las veredas exteriores
-    void drawOuterSidewalks() {
+    void drawOuterSidewalks(MeshBuilder& mesh) {
         // Color gris claro para las veredas
-        glColor3f(0.7f, 0.7f, 0.7f);
-        glNormal3f(0.0f, 1.0f, 0.0f);
+        mesh.color(0.7f, 0.7f, 0.7f);
+        mesh.normal(0.0f, 1.0f, 0.0f);
         
         float sidewalkHeight = 0.005f; // Altura de las veredas
         float outerSidewalk = outerSize + sidewalkWidth;
         
         // Vereda superior (Norte)
-        glBegin(GL_QUADS);
-        glVertex3f(-outerSidewalk, sidewalkHeight, outerSidewalk);
-        glVertex3f(outerSidewalk, sidewalkHeight, outerSidewalk);
-        glVertex3f(outerSidewalk, sidewalkHeight, outerSize);
-        glVertex3f(-outerSidewalk, sidewalkHeight, outerSize);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-outerSidewalk, sidewalkHeight, outerSidewalk);
+        mesh.vertex(outerSidewalk, sidewalkHeight, outerSidewalk);
+        mesh.vertex(outerSidewalk, sidewalkHeight, outerSize);
+        mesh.vertex(-outerSidewalk, sidewalkHeight, outerSize);
+        mesh.end();
         
         // Vereda inferior (Sur)
-        glBegin(GL_QUADS);
-        glVertex3f(-outerSidewalk, sidewalkHeight, -outerSize);
-        glVertex3f(outerSidewalk, sidewalkHeight, -outerSize);
-        glVertex3f(outerSidewalk, sidewalkHeight, -outerSidewalk);
-        glVertex3f(-outerSidewalk, sidewalkHeight, -outerSidewalk);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-outerSidewalk, sidewalkHeight, -outerSize);
+        mesh.vertex(outerSidewalk, sidewalkHeight, -outerSize);
+        mesh.vertex(outerSidewalk, sidewalkHeight, -outerSidewalk);
+        mesh.vertex(-outerSidewalk, sidewalkHeight, -outerSidewalk);
+        mesh.end();
         
         // Vereda izquierda (Oeste)
-        glBegin(GL_QUADS);
-        glVertex3f(-outerSidewalk, sidewalkHeight, outerSize);
-        glVertex3f(-outerSize, sidewalkHeight, outerSize);
-        glVertex3f(-outerSize, sidewalkHeight, -outerSize);
-        glVertex3f(-outerSidewalk, sidewalkHeight, -outerSize);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-outerSidewalk, sidewalkHeight, outerSize);
+        mesh.vertex(-outerSize, sidewalkHeight, outerSize);
+        mesh.vertex(-outerSize, sidewalkHeight, -outerSize);
+        mesh.vertex(-outerSidewalk, sidewalkHeight, -outerSize);
+        mesh.end();
         
         // Vereda derecha (Este)
-        glBegin(GL_QUADS);
-        glVertex3f(outerSize, sidewalkHeight, outerSize);
-        glVertex3f(outerSidewalk, sidewalkHeight, outerSize);
-        glVertex3f(outerSidewalk, sidewalkHeight, -outerSize);
-        glVertex3f(outerSize, sidewalkHeight, -outerSize);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(outerSize, sidewalkHeight, outerSize);
+        mesh.vertex(outerSidewalk, sidewalkHeight, outerSize);
+        mesh.vertex(outerSidewalk, sidewalkHeight, -outerSize);
+        mesh.vertex(outerSize, sidewalkHeight, -outerSize);
+        mesh.end();
         
         // Veredas interiores (alrededor del rea central)
-        glColor3f(0.6f, 0.6f, 0.6f); // Color ligeramente ms oscuro para distinguir
+        mesh.color(0.6f, 0.6f, 0.6f); // Color ligeramente ms oscuro para distinguir
         float innerSidewalk = innerSize - sidewalkWidth;
         
         // Vereda interior superior (Norte)
-        glBegin(GL_QUADS);
-        glVertex3f(-innerSize, sidewalkHeight, innerSize);
-        glVertex3f(innerSize, sidewalkHeight, innerSize);
-        glVertex3f(innerSize, sidewalkHeight, innerSidewalk);
-        glVertex3f(-innerSize, sidewalkHeight, innerSidewalk);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-innerSize, sidewalkHeight, innerSize);
+        mesh.vertex(innerSize, sidewalkHeight, innerSize);
+        mesh.vertex(innerSize, sidewalkHeight, innerSidewalk);
+        mesh.vertex(-innerSize, sidewalkHeight, innerSidewalk);
+        mesh.end();
         
         // Vereda interior inferior (Sur)
-        glBegin(GL_QUADS);
-        glVertex3f(-innerSize, sidewalkHeight, -innerSidewalk);
-        glVertex3f(innerSize, sidewalkHeight, -innerSidewalk);
-        glVertex3f(innerSize, sidewalkHeight, -innerSize);
-        glVertex3f(-innerSize, sidewalkHeight, -innerSize);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-innerSize, sidewalkHeight, -innerSidewalk);
+        mesh.vertex(innerSize, sidewalkHeight, -innerSidewalk);
+        mesh.vertex(innerSize, sidewalkHeight, -innerSize);
+        mesh.vertex(-innerSize, sidewalkHeight, -innerSize);
+        mesh.end();
         
         // Vereda interior izquierda (Oeste)
-        glBegin(GL_QUADS);
-        glVertex3f(-innerSize, sidewalkHeight, innerSidewalk);
-        glVertex3f(-innerSidewalk, sidewalkHeight, innerSidewalk);
-        glVertex3f(-innerSidewalk, sidewalkHeight, -innerSidewalk);
-        glVertex3f(-innerSize, sidewalkHeight, -innerSidewalk);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-innerSize, sidewalkHeight, innerSidewalk);
+        mesh.vertex(-innerSidewalk, sidewalkHeight, innerSidewalk);
+        mesh.vertex(-innerSidewalk, sidewalkHeight, -innerSidewalk);
+        mesh.vertex(-innerSize, sidewalkHeight, -innerSidewalk);
+        mesh.end();
         
         // Vereda interior derecha (Este)
-        glBegin(GL_QUADS);
-        glVertex3f(innerSidewalk, sidewalkHeight, innerSidewalk);
-        glVertex3f(innerSize, sidewalkHeight, innerSidewalk);
-        glVertex3f(innerSize, sidewalkHeight, -innerSidewalk);
-        glVertex3f(innerSidewalk, sidewalkHeight, -innerSidewalk);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(innerSidewalk, sidewalkHeight, innerSidewalk);
+        mesh.vertex(innerSize, sidewalkHeight, innerSidewalk);
+        mesh.vertex(innerSize, sidewalkHeight, -innerSidewalk);
+        mesh.vertex(innerSidewalk, sidewalkHeight, -innerSidewalk);
+        mesh.end();
     }
 
     // Funcin para dibujar el divisor central con pasto
-    void drawCenterDivider() {
+    void drawCenterDivider(MeshBuilder& mesh) {
         // Color verde para el pasto del divisor central
-        glColor3f(0.2f, 0.6f, 0.2f);
-        glNormal3f(0.0f, 1.0f, 0.0f);
+        mesh.color(0.2f, 0.6f, 0.2f);
+        mesh.normal(0.0f, 1.0f, 0.0f);
         
         float dividerHeight = 0.03f; // Altura del divisor central
         float halfDivider = centerDividerWidth / 2.0f;
@@ -180,83 +181,83 @@ private:
         float centerPos = (outerSize + innerSize) / 2.0f;
         
         // Divisor central superior (Norte)
-        glBegin(GL_QUADS);
-        glVertex3f(-outerSize, dividerHeight, centerPos + halfDivider);
-        glVertex3f(outerSize, dividerHeight, centerPos + halfDivider);
-        glVertex3f(outerSize, dividerHeight, centerPos - halfDivider);
-        glVertex3f(-outerSize, dividerHeight, centerPos - halfDivider);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-outerSize, dividerHeight, centerPos + halfDivider);
+        mesh.vertex(outerSize, dividerHeight, centerPos + halfDivider);
+        mesh.vertex(outerSize, dividerHeight, centerPos - halfDivider);
+        mesh.vertex(-outerSize, dividerHeight, centerPos - halfDivider);
+        mesh.end();
         
         // Divisor central inferior (Sur)
-        glBegin(GL_QUADS);
-        glVertex3f(-outerSize, dividerHeight, -centerPos + halfDivider);
-        glVertex3f(outerSize, dividerHeight, -centerPos + halfDivider);
-        glVertex3f(outerSize, dividerHeight, -centerPos - halfDivider);
-        glVertex3f(-outerSize, dividerHeight, -centerPos - halfDivider);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-outerSize, dividerHeight, -centerPos + halfDivider);
+        mesh.vertex(outerSize, dividerHeight, -centerPos + halfDivider);
+        mesh.vertex(outerSize, dividerHeight, -centerPos - halfDivider);
+        mesh.vertex(-outerSize, dividerHeight, -centerPos - halfDivider);
+        mesh.end();
         
         // Divisor central izquierdo (Oeste)
-        glBegin(GL_QUADS);
-        glVertex3f(-centerPos - halfDivider, dividerHeight, innerSize);
-        glVertex3f(-centerPos + halfDivider, dividerHeight, innerSize);
-        glVertex3f(-centerPos + halfDivider, dividerHeight, -innerSize);
-        glVertex3f(-centerPos - halfDivider, dividerHeight, -innerSize);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-centerPos - halfDivider, dividerHeight, innerSize);
+        mesh.vertex(-centerPos + halfDivider, dividerHeight, innerSize);
+        mesh.vertex(-centerPos + halfDivider, dividerHeight, -innerSize);
+        mesh.vertex(-centerPos - halfDivider, dividerHeight, -innerSize);
+        mesh.end();
         
         // Divisor central derecho (Este)
-        glBegin(GL_QUADS);
-        glVertex3f(centerPos - halfDivider, dividerHeight, innerSize);
-        glVertex3f(centerPos + halfDivider, dividerHeight, innerSize);
-        glVertex3f(centerPos + halfDivider, dividerHeight, -innerSize);
-        glVertex3f(centerPos - halfDivider, dividerHeight, -innerSize);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(centerPos - halfDivider, dividerHeight, innerSize);
+        mesh.vertex(centerPos + halfDivider, dividerHeight, innerSize);
+        mesh.vertex(centerPos + halfDivider, dividerHeight, -innerSize);
+        mesh.vertex(centerPos - halfDivider, dividerHeight, -innerSize);
+        mesh.end();
     }
 
-    void drawSquareTrack() {
+    void drawSquareTrack(MeshBuilder& mesh) {
         // Primero dibuja las veredas exteriores
-        drawOuterSidewalks();
+        drawOuterSidewalks(mesh);
         
         // Color principal de la pista (gris)
-        glColor3f(0.4f, 0.4f, 0.4f);
-        glNormal3f(0.0f, 1.0f, 0.0f); // Normal para una superficie plana
+        mesh.color(0.4f, 0.4f, 0.4f);
+        mesh.normal(0.0f, 1.0f, 0.0f); // Normal para una superficie plana
 
         // Pista superior (Norte) - Quad gris slido
-        glBegin(GL_QUADS);
-        glVertex3f(-outerSize, 0.01f, outerSize);
-        glVertex3f(outerSize, 0.01f, outerSize);
-        glVertex3f(outerSize, 0.01f, innerSize);
-        glVertex3f(-outerSize, 0.01f, innerSize);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-outerSize, 0.01f, outerSize);
+        mesh.vertex(outerSize, 0.01f, outerSize);
+        mesh.vertex(outerSize, 0.01f, innerSize);
+        mesh.vertex(-outerSize, 0.01f, innerSize);
+        mesh.end();
         
         // Pista inferior (Sur) - Quad gris slido
-        glBegin(GL_QUADS);
-        glVertex3f(-outerSize, 0.01f, -innerSize);
-        glVertex3f(outerSize, 0.01f, -innerSize);
-        glVertex3f(outerSize, 0.01f, -outerSize);
-        glVertex3f(-outerSize, 0.01f, -outerSize);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-outerSize, 0.01f, -innerSize);
+        mesh.vertex(outerSize, 0.01f, -innerSize);
+        mesh.vertex(outerSize, 0.01f, -outerSize);
+        mesh.vertex(-outerSize, 0.01f, -outerSize);
+        mesh.end();
         
         // Pista izquierda (Oeste) - Quad gris slido
-        glBegin(GL_QUADS);
-        glVertex3f(-outerSize, 0.01f, innerSize);
-        glVertex3f(-innerSize, 0.01f, innerSize);
-        glVertex3f(-innerSize, 0.01f, -innerSize);
-        glVertex3f(-outerSize, 0.01f, -innerSize);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(-outerSize, 0.01f, innerSize);
+        mesh.vertex(-innerSize, 0.01f, innerSize);
+        mesh.vertex(-innerSize, 0.01f, -innerSize);
+        mesh.vertex(-outerSize, 0.01f, -innerSize);
+        mesh.end();
         
         // Pista derecha (Este) - Quad gris slido
-        glBegin(GL_QUADS);
-        glVertex3f(innerSize, 0.01f, innerSize);
-        glVertex3f(outerSize, 0.01f, innerSize);
-        glVertex3f(outerSize, 0.01f, -innerSize);
-        glVertex3f(innerSize, 0.01f, -innerSize);
-        glEnd();
+        mesh.begin(GL_QUADS);
+        mesh.vertex(innerSize, 0.01f, innerSize);
+        mesh.vertex(outerSize, 0.01f, innerSize);
+        mesh.vertex(outerSize, 0.01f, -innerSize);
+        mesh.vertex(innerSize, 0.01f, -innerSize);
+        mesh.end();
         
         // Dibuja el divisor central con pasto
-        drawCenterDivider();
+        drawCenterDivider(mesh);
         
         // Lneas amarillas discontinuas para divisin de carriles
-        glColor3f(1.0f, 1.0f, 0.0f); // Color amarillo
+        mesh.color(1.0f, 1.0f, 0.0f); // Color amarillo
         float lineY = 0.02f; // Ligeramente por encima de la pista para asegurar visibilidad
         float segmentLength = 4.0f; // Longitud de cada segmento de guion
         float gapLength = 4.0f;     // Longitud del espacio entre guiones
@@ -275,20 +276,20 @@ private:
         float xLine2 = innerSize + laneWidth + (laneWidth / 2.0f);
 
         // Lneas superiores (Norte) - Dos lneas discontinuas
-        drawDashedLine(-outerSize, zLine1, outerSize, zLine1, lineY, segmentLength, gapLength);
-        drawDashedLine(-outerSize, zLine2, outerSize, zLine2, lineY, segmentLength, gapLength);
+        drawDashedLine(mesh, -outerSize, zLine1, outerSize, zLine1, lineY, segmentLength, gapLength);
+        drawDashedLine(mesh, -outerSize, zLine2, outerSize, zLine2, lineY, segmentLength, gapLength);
         
         // Lneas inferiores (Sur) - Dos lneas discontinuas
-        drawDashedLine(-outerSize, -zLine1, outerSize, -zLine1, lineY, segmentLength, gapLength);
-        drawDashedLine(-outerSize, -zLine2, outerSize, -zLine2, lineY, segmentLength, gapLength);
+        drawDashedLine(mesh, -outerSize, -zLine1, outerSize, -zLine1, lineY, segmentLength, gapLength);
+        drawDashedLine(mesh, -outerSize, -zLine2, outerSize, -zLine2, lineY, segmentLength, gapLength);
         
         // Lneas izquierdas (Oeste) - Dos lneas discontinuas
-        drawDashedLine(-xLine1, innerSize, -xLine1, -innerSize, lineY, segmentLength, gapLength);
-        drawDashedLine(-xLine2, innerSize, -xLine2, -innerSize, lineY, segmentLength, gapLength);
+        drawDashedLine(mesh, -xLine1, innerSize, -xLine1, -innerSize, lineY, segmentLength, gapLength);
+        drawDashedLine(mesh, -xLine2, innerSize, -xLine2, -innerSize, lineY, segmentLength, gapLength);
         
         // Lneas derechas (Este) - Dos lneas discontinuas
-        drawDashedLine(xLine1, innerSize, xLine1, -innerSize, lineY, segmentLength, gapLength);
-        drawDashedLine(xLine2, innerSize, xLine2, -innerSize, lineY, segmentLength, gapLength);
+        drawDashedLine(mesh, xLine1, innerSize, xLine1, -innerSize, lineY, segmentLength, gapLength);
+        drawDashedLine(mesh, xLine2, innerSize, xLine2, -innerSize, lineY, segmentLength, gapLength);
     }
 };
 
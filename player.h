@@ -3,6 +3,9 @@
 
 #include <GL/glut.h>
 #include <cmath> // For cosf, sinf, sqrtf
+#include "primitivecache.h"
+#include "levelofdetail.h"
+#include "renderstate.h"
 
 class Camera {
 private:
@@ -14,6 +17,7 @@ private:
 
     bool thirdPerson;
     float thirdPersonDistance;
+    float thirdPersonCurrentDistance; // Distancia real tras acercarse por paredes
 
     // Variables para fsica de salto
     float velocityY;
@@ -24,6 +28,7 @@ private:
     float bodyRadius;
     int bodySlices;
     int bodyStacks;
+    LevelOfDetail bodyLod;
 
     void updateVectors() {
         // Calculate front vector from pitch and yaw
@@ -78,7 +83,7 @@ public:
                frontX(0.0f), frontY(0.0f), frontZ(-1.0f),
                upX(0.0f), upY(1.0f), upZ(0.0f),
                rightX(1.0f), rightY(0.0f), rightZ(0.0f),
-               thirdPerson(false), thirdPersonDistance(8.0f),
+               thirdPerson(false), thirdPersonDistance(8.0f), thirdPersonCurrentDistance(8.0f),
                velocityY(0.0f), isGrounded(false), groundLevel(-0.1f),
                bodyRadius(0.33f), bodySlices(30), bodyStacks(30) {
         updateVectors();
@@ -100,9 +105,9 @@ public:
 
         if (thirdPerson) {
             // Calculate camera position for third-person view
-            float camX = eyeX - frontX * thirdPersonDistance;
-            float camY = eyeY - frontY * thirdPersonDistance + bodyRadius * 1.5f;
-            float camZ = eyeZ - frontZ * thirdPersonDistance;
+            float camX = eyeX - frontX * thirdPersonCurrentDistance;
+            float camY = eyeY - frontY * thirdPersonCurrentDistance + bodyRadius * 1.5f;
+            float camZ = eyeZ - frontZ * thirdPersonCurrentDistance;
 
             gluLookAt(camX, camY, camZ,
                       eyeX, eyeY, eyeZ,
@@ -125,8 +130,12 @@ public:
         // Mueve la esfera a la posicin del personaje, ajustando para que la base est en eyeY
         // El centro de la esfera ser (eyeX, eyeY - bodyRadius, eyeZ)
         glTranslatef(eyeX, eyeY - bodyRadius, eyeZ);
-        glColor3f(0.8f, 0.2f, 0.2f); // Color rojo
-        glutSolidSphere(bodyRadius, bodySlices, bodyStacks);
+        RenderState::color(0.8f, 0.2f, 0.2f); // Color rojo
+        // Menos caras cuando la cmara est lejos (tercera persona alejada)
+        ScreenProjection screen;
+        int level = bodyLod.select(screen.pixelRadius(0.0f, 0.0f, 0.0f, bodyRadius));
+        PrimitiveCache::drawSphere(bodyRadius, LevelOfDetail::scaleDetail(bodySlices, level, 8),
+                                   LevelOfDetail::scaleDetail(bodyStacks, level, 6));
         glPopMatrix();
     }
 
@@ -280,6 +289,34 @@ public:
         thirdPerson = !thirdPerson;
     }
 
+    // Rayo sobre el que se coloca la cmara en tercera persona: parte del punto
+    // de pivote sobre el personaje y va hacia atrs de la vista
+    void getThirdPersonRay(float& originX, float& originY, float& originZ,
+                           float& dirX, float& dirY, float& dirZ) const {
+        originX = eyeX;
+        originY = eyeY + bodyRadius * 1.5f;
+        originZ = eyeZ;
+        dirX = -frontX;
+        dirY = -frontY;
+        dirZ = -frontZ;
+    }
+
+    // Ajustar la distancia de la cmara en tercera persona a la distancia libre
+    // detrs del personaje: se acerca de inmediato y vuelve a alejarse suavemente
+    void updateThirdPersonDistance(float freeDistance, float deltaTime) {
+        const float MIN_DISTANCE = 0.5f;
+        float target = fmaxf(MIN_DISTANCE, fminf(freeDistance, thirdPersonDistance));
+
+        if (target < thirdPersonCurrentDistance) {
+            thirdPersonCurrentDistance = target;
+        } else {
+            float blend = fminf(1.0f, 5.0f * deltaTime);
+            thirdPersonCurrentDistance += (target - thirdPersonCurrentDistance) * blend;
+        }
+    }
+
+    float getThirdPersonDistance() const { return thirdPersonDistance; }
+
     bool isThirdPerson() const { return thirdPerson; }
     bool getIsGrounded() const { return isGrounded; }
     float getX() const { return eyeX; }
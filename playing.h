@@ -8,6 +8,8 @@
 #include "world.h"
 #include "mechanics.h" // For InputManager
 #include "collision.h" // Include the collision system header
+#include "renderstate.h"
+#include "bitmapfont.h"
 
 // Forward declaration para evitar dependencias circulares
 class Game;
@@ -28,6 +30,9 @@ private:
     bool sprintMode;     // Modo velocidad rpida (toggle con X)
     bool slowMode;       // Modo velocidad lenta (toggle con Z)
 
+    // Contadores de rendimiento en el HUD (toggle con F3, apagado por defecto)
+    bool showStats;
+
     // Callbacks estticos para GLUT
     static Playing* instance;
 
@@ -99,6 +104,11 @@ private:
                 }
             }
 
+            if (key == GLUT_KEY_F3) {
+                instance->showStats = !instance->showStats;
+                printf("Contadores de rendimiento: %s\n", instance->showStats ? "ON" : "OFF");
+            }
+
             instance->input->specialKeyDown(key);
         }
     }
@@ -167,17 +177,34 @@ private:
         }
 
         // PASO 1: Aplicar movimiento bsico (horizontal + fsica vertical)
+        float startX = camera->getX();
+        float startY = camera->getY();
+        float startZ = camera->getZ();
         camera->move(moveZ, moveX, deltaTime);
 
         // PASO 2: Verificar y resolver colisiones
         if (collisionSystem) {
-            float playerX = camera->getX();
-            float playerY = camera->getY();
-            float playerZ = camera->getZ();
+            float playerX = startX;
+            float playerY = startY;
+            float playerZ = startZ;
             float playerRadius = camera->getBodyRadius(); // Asume que Camera tiene este mtodo
 
-            // Verificar colisiones
-            CollisionResult result = collisionSystem->checkCollision(playerX, playerY, playerZ, playerRadius);
+            // Barrer el desplazamiento del frame desde la posicin anterior para no
+            // atravesar cajas delgadas con pasos grandes, deslizando sobre lo que toque
+            SweepResult sweep = collisionSystem->slideMove(playerX, playerY, playerZ, playerRadius,
+                                                           camera->getX() - startX,
+                                                           camera->getY() - startY,
+                                                           camera->getZ() - startZ);
+            if (sweep.hit) {
+                camera->setPosition(playerX, playerY, playerZ);
+                camera->handleCollision(0.0f, 0.0f, 0.0f, sweep.normalX, sweep.normalY, sweep.normalZ);
+            }
+            playerX = camera->getX();
+            playerY = camera->getY();
+            playerZ = camera->getZ();
+
+            // Resolver la penetracin residual con todos los contactos a la vez
+            CollisionResult result = collisionSystem->resolveContacts(playerX, playerY, playerZ, playerRadius);
             
             if (result.hasCollision) {
                 // Aplicar correccin de colisin
@@ -191,28 +218,13 @@ private:
             }
 
             // PASO 3: Verificar estado del suelo (importante para colisiones desde arriba)
-            float highestSupportY = -1000.0f; // Inicializar muy bajo
-            
             // Buscar la superficie ms alta que est justo debajo del jugador
-            for (size_t i = 0; i < collisionSystem->getBoxCount(); ++i) {
-                const CollisionBox& box = collisionSystem->getBox(i);
-                
-                // Verificar si el jugador est horizontalmente sobre este cubo
-                if (playerX >= box.getMinX() && playerX <= box.getMaxX() &&
-                    playerZ >= box.getMinZ() && playerZ <= box.getMaxZ()) {
-                    
-                    // Verificar si el jugador est cerca de la superficie superior
-                    float surfaceY = box.getMaxY();
-                    if (playerY >= surfaceY && playerY <= surfaceY + playerRadius + 0.5f) { // Considerar un pequeo margen
-                        if (surfaceY > highestSupportY) {
-                            highestSupportY = surfaceY;
-                        }
-                    }
-                }
-            }
+            // (considerando un pequeo margen por encima del radio)
+            float highestSupportY = collisionSystem->queryHighestSupport(
+                playerX, playerZ, playerY - playerRadius - 0.5f, playerY);
             
             // Actualizar estado del suelo basado en la superficie ms alta encontrada
-            if (highestSupportY > -999.0f) { // Si se encontr una superficie de soporte vlida
+            if (highestSupportY > CollisionSystem::noSupport()) { // Si se encontr una superficie de soporte vlida
                 camera->checkGroundStatus(highestSupportY);
             } else { // Si no se encontr ninguna superficie debajo del jugador (e.g., est en el aire o sobre un vaco)
                 camera->checkGroundStatus(-1000.0f); // O un valor que indique "sin suelo"
@@ -232,16 +244,17 @@ private:
     }
 
     void resetOpenGLState() {
-        glDisable(GL_LIGHTING);
+        LightingShader::reset();
+        RenderState::disable(GL_LIGHTING);
         for (int i = 0; i < 8; i++) {
-            glDisable(GL_LIGHT0 + i);
+            RenderState::disable(GL_LIGHT0 + i);
         }
-        glDisable(GL_DEPTH_TEST);
-        glDisable(GL_CULL_FACE);
-        glDisable(GL_COLOR_MATERIAL);
-        glDisable(GL_NORMALIZE);
-        glDisable(GL_BLEND);
-        glColor3f(1.0f, 1.0f, 1.0f);
+        RenderState::disable(GL_DEPTH_TEST);
+        RenderState::disable(GL_CULL_FACE);
+        RenderState::disable(GL_COLOR_MATERIAL);
+        RenderState::disable(GL_NORMALIZE);
+        RenderState::disable(GL_BLEND);
+        RenderState::color(1.0f, 1.0f, 1.0f);
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glutSetCursor(GLUT_CURSOR_LEFT_ARROW);
         glMatrixMode(GL_PROJECTION);
@@ -252,8 +265,8 @@ private:
 
 public:
     Playing() : active(false), lightning(NULL), camera(NULL), world(NULL), input(NULL),
-                exitRequested(false), sprintMode(false), slowMode(false),
-                collisionSystem(NULL) {
+                collisionSystem(NULL), exitRequested(false), sprintMode(false), slowMode(false),
+                showStats(false) {
         instance = this;
 
         lightning = new Lightning();
@@ -304,8 +317,8 @@ public:
             glutMotionFunc(mouseMotionCallback);
 
             glClearColor(0.5f, 0.7f, 1.0f, 1.0f);
-            glEnable(GL_DEPTH_TEST);
-            glEnable(GL_CULL_FACE);
+            RenderState::enable(GL_DEPTH_TEST);
+            RenderState::enable(GL_CULL_FACE);
             glCullFace(GL_BACK);
 
             if (lightning) {
@@ -315,8 +328,10 @@ public:
             input->reset();
             input->setMouseCaptured(true);
 
-            if (collisionSystem) {
-                collisionSystem->setupWorldCollisions();
+            // El mundo de colisiones es esttico: se carga del archivo horneado
+            // o se construye y se guarda una sola vez, no en cada entrada al juego
+            if (collisionSystem && !collisionSystem->isReady()) {
+                collisionSystem->setupWorldCollisions(COLLISION_BAKE_FILE);
             }
 
             sprintMode = false;
@@ -344,6 +359,18 @@ public:
         // 1. Procesar la entrada y actualizar la posicin del jugador/cmara
         processInput(deltaTime);
 
+        // Acercar la cmara en tercera persona si hay paredes entre ella y el jugador
+        if (camera->isThirdPerson() && collisionSystem) {
+            const float CAMERA_PROBE_RADIUS = 0.2f; // Mantiene el plano cercano fuera de las paredes
+            float originX, originY, originZ, dirX, dirY, dirZ;
+            camera->getThirdPersonRay(originX, originY, originZ, dirX, dirY, dirZ);
+
+            RaycastHit hit = collisionSystem->sphereCast(originX, originY, originZ, CAMERA_PROBE_RADIUS,
+                                                         dirX, dirY, dirZ,
+                                                         camera->getThirdPersonDistance());
+            camera->updateThirdPersonDistance(hit.distance, deltaTime);
+        }
+
         // 2. Obtener la posicin y el radio actual del jugador (desde la cmara en este caso)
         Vector3 playerPos(camera->getX(), camera->getY(), camera->getZ());
         float playerRadius = camera->getBodyRadius(); // Asegrate de que Camera tenga este mtodo
@@ -351,6 +378,7 @@ public:
         // 3. Actualizar el mundo, pasndole la posicin del jugador
         if (world) {
             world->update(playerPos, playerRadius); // NUEVA LNEA CLAVE!
+            world->syncCarCollisions(collisionSystem);
         }
     }
 
@@ -382,12 +410,11 @@ public:
         glPushMatrix();
         glLoadIdentity();
 
-        glDisable(GL_LIGHTING);
-        glDisable(GL_DEPTH_TEST);
+        RenderState::disable(GL_LIGHTING);
+        RenderState::disable(GL_DEPTH_TEST);
 
         // Dibujar el texto del HUD
-        glColor3f(1.0f, 1.0f, 1.0f);
-        glRasterPos2f(10.0f, 20.0f);
+        RenderState::color(1.0f, 1.0f, 1.0f);
 
         const char* speedMode = "Normal";
         if (sprintMode) {
@@ -403,20 +430,26 @@ public:
                         camera->getIsGrounded() ? "Si" : "No",
                         speedMode);
 
-        for (const char* c = text; *c != '\0'; c++) {
-            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, *c);
+        BitmapFont::drawText(GLUT_BITMAP_HELVETICA_12, 10.0f, 20.0f, text);
+
+        if (showStats && world) {
+            sprintf(text, "Objetos fuera de camara: %d", world->getCulledObjectCount());
+            BitmapFont::drawText(GLUT_BITMAP_HELVETICA_12, 10.0f, 40.0f, text);
         }
 
-        glRasterPos2f(10.0f, viewport[3] - 40);
-        const char* controls = "WASD: Mover | ESPACIO: Saltar | V: Vista | X: Velocidad rpida | Z: Velocidad lenta | ESC: Menu";
-        for (const char* c = controls; *c != '\0'; c++) {
-            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_10, *c);
+        if (showStats) {
+            sprintf(text, "Cambios de estado: %d enviados, %d evitados",
+                    RenderState::getIssuedCalls(), RenderState::getDroppedCalls());
+            BitmapFont::drawText(GLUT_BITMAP_HELVETICA_12, 10.0f, 60.0f, text);
         }
 
+        const char* controls = "WASD: Mover | ESPACIO: Saltar | V: Vista | X: Velocidad rpida | Z: Velocidad lenta | ESC: Menu";
+        BitmapFont::drawText(GLUT_BITMAP_HELVETICA_10, 10.0f, (float)(viewport[3] - 40), controls);
+
         // Restaurar el estado OpenGL 3D
-        glEnable(GL_DEPTH_TEST);
+        RenderState::enable(GL_DEPTH_TEST);
         if (lightning && lightning->isEnabled()) {
-            glEnable(GL_LIGHTING);
+            RenderState::enable(GL_LIGHTING);
         }
 
         glPopMatrix();
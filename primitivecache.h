@@ -0,0 +1,194 @@
+#ifndef PRIMITIVECACHE_H
+#define PRIMITIVECACHE_H
+
+#include <GL/glut.h>
+#include <cmath>
+#include <map>
+#include "meshbuilder.h"
+#include "meshbuffer.h"
+#include "lightingshader.h"
+#include "renderstate.h"
+
+// Esferas, cilindros y discos teselados una sola vez. Cada malla se guarda
+// con tamao unitario segn su tipo y su teselacin, y se escala al dibujarla,
+// as ningn objeto recalcula senos y cosenos en cada frame. Los colores y la
+// textura los pone quien dibuja, igual que con glutSolidSphere.
+class PrimitiveCache {
+public:
+    enum PrimitiveType {
+        SPHERE,          // Como glutSolidSphere: eje Z, sin coordenadas de textura tiles
+        TEXTURED_SPHERE, // Eje Y, con u alrededor y v de polo a polo
+        CYLINDER,        // Eje Y, centrado, con tapas
+        DISK             // Plano XZ mirando a +Y
+    };
+
+    static void drawSphere(float radius, int slices, int stacks) {
+        drawScaled(getMesh(SPHERE, slices, stacks), radius, radius, radius);
+    }
+
+    static void drawTexturedSphere(float radius, int slices, int stacks) {
+        drawScaled(getMesh(TEXTURED_SPHERE, slices, stacks), radius, radius, radius);
+    }
+
+    static void drawCylinder(float radius, float height, int slices) {
+        drawScaled(getMesh(CYLINDER, slices, 1), radius, height, radius);
+    }
+
+    static void drawDisk(float radius, int slices) {
+        drawScaled(getMesh(DISK, slices, 1), radius, 1.0f, radius);
+    }
+
+    // Liberar los buffers (al cerrar, mientras el contexto sigue vivo)
+    static void release() {
+        for (std::map<Key, MeshBuffer*>::iterator it = meshes.begin(); it != meshes.end(); ++it) {
+            delete it->second;
+        }
+        meshes.clear();
+    }
+
+private:
+    struct Key {
+        int type;
+        int slices;
+        int stacks;
+
+        bool operator<(const Key& other) const {
+            if (type != other.type) return type < other.type;
+            if (slices != other.slices) return slices < other.slices;
+            return stacks < other.stacks;
+        }
+    };
+
+    static std::map<Key, MeshBuffer*> meshes;
+
+    static const MeshBuffer& getMesh(PrimitiveType type, int slices, int stacks) {
+        Key key;
+        key.type = type;
+        key.slices = slices;
+        key.stacks = stacks;
+
+        std::map<Key, MeshBuffer*>::iterator it = meshes.find(key);
+        if (it != meshes.end()) {
+            return *it->second;
+        }
+
+        MeshBuilder mesh;
+        switch (type) {
+            case SPHERE:          mesh.solidSphere(1.0f, slices, stacks); break;
+            case TEXTURED_SPHERE: buildTexturedSphere(mesh, slices, stacks); break;
+            case CYLINDER:        buildCylinder(mesh, slices); break;
+            case DISK:            buildDisk(mesh, slices); break;
+        }
+        MeshBuffer* buffer = new MeshBuffer();
+        buffer->build(mesh, false);
+        meshes[key] = buffer;
+        return *buffer;
+    }
+
+    // Las normales de la malla son unitarias; con escala hace falta GL_NORMALIZE
+    static void drawScaled(const MeshBuffer& mesh, float sx, float sy, float sz) {
+        bool normalize = RenderState::isEnabled(GL_NORMALIZE);
+        if (!normalize) RenderState::enable(GL_NORMALIZE);
+
+        glPushMatrix();
+        glScalef(sx, sy, sz);
+        LightingShader::begin();
+        mesh.bind();
+        mesh.draw();
+        mesh.unbind();
+        LightingShader::end();
+        glPopMatrix();
+
+        if (!normalize) RenderState::disable(GL_NORMALIZE);
+    }
+
+    static void buildTexturedSphere(MeshBuilder& mesh, int slices, int stacks) {
+        for (int i = 0; i < stacks; i++) {
+            float phi1 = (float)M_PI * i / stacks;
+            float phi2 = (float)M_PI * (i + 1) / stacks;
+
+            mesh.begin(GL_QUAD_STRIP);
+            for (int j = 0; j <= slices; j++) {
+                float theta = 2.0f * (float)M_PI * j / slices;
+                float u = (float)j / slices;
+
+                float x1 = sinf(phi1) * cosf(theta);
+                float y1 = cosf(phi1);
+                float z1 = sinf(phi1) * sinf(theta);
+                mesh.normal(x1, y1, z1);
+                mesh.texCoord(u, (float)i / stacks);
+                mesh.vertex(x1, y1, z1);
+
+                float x2 = sinf(phi2) * cosf(theta);
+                float y2 = cosf(phi2);
+                float z2 = sinf(phi2) * sinf(theta);
+                mesh.normal(x2, y2, z2);
+                mesh.texCoord(u, (float)(i + 1) / stacks);
+                mesh.vertex(x2, y2, z2);
+            }
+            mesh.end();
+        }
+    }
+
+    static void buildCylinder(MeshBuilder& mesh, int slices) {
+        float angle = 2.0f * (float)M_PI / slices;
+
+        // Tapa superior
+        mesh.begin(GL_TRIANGLE_FAN);
+        mesh.normal(0.0f, 1.0f, 0.0f);
+        mesh.texCoord(0.5f, 0.5f);
+        mesh.vertex(0.0f, 0.5f, 0.0f);
+        for (int i = 0; i <= slices; i++) {
+            float c = cosf(i * angle);
+            float s = sinf(i * angle);
+            mesh.texCoord(0.5f + 0.5f * c, 0.5f + 0.5f * s);
+            mesh.vertex(c, 0.5f, s);
+        }
+        mesh.end();
+
+        // Tapa inferior
+        mesh.begin(GL_TRIANGLE_FAN);
+        mesh.normal(0.0f, -1.0f, 0.0f);
+        mesh.texCoord(0.5f, 0.5f);
+        mesh.vertex(0.0f, -0.5f, 0.0f);
+        for (int i = slices; i >= 0; i--) {
+            float c = cosf(i * angle);
+            float s = sinf(i * angle);
+            mesh.texCoord(0.5f + 0.5f * c, 0.5f + 0.5f * s);
+            mesh.vertex(c, -0.5f, s);
+        }
+        mesh.end();
+
+        // Lados
+        mesh.begin(GL_QUAD_STRIP);
+        for (int i = 0; i <= slices; i++) {
+            float c = cosf(i * angle);
+            float s = sinf(i * angle);
+            mesh.normal(c, 0.0f, s);
+            mesh.texCoord((float)i / slices, 1.0f);
+            mesh.vertex(c, 0.5f, s);
+            mesh.texCoord((float)i / slices, 0.0f);
+            mesh.vertex(c, -0.5f, s);
+        }
+        mesh.end();
+    }
+
+    static void buildDisk(MeshBuilder& mesh, int slices) {
+        mesh.begin(GL_TRIANGLE_FAN);
+        mesh.normal(0.0f, 1.0f, 0.0f);
+        mesh.texCoord(0.5f, 0.5f);
+        mesh.vertex(0.0f, 0.0f, 0.0f);
+        for (int i = 0; i <= slices; i++) {
+            float angle = 2.0f * (float)M_PI * i / slices;
+            float c = cosf(angle);
+            float s = sinf(angle);
+            mesh.texCoord(0.5f + 0.5f * c, 0.5f + 0.5f * s);
+            mesh.vertex(c, 0.0f, s);
+        }
+        mesh.end();
+    }
+};
+
+std::map<PrimitiveCache::Key, MeshBuffer*> PrimitiveCache::meshes;
+
+#endif // PRIMITIVECACHE_H
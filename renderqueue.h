@@ -0,0 +1,136 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <GL/glut.h>
+#include <vector>
+#include <algorithm>
+
+// Algo que se puede dibujar desde la cola. 'part' distingue las piezas de un
+// mismo objeto (por ejemplo un material de un batch, o el agua de la pileta).
+class Drawable {
+public:
+    virtual ~Drawable() {}
+    virtual void drawPart(int part) = 0;
+};
+
+// Cola de dibujo del frame. Cada objeto se anota con una clave de orden
+// (pasada, shader, textura, material, profundidad) y la matriz actual; al
+// ejecutar se ordena por clave, as las piezas con la misma textura quedan
+// juntas, lo sin iluminacin va antes que lo iluminado, lo opaco se dibuja de
+// adelante hacia atrs y lo transparente de atrs hacia adelante al final.
+//
+// La clave ocupa 32 bits:
+//     pasada (2) | iluminado (1) | textura (8) | material (5) | profundidad (16)
+//
+// La textura no va con su nombre de OpenGL sino con un nmero chico que se
+// le da en el frame la primera vez que aparece (0 = sin textura), as dos
+// nombres que solo difieren en los bits altos no se mezclan en la clave.
+class RenderQueue {
+public:
+    enum Pass {
+        PASS_OPAQUE = 0,
+        PASS_TRANSPARENT = 1,
+        PASS_OVERLAY = 2     // Lo que va encima de todo, en el orden en que llega
+    };
+
+private:
+    struct Item {
+        unsigned int key;
+        int order;           // Para desempatar en el orden de llegada
+        Drawable* drawable;
+        int part;
+        GLfloat matrix[16];
+    };
+
+    struct ItemLess {
+        bool operator()(const Item* a, const Item* b) const {
+            if (a->key != b->key) return a->key < b->key;
+            return a->order < b->order;
+        }
+    };
+
+    // Profundidades hasta 1024 unidades con 1/64 de precisin
+    static const int DEPTH_SCALE = 64;
+    static const unsigned int DEPTH_MAX = 0xFFFF;
+    static const unsigned int TEXTURE_RANK_MAX = 0xFF;
+
+    std::vector<Item> items;
+    std::vector<Item*> sorted;
+    std::vector<GLuint> textures;   // Texturas del frame; el ndice + 1 es su nmero
+
+    static unsigned int quantizeDepth(float depth) {
+        if (depth <= 0.0f) return 0;
+        float scaled = depth * DEPTH_SCALE;
+        if (scaled >= (float)DEPTH_MAX) return DEPTH_MAX;
+        return (unsigned int)scaled;
+    }
+
+    // Nmero de la textura en este frame. Pasadas las 255 comparten el ltimo.
+    unsigned int textureRank(GLuint texture) {
+        if (texture == 0) return 0;
+        for (size_t i = 0; i < textures.size(); i++) {
+            if (textures[i] == texture) return (unsigned int)i + 1;
+        }
+        if (textures.size() >= TEXTURE_RANK_MAX) return TEXTURE_RANK_MAX;
+        textures.push_back(texture);
+        return (unsigned int)textures.size();
+    }
+
+public:
+    void clear() {
+        items.clear();
+        textures.clear();
+    }
+
+    // Anotar una pieza con la modelview actual. (x, y, z) es un punto
+    // representativo en coordenadas del objeto, para la profundidad.
+    void submit(Drawable* drawable, int part, Pass pass, bool lit, GLuint texture, int material,
+                float x, float y, float z) {
+        Item item;
+        glGetFloatv(GL_MODELVIEW_MATRIX, item.matrix);
+
+        const GLfloat* m = item.matrix;
+        float depth = -(m[2] * x + m[6] * y + m[10] * z + m[14]);
+        unsigned int depthKey = quantizeDepth(depth);
+        if (pass == PASS_TRANSPARENT) {
+            depthKey = DEPTH_MAX - depthKey; // De atrs hacia adelante
+        } else if (pass == PASS_OVERLAY) {
+            depthKey = 0;                    // Solo cuenta el orden de llegada
+        }
+
+        item.key = ((unsigned int)pass << 30) |
+                   ((lit ? 1u : 0u) << 29) |
+                   (textureRank(texture) << 21) |
+                   (((unsigned int)material & 0x1Fu) << 16) |
+                   depthKey;
+        item.order = (int)items.size();
+        item.drawable = drawable;
+        item.part = part;
+        items.push_back(item);
+    }
+
+    // Ordenar y dibujar todo, cada pieza con su matriz. La cola queda vaca.
+    void execute() {
+        sorted.resize(items.size());
+        for (size_t i = 0; i < items.size(); i++) {
+            sorted[i] = &items[i];
+        }
+        std::sort(sorted.begin(), sorted.end(), ItemLess());
+
+        glMatrixMode(GL_MODELVIEW);
+        glPushMatrix();
+        for (size_t i = 0; i < sorted.size(); i++) {
+            glLoadMatrixf(sorted[i]->matrix);
+            sorted[i]->drawable->drawPart(sorted[i]->part);
+        }
+        glPopMatrix();
+
+        clear();
+    }
+
+    int getItemCount() const {
+        return (int)items.size();
+    }
+};
+
+#endif // RENDERQUEUE_H
@@ -0,0 +1,316 @@
+#ifndef RENDERSTATE_H
+#define RENDERSTATE_H
+
+#include <GL/glut.h>
+#include <vector>
+
+// Copia del estado de OpenGL que ms se toca al dibujar: los glEnable ms
+// usados, la textura enlazada, la funcin de blending, la de profundidad y el
+// color actual. Los cambios pasan por ac y los que no cambian nada no llegan
+// al driver. Para que la copia sea fiel todo el cdigo usa estas funciones en
+// lugar de las de OpenGL, glPushAttrib/glPopAttrib incluidos.
+//
+// Cuenta cuntas llamadas se mandaron y cuntas se evitaron en el ltimo frame.
+class RenderState {
+private:
+    // Lo que se sabe de cada valor
+    enum Known {
+        UNKNOWN = -1,
+        OFF = 0,
+        ON = 1
+    };
+
+    enum Cap {
+        CAP_LIGHTING,
+        CAP_LIGHT0,
+        CAP_COLOR_MATERIAL,
+        CAP_NORMALIZE,
+        CAP_TEXTURE_2D,
+        CAP_BLEND,
+        CAP_DEPTH_TEST,
+        CAP_CULL_FACE,
+        CAP_COUNT
+    };
+
+    struct Shadow {
+        int caps[CAP_COUNT];
+        bool textureKnown;
+        GLuint texture;
+        bool blendKnown;
+        GLenum blendSrc;
+        GLenum blendDst;
+        bool depthFuncKnown;
+        GLenum depthFunc;
+        bool colorKnown;
+        GLfloat color[4];
+    };
+
+    struct Saved {
+        GLbitfield mask;
+        Shadow shadow;
+    };
+
+    static Shadow state;
+    static std::vector<Saved> stack;
+    static int recording;   // Grabando una display list: todo pasa, nada se anota
+
+    static int issued;
+    static int dropped;
+    static int lastIssued;
+    static int lastDropped;
+
+    static int capIndex(GLenum cap) {
+        switch (cap) {
+            case GL_LIGHTING:       return CAP_LIGHTING;
+            case GL_LIGHT0:         return CAP_LIGHT0;
+            case GL_COLOR_MATERIAL: return CAP_COLOR_MATERIAL;
+            case GL_NORMALIZE:      return CAP_NORMALIZE;
+            case GL_TEXTURE_2D:     return CAP_TEXTURE_2D;
+            case GL_BLEND:          return CAP_BLEND;
+            case GL_DEPTH_TEST:     return CAP_DEPTH_TEST;
+            case GL_CULL_FACE:      return CAP_CULL_FACE;
+        }
+        return -1;
+    }
+
+    // Grupo de glPushAttrib que guarda cada enable adems de GL_ENABLE_BIT
+    static GLbitfield capGroup(int index) {
+        switch (index) {
+            case CAP_LIGHTING:
+            case CAP_LIGHT0:
+            case CAP_COLOR_MATERIAL: return GL_LIGHTING_BIT;
+            case CAP_NORMALIZE:      return GL_TRANSFORM_BIT;
+            case CAP_TEXTURE_2D:     return GL_TEXTURE_BIT;
+            case CAP_BLEND:          return GL_COLOR_BUFFER_BIT;
+            case CAP_DEPTH_TEST:     return GL_DEPTH_BUFFER_BIT;
+            case CAP_CULL_FACE:      return GL_POLYGON_BIT;
+        }
+        return 0;
+    }
+
+    static void setCap(GLenum cap, int value) {
+        int index = capIndex(cap);
+        if (recording == 0 && index >= 0) {
+            if (state.caps[index] == value) {
+                dropped++;
+                return;
+            }
+            state.caps[index] = value;
+        }
+        issued++;
+        if (value == ON) {
+            glEnable(cap);
+        } else {
+            glDisable(cap);
+        }
+    }
+
+public:
+    // ---- Enables ----
+
+    static void enable(GLenum cap) {
+        setCap(cap, ON);
+    }
+
+    static void disable(GLenum cap) {
+        setCap(cap, OFF);
+    }
+
+    // Como glIsEnabled, pero sin preguntarle al driver si ya se sabe
+    static bool isEnabled(GLenum cap) {
+        int index = capIndex(cap);
+        if (index < 0 || recording > 0) {
+            return glIsEnabled(cap) == GL_TRUE;
+        }
+        if (state.caps[index] == UNKNOWN) {
+            state.caps[index] = glIsEnabled(cap) == GL_TRUE ? ON : OFF;
+        }
+        return state.caps[index] == ON;
+    }
+
+    // ---- Texturas (GL_TEXTURE_2D) ----
+
+    static void bindTexture(GLuint texture) {
+        if (recording == 0) {
+            if (state.textureKnown && state.texture == texture) {
+                dropped++;
+                return;
+            }
+            state.textureKnown = true;
+            state.texture = texture;
+        }
+        issued++;
+        glBindTexture(GL_TEXTURE_2D, texture);
+    }
+
+    // Borrar una textura enlazada vuelve a enlazar la 0
+    static void deleteTextures(GLsizei count, const GLuint* textures) {
+        for (GLsizei i = 0; i < count; i++) {
+            if (state.textureKnown && state.texture == textures[i]) {
+                state.texture = 0;
+            }
+        }
+        glDeleteTextures(count, textures);
+    }
+
+    // ---- Blending y profundidad ----
+
+    static void blendFunc(GLenum src, GLenum dst) {
+        if (recording == 0) {
+            if (state.blendKnown && state.blendSrc == src && state.blendDst == dst) {
+                dropped++;
+                return;
+            }
+            state.blendKnown = true;
+            state.blendSrc = src;
+            state.blendDst = dst;
+        }
+        issued++;
+        glBlendFunc(src, dst);
+    }
+
+    static void depthFunc(GLenum func) {
+        if (recording == 0) {
+            if (state.depthFuncKnown && state.depthFunc == func) {
+                dropped++;
+                return;
+            }
+            state.depthFuncKnown = true;
+            state.depthFunc = func;
+        }
+        issued++;
+        glDepthFunc(func);
+    }
+
+    // ---- Color actual ----
+
+    static void color(GLfloat r, GLfloat g, GLfloat b, GLfloat a = 1.0f) {
+        if (recording == 0) {
+            if (state.colorKnown && state.color[0] == r && state.color[1] == g &&
+                state.color[2] == b && state.color[3] == a) {
+                dropped++;
+                return;
+            }
+            state.colorKnown = true;
+            state.color[0] = r;
+            state.color[1] = g;
+            state.color[2] = b;
+            state.color[3] = a;
+        }
+        issued++;
+        glColor4f(r, g, b, a);
+    }
+
+    static void color3v(const GLfloat* rgb) {
+        color(rgb[0], rgb[1], rgb[2], 1.0f);
+    }
+
+    static void color4v(const GLfloat* rgba) {
+        color(rgba[0], rgba[1], rgba[2], rgba[3]);
+    }
+
+    // Los arrays de colores dejan el color actual indefinido
+    static void invalidateColor() {
+        state.colorKnown = false;
+    }
+
+    // ---- Pila de atributos ----
+
+    static void pushAttrib(GLbitfield mask) {
+        glPushAttrib(mask);
+        if (recording > 0) return;
+
+        Saved saved;
+        saved.mask = mask;
+        saved.shadow = state;
+        stack.push_back(saved);
+    }
+
+    // Lo que restaura glPopAttrib vuelve a lo que se saba en el push
+    static void popAttrib() {
+        glPopAttrib();
+        if (recording > 0) return;
+        if (stack.empty()) {
+            invalidate();
+            return;
+        }
+
+        const Saved& saved = stack.back();
+        GLbitfield mask = saved.mask;
+        for (int i = 0; i < CAP_COUNT; i++) {
+            if (mask & (GL_ENABLE_BIT | capGroup(i))) {
+                state.caps[i] = saved.shadow.caps[i];
+            }
+        }
+        if (mask & GL_TEXTURE_BIT) {
+            state.textureKnown = saved.shadow.textureKnown;
+            state.texture = saved.shadow.texture;
+        }
+        if (mask & GL_COLOR_BUFFER_BIT) {
+            state.blendKnown = saved.shadow.blendKnown;
+            state.blendSrc = saved.shadow.blendSrc;
+            state.blendDst = saved.shadow.blendDst;
+        }
+        if (mask & GL_DEPTH_BUFFER_BIT) {
+            state.depthFuncKnown = saved.shadow.depthFuncKnown;
+            state.depthFunc = saved.shadow.depthFunc;
+        }
+        if (mask & GL_CURRENT_BIT) {
+            state.colorKnown = saved.shadow.colorKnown;
+            for (int k = 0; k < 4; k++) state.color[k] = saved.shadow.color[k];
+        }
+        stack.pop_back();
+    }
+
+    // ---- Display lists ----
+
+    // Mientras se compila una lista nada se ejecuta, as que la copia no cambia
+    static void beginRecording() {
+        recording++;
+    }
+
+    static void endRecording() {
+        if (recording > 0) recording--;
+    }
+
+    // Despus de glCallList (o de cualquier OpenGL directo) no se sabe nada
+    static void invalidate() {
+        for (int i = 0; i < CAP_COUNT; i++) state.caps[i] = UNKNOWN;
+        state.textureKnown = false;
+        state.blendKnown = false;
+        state.depthFuncKnown = false;
+        state.colorKnown = false;
+    }
+
+    // ---- Estadsticas ----
+
+    // Al empezar cada frame: cierra las cuentas del anterior. Tambin olvida lo
+    // que saba, por si algo cambi el estado por fuera entre frames.
+    static void beginFrame() {
+        invalidate();
+        lastIssued = issued;
+        lastDropped = dropped;
+        issued = 0;
+        dropped = 0;
+    }
+
+    static int getIssuedCalls() {
+        return lastIssued;
+    }
+
+    static int getDroppedCalls() {
+        return lastDropped;
+    }
+};
+
+RenderState::Shadow RenderState::state = {
+    { -1, -1, -1, -1, -1, -1, -1, -1 }, false, 0, false, 0, 0, false, 0, false, { 0.0f, 0.0f, 0.0f, 0.0f }
+};
+std::vector<RenderState::Saved> RenderState::stack;
+int RenderState::recording = 0;
+int RenderState::issued = 0;
+int RenderState::dropped = 0;
+int RenderState::lastIssued = 0;
+int RenderState::lastDropped = 0;
+
+#endif // RENDERSTATE_H
@@ -0,0 +1,261 @@
+#ifndef STATICBATCH_H
+#define STATICBATCH_H
+
+#include <GL/glut.h>
+#include <vector>
+#include <cmath>
+#include "glextensions.h"
+#include "meshbuilder.h"
+#include "lightingshader.h"
+#include "renderstate.h"
+#include "renderqueue.h"
+
+// Geometra esttica horneada en coordenadas de mundo: un vertex buffer y un
+// index buffer por material, as todo el escenario se dibuja con una llamada
+// por material. Cada objeto conserva sus rangos de ndices para poder
+// ocultarlo (culling) sin reconstruir nada.
+//
+// Cada material es una pieza para la RenderQueue, con su textura y el centro
+// de su geometra para ordenar por profundidad.
+class StaticBatch : public Drawable {
+private:
+    struct Batch {
+        MeshMaterial material;
+        GLuint vertexBuffer;
+        GLuint indexBuffer;
+        int indexCount;
+        std::vector<int> rangeIds; // Rangos de este material, en orden de ndice
+        float center[3];           // Centro de la caja de sus vrtices
+
+        // Copia en memoria si el driver no tiene vertex buffer objects
+        std::vector<MeshVertex> vertices;
+        std::vector<GLuint> indices;
+    };
+
+    std::vector<Batch> batches;
+    std::vector<MeshRange> ranges;
+    std::vector<MeshObject> objects;
+    std::vector<int> rangeObject;   // Objeto dueo de cada rango
+    std::vector<bool> objectVisible;
+    bool built;
+    bool useBuffers;
+    bool lighting;
+    int drawCalls;
+
+    // Sin copias: los buffers de OpenGL tienen un solo dueo
+    StaticBatch(const StaticBatch&);
+    StaticBatch& operator=(const StaticBatch&);
+
+    void drawIndices(const Batch& batch, int firstIndex, int count) {
+        if (useBuffers) {
+            glDrawElements(batch.material.primitive, count, GL_UNSIGNED_INT,
+                           (const GLuint*)NULL + firstIndex);
+        } else {
+            glDrawElements(batch.material.primitive, count, GL_UNSIGNED_INT,
+                           &batch.indices[firstIndex]);
+        }
+        drawCalls++;
+    }
+
+    bool hasVisibleRange(const Batch& batch) const {
+        for (size_t k = 0; k < batch.rangeIds.size(); k++) {
+            int owner = rangeObject[batch.rangeIds[k]];
+            if (owner < 0 || objectVisible[owner]) return true;
+        }
+        return false;
+    }
+
+public:
+    StaticBatch() : built(false), useBuffers(false), lighting(true), drawCalls(0) {}
+
+    ~StaticBatch() {
+        release();
+    }
+
+    bool isBuilt() const {
+        return built;
+    }
+
+    // Subir lo grabado en 'mesh'. Necesita el contexto de OpenGL activo.
+    void build(const MeshBuilder& mesh) {
+        release();
+
+        GLExtensions::load();
+        useBuffers = GLExtensions::hasVertexBuffers();
+
+        const std::vector<MeshBucket>& buckets = mesh.getBuckets();
+        ranges = mesh.getRanges();
+        objects = mesh.getObjects();
+        objectVisible.assign(objects.size(), true);
+
+        rangeObject.assign(ranges.size(), -1);
+        for (size_t o = 0; o < objects.size(); o++) {
+            for (int r = 0; r < objects[o].rangeCount; r++) {
+                rangeObject[objects[o].firstRange + r] = (int)o;
+            }
+        }
+
+        batches.resize(buckets.size());
+        for (size_t i = 0; i < buckets.size(); i++) {
+            const MeshBucket& bucket = buckets[i];
+            Batch& batch = batches[i];
+            batch.material = bucket.material;
+            batch.vertexBuffer = 0;
+            batch.indexBuffer = 0;
+            batch.indexCount = (int)bucket.indices.size();
+            batch.center[0] = batch.center[1] = batch.center[2] = 0.0f;
+            if (bucket.indices.empty()) continue;
+
+            float minPos[3] = { bucket.vertices[0].position[0], bucket.vertices[0].position[1], bucket.vertices[0].position[2] };
+            float maxPos[3] = { minPos[0], minPos[1], minPos[2] };
+            for (size_t v = 1; v < bucket.vertices.size(); v++) {
+                for (int k = 0; k < 3; k++) {
+                    minPos[k] = fminf(minPos[k], bucket.vertices[v].position[k]);
+                    maxPos[k] = fmaxf(maxPos[k], bucket.vertices[v].position[k]);
+                }
+            }
+            for (int k = 0; k < 3; k++) batch.center[k] = (minPos[k] + maxPos[k]) * 0.5f;
+
+            if (useBuffers) {
+                GLExtensions::genBuffers(1, &batch.vertexBuffer);
+                GLExtensions::bindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer);
+                GLExtensions::bufferData(GL_ARRAY_BUFFER, bucket.vertices.size() * sizeof(MeshVertex),
+                                         &bucket.vertices[0], GL_STATIC_DRAW);
+
+                GLExtensions::genBuffers(1, &batch.indexBuffer);
+                GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.indexBuffer);
+                GLExtensions::bufferData(GL_ELEMENT_ARRAY_BUFFER, bucket.indices.size() * sizeof(GLuint),
+                                         &bucket.indices[0], GL_STATIC_DRAW);
+            } else {
+                batch.vertices = bucket.vertices;
+                batch.indices = bucket.indices;
+            }
+        }
+        if (useBuffers) {
+            GLExtensions::bindBuffer(GL_ARRAY_BUFFER, 0);
+            GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+
+        // Los rangos de cada bucket ya vienen ordenados porque los objetos se graban en orden
+        for (size_t r = 0; r < ranges.size(); r++) {
+            batches[ranges[r].bucket].rangeIds.push_back((int)r);
+        }
+
+        built = true;
+    }
+
+    void release() {
+        for (size_t i = 0; i < batches.size(); i++) {
+            if (batches[i].vertexBuffer) GLExtensions::deleteBuffers(1, &batches[i].vertexBuffer);
+            if (batches[i].indexBuffer) GLExtensions::deleteBuffers(1, &batches[i].indexBuffer);
+        }
+        batches.clear();
+        ranges.clear();
+        objects.clear();
+        rangeObject.clear();
+        objectVisible.clear();
+        built = false;
+    }
+
+    // Sin iluminacin (el terreno); por defecto se ilumina
+    void setLighting(bool enabled) {
+        lighting = enabled;
+    }
+
+    // Dibujar los objetos visibles. Los rangos contiguos se juntan, as con
+    // todo visible es una sola llamada por material. Deja el estado como estaba.
+    void draw() {
+        drawCalls = 0;
+        if (!built) return;
+
+        for (size_t i = 0; i < batches.size(); i++) {
+            drawPart((int)i);
+        }
+    }
+
+    // Anotar cada material que tenga algo visible en la cola, con la modelview actual
+    void submit(RenderQueue& queue) {
+        drawCalls = 0;
+        if (!built) return;
+
+        for (size_t i = 0; i < batches.size(); i++) {
+            const Batch& batch = batches[i];
+            if (batch.indexCount == 0 || !hasVisibleRange(batch)) continue;
+
+            queue.submit(this, (int)i, RenderQueue::PASS_OPAQUE, lighting, batch.material.texture, (int)i,
+                         batch.center[0], batch.center[1], batch.center[2]);
+        }
+    }
+
+    // Un material, con su estado. Deja el estado como estaba.
+    virtual void drawPart(int part) {
+        const Batch& batch = batches[part];
+        if (batch.indexCount == 0) return;
+
+        RenderState::pushAttrib(GL_ENABLE_BIT | GL_LINE_BIT | GL_TEXTURE_BIT | GL_LIGHTING_BIT | GL_CURRENT_BIT);
+        glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+        if (!lighting) {
+            RenderState::disable(GL_LIGHTING);
+        }
+        LightingShader::begin();
+
+        batch.material.apply();
+        LightingShader::sync();
+        if (useBuffers) {
+            GLExtensions::bindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer);
+            GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.indexBuffer);
+            MeshBuilder::setVertexArrays(NULL, batch.material.texture != 0);
+        } else {
+            MeshBuilder::setVertexArrays(&batch.vertices[0], batch.material.texture != 0);
+        }
+
+        int runStart = -1;
+        int runEnd = -1;
+        for (size_t k = 0; k < batch.rangeIds.size(); k++) {
+            int r = batch.rangeIds[k];
+            int owner = rangeObject[r];
+            if (owner >= 0 && !objectVisible[owner]) continue;
+
+            const MeshRange& range = ranges[r];
+            if (range.firstIndex == runEnd) {
+                runEnd += range.indexCount;
+            } else {
+                if (runStart >= 0) drawIndices(batch, runStart, runEnd - runStart);
+                runStart = range.firstIndex;
+                runEnd = range.firstIndex + range.indexCount;
+            }
+        }
+        if (runStart >= 0) drawIndices(batch, runStart, runEnd - runStart);
+
+        if (useBuffers) {
+            GLExtensions::bindBuffer(GL_ARRAY_BUFFER, 0);
+            GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+        LightingShader::end();
+        glPopClientAttrib();
+        RenderState::popAttrib();
+    }
+
+    // ---- Objetos ----
+
+    int getObjectCount() const {
+        return (int)objects.size();
+    }
+
+    const MeshObject& getObject(int id) const {
+        return objects[id];
+    }
+
+    void setObjectVisible(int id, bool visible) {
+        if (id >= 0 && id < (int)objectVisible.size()) {
+            objectVisible[id] = visible;
+        }
+    }
+
+    // Llamadas a glDrawElements desde el ltimo draw() o submit()
+    int getDrawCallCount() const {
+        return drawCalls;
+    }
+};
+
+#endif // STATICBATCH_H
@@ -6,6 +6,13 @@
 #include <GL/glu.h>
 #include <iostream>
 #include <fstream>
+#include <vector>
+#include "glextensions.h"
+#include "renderstate.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 // Define M_PI if it's not already defined (common in Visual Studio)
 #ifndef M_PI
@@ -129,9 +136,130 @@ public:
     }
 };
 
+// Builds the full mip chain of an image with a 2x2 box filter, so distant
+// surfaces sample a small level instead of the whole level 0. Levels are kept
+// as RGBA so each pixel is 4 bytes and two output pixels fit one SSE2 register.
+class MipmapBuilder {
+private:
+    // One output row from two input rows (the same row twice when the image is 1 pixel tall)
+    static void halveRow(const GLubyte* row0, const GLubyte* row1, int srcWidth, GLubyte* out, int dstWidth) {
+        int x = 0;
+#ifdef __SSE2__
+        if (srcWidth >= 2 * dstWidth) {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i round = _mm_set1_epi16(2);
+            for (; x + 2 <= dstWidth; x += 2) {
+                // Four source pixels from each row give two output pixels
+                __m128i a = _mm_loadu_si128((const __m128i*)(row0 + x * 8));
+                __m128i b = _mm_loadu_si128((const __m128i*)(row1 + x * 8));
+                __m128i low = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+                __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+                low = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+                high = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+                __m128i sum = _mm_unpacklo_epi64(low, high);
+                sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 2);
+                _mm_storel_epi64((__m128i*)(out + x * 4), _mm_packus_epi16(sum, zero));
+            }
+        }
+#endif
+        for (; x < dstWidth; x++) {
+            int x0 = 2 * x;
+            int x1 = (x0 + 1 < srcWidth) ? x0 + 1 : x0;
+            for (int c = 0; c < 4; c++) {
+                out[x * 4 + c] = (GLubyte)((row0[x0 * 4 + c] + row0[x1 * 4 + c] +
+                                            row1[x0 * 4 + c] + row1[x1 * 4 + c] + 2) >> 2);
+            }
+        }
+    }
+
+public:
+    static void halve(const GLubyte* src, int srcWidth, int srcHeight, GLubyte* dst, int dstWidth, int dstHeight) {
+        for (int y = 0; y < dstHeight; y++) {
+            int y0 = 2 * y;
+            int y1 = (y0 + 1 < srcHeight) ? y0 + 1 : y0;
+            halveRow(src + y0 * srcWidth * 4, src + y1 * srcWidth * 4, srcWidth, dst + y * dstWidth * 4, dstWidth);
+        }
+    }
+
+    // Upload 'rgb' as level 0 of the bound texture and every smaller level down to 1x1
+    static void upload(const GLubyte* rgb, int width, int height) {
+        std::vector<GLubyte> level(width * height * 4);
+        for (int i = 0; i < width * height; i++) {
+            level[i * 4] = rgb[i * 3];
+            level[i * 4 + 1] = rgb[i * 3 + 1];
+            level[i * 4 + 2] = rgb[i * 3 + 2];
+            level[i * 4 + 3] = 255;
+        }
+
+        std::vector<GLubyte> next;
+        int lod = 0;
+        for (;;) {
+            glTexImage2D(GL_TEXTURE_2D, lod, GL_RGB, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, &level[0]);
+            if (width == 1 && height == 1) break;
+
+            int nextWidth = (width > 1) ? width / 2 : 1;
+            int nextHeight = (height > 1) ? height / 2 : 1;
+            next.resize(nextWidth * nextHeight * 4);
+            halve(&level[0], width, height, &next[0], nextWidth, nextHeight);
+
+            level.swap(next);
+            width = nextWidth;
+            height = nextHeight;
+            lod++;
+        }
+    }
+};
+
 // Texture Manager Class for handling OpenGL textures
 class TextureManager {
+private:
+    static float anisotropy;
+    static std::vector<GLuint> mipmapped;  // Textures that take the anisotropy setting
+
+    // Set the anisotropy on the bound texture, clamped to what the driver supports
+    static void applyAnisotropy() {
+        float maxAnisotropy = GLExtensions::getMaxAnisotropy();
+        if (maxAnisotropy <= 1.0f) return;
+        float level = anisotropy < 1.0f ? 1.0f : anisotropy;
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT,
+                        level < maxAnisotropy ? level : maxAnisotropy);
+    }
+
 public:
+    // Anisotropic filtering for mipmapped textures (1 = off, the default).
+    // Textures already loaded are updated too, so it needs the GL context
+    // once anything has been loaded.
+    static void setAnisotropy(float level) {
+        if (level == anisotropy) return;
+        anisotropy = level;
+        for (size_t i = 0; i < mipmapped.size(); i++) {
+            RenderState::bindTexture(mipmapped[i]);
+            applyAnisotropy();
+        }
+    }
+
+    static float getAnisotropy() {
+        return anisotropy;
+    }
+
+    // Upload an RGB image to the bound texture with its mip chain and trilinear filtering.
+    // Delete the texture with deleteTexture() so it leaves the anisotropy list.
+    static void uploadMipmapped(const GLubyte* rgb, int width, int height) {
+        MipmapBuilder::upload(rgb, width, height);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        GLint bound = 0;
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound);
+        if (bound != 0) {
+            mipmapped.push_back((GLuint)bound);
+        }
+        if (anisotropy > 1.0f) {
+            applyAnisotropy();
+        }
+    }
+
     // Load a texture from BMP file and return texture ID
     static GLuint loadTexture(const char* filename) {
         int width, height;
@@ -144,16 +272,14 @@ public:
         
         GLuint textureID;
         glGenTextures(1, &textureID);
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        RenderState::bindTexture(textureID);
         
         // Set texture parameters
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
         
-        // Upload the texture data
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, imageData);
+        // Upload the texture data with its mipmaps
+        uploadMipmapped(imageData, width, height);
         
         // Clean up
         delete[] imageData;
@@ -165,7 +291,13 @@ public:
     // Delete a texture
     static void deleteTexture(GLuint& textureID) {
         if (textureID != 0) {
-            glDeleteTextures(1, &textureID);
+            for (size_t i = 0; i < mipmapped.size(); i++) {
+                if (mipmapped[i] == textureID) {
+                    mipmapped.erase(mipmapped.begin() + i);
+                    break;
+                }
+            }
+            RenderState::deleteTextures(1, &textureID);
             textureID = 0;
         }
     }
@@ -173,18 +305,21 @@ public:
     // Bind a texture for rendering
     static void bindTexture(GLuint textureID) {
         if (textureID != 0) {
-            glEnable(GL_TEXTURE_2D);
-            glBindTexture(GL_TEXTURE_2D, textureID);
+            RenderState::enable(GL_TEXTURE_2D);
+            RenderState::bindTexture(textureID);
         } else {
-            glDisable(GL_TEXTURE_2D);
+            RenderState::disable(GL_TEXTURE_2D);
         }
     }
     
     // Unbind all textures
     static void unbindTexture() {
-        glDisable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        RenderState::disable(GL_TEXTURE_2D);
+        RenderState::bindTexture(0);
     }
 };
 
+float TextureManager::anisotropy = 1.0f;
+std::vector<GLuint> TextureManager::mipmapped;
+
 #endif // TEXTURE_H
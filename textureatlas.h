@@ -0,0 +1,305 @@
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <GL/glut.h>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "glextensions.h"
+#include "meshbuilder.h"
+#include "renderstate.h"
+#include "texture.h"
+
+// Un rectngulo de una textura. Lo que se dibuja con coordenadas 0..1 usa
+// solo esa parte: en el batch esttico se reescriben las coordenadas al
+// grabar, y en modo inmediato (o con las mallas de PrimitiveCache) se hace con
+// la matriz de textura.
+struct AtlasRegion {
+    GLuint texture;     // 0 = sin textura
+    float u0, v0, u1, v1;
+    bool shared;        // Es parte de un atlas: no la borra quien la usa
+
+    AtlasRegion() : texture(0), u0(0.0f), v0(0.0f), u1(1.0f), v1(1.0f), shared(false) {}
+
+    // Enlazar la textura y llevar el 0..1 al rectngulo con la matriz de textura
+    void bind() const {
+        TextureManager::bindTexture(texture);
+        glMatrixMode(GL_TEXTURE);
+        glLoadIdentity();
+        glTranslatef(u0, v0, 0.0f);
+        glScalef(u1 - u0, v1 - v0, 1.0f);
+        glMatrixMode(GL_MODELVIEW);
+    }
+
+    // Volver a la matriz de textura identidad y sin textura
+    void unbind() const {
+        glMatrixMode(GL_TEXTURE);
+        glLoadIdentity();
+        glMatrixMode(GL_MODELVIEW);
+        TextureManager::unbindTexture();
+    }
+
+    // Lo mismo al grabar geometra: las coordenadas quedan ya dentro del rectngulo
+    void bind(MeshBuilder& mesh) const {
+        mesh.bindTexture(texture, u0, v0, u1, v1);
+    }
+};
+
+// Junta varias imgenes BMP en una sola textura, as los objetos que las usan
+// comparten material (una sola tanda en el batch esttico y en la cola de
+// dibujo) en lugar de cambiar de textura cada uno.
+//
+// Cada imagen queda alineada a 8 texels con un borde de 8 texels que repite
+// sus pixels de los costados. Los mipmaps se cortan en el nivel 3: hasta ah
+// cada imagen sigue empezando en un texel propio y conserva al menos un texel
+// de borde, as el filtrado no mezcla imgenes vecinas.
+//
+// Solo sirve para coordenadas entre 0 y 1: lo que repite la textura (GL_REPEAT)
+// necesita una textura propia.
+class TextureAtlas {
+public:
+    static const int MAX_LEVEL = 3;
+    static const int PADDING = 1 << MAX_LEVEL;
+
+private:
+    struct Image {
+        std::string filename;
+        GLubyte* pixels;    // RGB, la fila 0 es v = 0
+        int width;
+        int height;
+        int x, y;           // Esquina dentro del atlas
+        bool placed;
+    };
+
+    struct TallerFirst {
+        const std::vector<Image>* images;
+        bool operator()(int a, int b) const {
+            return (*images)[a].height > (*images)[b].height;
+        }
+    };
+
+    std::vector<Image> images;
+    GLuint texture;
+    int width;
+    int height;
+
+    // Sin copias: la textura tiene un solo dueo
+    TextureAtlas(const TextureAtlas&);
+    TextureAtlas& operator=(const TextureAtlas&);
+
+    static int alignUp(int value) {
+        return (value + PADDING - 1) / PADDING * PADDING;
+    }
+
+    // Estantes de izquierda a derecha, las imgenes ms altas primero
+    bool pack(const std::vector<int>& order, int atlasWidth, int atlasHeight) {
+        int shelfX = 0;
+        int shelfY = 0;
+        int shelfHeight = 0;
+        for (size_t k = 0; k < order.size(); k++) {
+            Image& image = images[order[k]];
+            int cellWidth = alignUp(image.width) + 2 * PADDING;
+            int cellHeight = alignUp(image.height) + 2 * PADDING;
+            if (cellWidth > atlasWidth) return false;
+
+            if (shelfX + cellWidth > atlasWidth) {
+                shelfY += shelfHeight;
+                shelfX = 0;
+                shelfHeight = 0;
+            }
+            if (shelfY + cellHeight > atlasHeight) return false;
+
+            image.x = shelfX + PADDING;
+            image.y = shelfY + PADDING;
+            shelfX += cellWidth;
+            if (cellHeight > shelfHeight) shelfHeight = cellHeight;
+        }
+        return true;
+    }
+
+    static int clampIndex(int value, int size) {
+        return value < 0 ? 0 : (value >= size ? size - 1 : value);
+    }
+
+    // Copiar la imagen y repetir sus bordes en el margen
+    void blit(const Image& image, std::vector<GLubyte>& atlas) const {
+        for (int y = image.y - PADDING; y < image.y + image.height + PADDING; y++) {
+            int srcY = clampIndex(y - image.y, image.height);
+            for (int x = image.x - PADDING; x < image.x + image.width + PADDING; x++) {
+                int srcX = clampIndex(x - image.x, image.width);
+                const GLubyte* src = image.pixels + (srcY * image.width + srcX) * 3;
+                GLubyte* dst = &atlas[(y * width + x) * 3];
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+            }
+        }
+    }
+
+    void freeImages() {
+        for (size_t i = 0; i < images.size(); i++) {
+            delete[] images[i].pixels;
+            images[i].pixels = NULL;
+        }
+    }
+
+public:
+    TextureAtlas() : texture(0), width(0), height(0) {}
+
+    ~TextureAtlas() {
+        release();
+    }
+
+    // Anotar una imagen para el prximo build()
+    void add(const char* filename) {
+        Image image;
+        image.filename = filename;
+        image.pixels = NULL;
+        image.width = image.height = 0;
+        image.x = image.y = 0;
+        image.placed = false;
+        images.push_back(image);
+    }
+
+    // Cargar las imgenes, acomodarlas y subir el atlas. Necesita el contexto
+    // de OpenGL. Las que no se pueden cargar o no entran quedan afuera.
+    bool build() {
+        TextureManager::deleteTexture(texture);
+
+        std::vector<int> order;
+        for (size_t i = 0; i < images.size(); i++) {
+            Image& image = images[i];
+            image.placed = false;
+            image.pixels = BMPLoader::loadBMP(image.filename.c_str(), image.width, image.height);
+            if (image.pixels != NULL) order.push_back((int)i);
+        }
+        if (order.empty()) return false;
+
+        TallerFirst taller;
+        taller.images = &images;
+        std::stable_sort(order.begin(), order.end(), taller);
+
+        GLint maxSize = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+        if (maxSize <= 0) maxSize = 1024;
+
+        // Crecer de a una dimensin por vez hasta que entre todo
+        width = height = 64;
+        while (!pack(order, width, height)) {
+            if (width <= height && width < maxSize) {
+                width *= 2;
+            } else if (height < maxSize) {
+                height *= 2;
+            } else {
+                // Ni con el tamao mximo: se dejan afuera las ltimas
+                order.pop_back();
+                width = height = 64;
+                if (order.empty()) {
+                    freeImages();
+                    return false;
+                }
+            }
+        }
+
+        std::vector<GLubyte> pixels(width * height * 3, 0);
+        for (size_t k = 0; k < order.size(); k++) {
+            images[order[k]].placed = true;
+            blit(images[order[k]], pixels);
+        }
+        freeImages();
+
+        glGenTextures(1, &texture);
+        RenderState::bindTexture(texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        TextureManager::uploadMipmapped(&pixels[0], width, height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, MAX_LEVEL);
+
+        printf("Atlas de texturas: %d de %d imagenes en %dx%d\n",
+               (int)order.size(), (int)images.size(), width, height);
+        return true;
+    }
+
+    // Regin de una imagen anotada; textura 0 si no qued en el atlas
+    AtlasRegion getRegion(const char* filename) const {
+        AtlasRegion region;
+        for (size_t i = 0; i < images.size(); i++) {
+            const Image& image = images[i];
+            if (!image.placed || image.filename != filename) continue;
+
+            region.texture = texture;
+            region.u0 = (float)image.x / width;
+            region.v0 = (float)image.y / height;
+            region.u1 = (float)(image.x + image.width) / width;
+            region.v1 = (float)(image.y + image.height) / height;
+            region.shared = true;
+            break;
+        }
+        return region;
+    }
+
+    GLuint getTexture() const {
+        return texture;
+    }
+
+    void release() {
+        freeImages();
+        TextureManager::deleteTexture(texture);
+        images.clear();
+    }
+};
+
+// Atlas compartido de las texturas chicas de los objetos del escenario. Se
+// arma la primera vez que alguien pide una regin. Los azulejos y el piso de
+// la pileta se repiten sobre la superficie, as que siguen con textura propia.
+class PropAtlas {
+private:
+    static TextureAtlas atlas;
+    static bool built;
+
+    static void build() {
+        if (built) return;
+        built = true;
+
+        const char* files[] = {
+            "barriltexture.bmp", "pelotatexture.bmp", "escaleratexture.bmp",
+            "walltexture.bmp", "doortexture.bmp", "ladrillos.bmp"
+        };
+        for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); i++) {
+            atlas.add(files[i]);
+        }
+        atlas.build();
+    }
+
+public:
+    // Regin de la imagen en el atlas; si no est, una textura propia entera.
+    // Textura 0 si no se pudo cargar.
+    static AtlasRegion load(const char* filename) {
+        build();
+        AtlasRegion region = atlas.getRegion(filename);
+        if (region.texture == 0) {
+            region.texture = TextureManager::loadTexture(filename);
+        }
+        return region;
+    }
+
+    // Borrar la textura de la regin si es propia; el atlas queda
+    static void unload(AtlasRegion& region) {
+        if (!region.shared) {
+            TextureManager::deleteTexture(region.texture);
+        }
+        region = AtlasRegion();
+    }
+
+    // Al cerrar, mientras el contexto sigue vivo
+    static void release() {
+        atlas.release();
+        built = false;
+    }
+};
+
+TextureAtlas PropAtlas::atlas;
+bool PropAtlas::built = false;
+
+#endif // TEXTUREATLAS_H
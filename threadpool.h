@@ -0,0 +1,143 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <windows.h>
+#include <cstdio>
+#include <vector>
+
+// Trabajo que se puede repartir por rangos [begin, end) entre varios hilos.
+// run() se llama desde varios hilos a la vez, con rangos que no se solapan.
+class ParallelTask {
+public:
+    virtual ~ParallelTask() {}
+    virtual void run(int begin, int end) = 0;
+};
+
+// Pool de hilos fijo para repartir trabajo por bloques. Los hilos se crean una
+// sola vez y duermen en un evento entre llamadas; el hilo que llama a
+// parallelFor() tambin trabaja, as que nunca hay ms hilos que ncleos.
+class ThreadPool {
+private:
+    struct Worker {
+        ThreadPool* pool;
+        HANDLE thread;
+        HANDLE wakeEvent;   // Se activa para empezar un parallelFor (auto-reset)
+        HANDLE doneEvent;   // El hilo lo activa al terminar su parte (auto-reset)
+    };
+
+    std::vector<Worker> workers;
+    volatile bool quitting;
+
+    // Trabajo actual. Los bloques se reparten con un contador atmico, as
+    // los hilos que terminan antes toman ms bloques.
+    ParallelTask* currentTask;
+    int taskCount;
+    int taskGrain;
+    volatile LONG nextIndex;
+
+    static DWORD WINAPI workerMain(void* param) {
+        Worker* worker = (Worker*)param;
+        ThreadPool* pool = worker->pool;
+
+        for (;;) {
+            WaitForSingleObject(worker->wakeEvent, INFINITE);
+            if (pool->quitting) break;
+
+            pool->runBlocks();
+            SetEvent(worker->doneEvent);
+        }
+        return 0;
+    }
+
+    void runBlocks() {
+        for (;;) {
+            int begin = (int)InterlockedExchangeAdd(&nextIndex, (LONG)taskGrain);
+            if (begin >= taskCount) break;
+            int end = begin + taskGrain;
+            if (end > taskCount) end = taskCount;
+            currentTask->run(begin, end);
+        }
+    }
+
+    // Sin copias: los hilos guardan punteros a sus Worker
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+public:
+    // threadCount = 0 usa un hilo por ncleo (contando el hilo que llama)
+    ThreadPool(int threadCount = 0) : quitting(false), currentTask(NULL),
+                                      taskCount(0), taskGrain(1), nextIndex(0) {
+        if (threadCount <= 0) {
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            threadCount = (int)info.dwNumberOfProcessors;
+        }
+        if (threadCount > 64) threadCount = 64; // Lmite de WaitForMultipleObjects
+
+        // El hilo que llama cuenta como uno de los trabajadores
+        workers.resize(threadCount > 1 ? threadCount - 1 : 0);
+        for (size_t i = 0; i < workers.size(); ++i) {
+            Worker& worker = workers[i];
+            worker.pool = this;
+            worker.wakeEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+            worker.doneEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+            worker.thread = CreateThread(NULL, 0, workerMain, &worker, 0, NULL);
+            if (!worker.thread) {
+                printf("Error: No se pudo crear el hilo %d del pool\n", (int)i);
+            }
+        }
+    }
+
+    ~ThreadPool() {
+        quitting = true;
+        for (size_t i = 0; i < workers.size(); ++i) {
+            if (workers[i].thread) {
+                SetEvent(workers[i].wakeEvent);
+                WaitForSingleObject(workers[i].thread, INFINITE);
+                CloseHandle(workers[i].thread);
+            }
+            CloseHandle(workers[i].wakeEvent);
+            CloseHandle(workers[i].doneEvent);
+        }
+        workers.clear();
+    }
+
+    // Nmero de hilos que trabajan en un parallelFor (incluido el que llama)
+    int getThreadCount() const {
+        return (int)workers.size() + 1;
+    }
+
+    // Ejecutar task.run() sobre [0, count) en bloques de 'grain' elementos y
+    // esperar a que terminen todos. No se debe llamar desde dentro de una tarea.
+    void parallelFor(int count, int grain, ParallelTask& task) {
+        if (count <= 0) return;
+        if (grain < 1) grain = 1;
+
+        // Con un solo bloque no vale la pena despertar a nadie
+        if (workers.empty() || count <= grain) {
+            task.run(0, count);
+            return;
+        }
+
+        currentTask = &task;
+        taskCount = count;
+        taskGrain = grain;
+        nextIndex = 0;
+
+        std::vector<HANDLE> waiting;
+        for (size_t i = 0; i < workers.size(); ++i) {
+            if (!workers[i].thread) continue;
+            SetEvent(workers[i].wakeEvent);
+            waiting.push_back(workers[i].doneEvent);
+        }
+
+        runBlocks();
+
+        if (!waiting.empty()) {
+            WaitForMultipleObjects((DWORD)waiting.size(), &waiting[0], TRUE, INFINITE);
+        }
+        currentTask = NULL;
+    }
+};
+
+#endif // THREADPOOL_H
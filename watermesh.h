@@ -0,0 +1,375 @@
+#ifndef WATERMESH_H
+#define WATERMESH_H
+
+#include <GL/glut.h>
+#include <cmath>
+#include <vector>
+#include "glextensions.h"
+#include "meshbuilder.h"
+#include "lightingshader.h"
+#include "renderstate.h"
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Superficie de agua circular (malla polar de anillos por segmentos) con ondas.
+//
+// La forma de la malla no cambia: radio, ngulo, x, z y los senos y cosenos de
+// la parte espacial de cada onda se calculan una sola vez. Cada onda es
+// sin(w*t + fase), y como sin(a + b) = sin(a)cos(b) + cos(a)sin(b), por frame
+// solo hacen falta el seno y el coseno de w*t: lo dems es multiplicar y sumar
+// sobre arrays separados por campo (SoA), de a cuatro vrtices con SSE si el
+// compilador lo tiene habilitado. El resultado se sube a un buffer de streaming
+// y se dibuja con una sola llamada indexada.
+class WaterMesh {
+private:
+    // Ondas: frecuencia temporal de cada trmino
+    enum Wave {
+        WAVE_RADIAL,   // sin(2.5t + 6r), tambin da la normal
+        WAVE_ANGULAR,  // sin(1.8t + 3a)
+        WAVE_DIAGONAL, // sin(3.2t + 4x + 4z)
+        WAVE_SLOW,     // sin(4.1t + 2r)
+        WAVE_BRIGHT,   // sin(1.5t + 3r), brillo del color
+        WAVE_TEX_U,    // sin(t + r)
+        WAVE_TEX_V,    // cos(t + a)
+        WAVE_COUNT
+    };
+
+    // Campos por vrtice, cada uno un array de 'stride' floats
+    enum Field {
+        COS_ANGLE, SIN_ANGLE, DEPTH, BASE_U, BASE_V,
+        PHASE_SIN,                        // WAVE_COUNT arrays
+        PHASE_COS = PHASE_SIN + WAVE_COUNT, // WAVE_COUNT arrays
+        OUT_Y = PHASE_COS + WAVE_COUNT,
+        OUT_NX, OUT_NZ, OUT_R, OUT_G, OUT_B, OUT_U, OUT_V,
+        FIELD_COUNT
+    };
+
+    int rings;
+    int segments;
+    int vertexCount;
+    int stride;                 // vertexCount redondeado a mltiplo de 4
+    std::vector<float> fields;  // FIELD_COUNT * stride
+
+    std::vector<MeshVertex> vertices;
+    std::vector<GLuint> indices;
+
+    GLuint vertexBuffer;
+    GLuint indexBuffer;
+    bool useBuffers;
+    bool built;
+
+    // Sin copias: los buffers de OpenGL tienen un solo dueo
+    WaterMesh(const WaterMesh&);
+    WaterMesh& operator=(const WaterMesh&);
+
+    float* field(int f) {
+        return &fields[f * stride];
+    }
+
+    // Una pasada sobre [first, last) con los senos y cosenos de w*t ya calculados
+    void evaluateScalar(int first, int last, const float* st, const float* ct, float amplitude) {
+        const float* cosA = field(COS_ANGLE);
+        const float* sinA = field(SIN_ANGLE);
+        const float* depth = field(DEPTH);
+        const float* baseU = field(BASE_U);
+        const float* baseV = field(BASE_V);
+        const float* ps[WAVE_COUNT];
+        const float* pc[WAVE_COUNT];
+        for (int w = 0; w < WAVE_COUNT; w++) {
+            ps[w] = field(PHASE_SIN + w);
+            pc[w] = field(PHASE_COS + w);
+        }
+        float* outY = field(OUT_Y);
+        float* outNX = field(OUT_NX);
+        float* outNZ = field(OUT_NZ);
+        float* outR = field(OUT_R);
+        float* outG = field(OUT_G);
+        float* outB = field(OUT_B);
+        float* outU = field(OUT_U);
+        float* outV = field(OUT_V);
+
+        for (int i = first; i < last; i++) {
+            float radial = st[WAVE_RADIAL] * pc[WAVE_RADIAL][i] + ct[WAVE_RADIAL] * ps[WAVE_RADIAL][i];
+            float radialCos = ct[WAVE_RADIAL] * pc[WAVE_RADIAL][i] - st[WAVE_RADIAL] * ps[WAVE_RADIAL][i];
+            float angular = st[WAVE_ANGULAR] * pc[WAVE_ANGULAR][i] + ct[WAVE_ANGULAR] * ps[WAVE_ANGULAR][i];
+            float diagonal = st[WAVE_DIAGONAL] * pc[WAVE_DIAGONAL][i] + ct[WAVE_DIAGONAL] * ps[WAVE_DIAGONAL][i];
+            float slow = st[WAVE_SLOW] * pc[WAVE_SLOW][i] + ct[WAVE_SLOW] * ps[WAVE_SLOW][i];
+            float bright = st[WAVE_BRIGHT] * pc[WAVE_BRIGHT][i] + ct[WAVE_BRIGHT] * ps[WAVE_BRIGHT][i];
+            float texU = st[WAVE_TEX_U] * pc[WAVE_TEX_U][i] + ct[WAVE_TEX_U] * ps[WAVE_TEX_U][i];
+            float texV = ct[WAVE_TEX_V] * pc[WAVE_TEX_V][i] - st[WAVE_TEX_V] * ps[WAVE_TEX_V][i];
+
+            outY[i] = amplitude * (radial + 0.6f * angular + 0.5f * diagonal + 0.3f * slow);
+
+            float shade = depth[i] * (0.5f + 0.3f * bright);
+            outR[i] = 0.05f + 0.15f * shade;
+            outG[i] = 0.25f + 0.35f * shade;
+            outB[i] = 0.7f + 0.2f * shade;
+
+            outNX[i] = -0.4f * radialCos * cosA[i];
+            outNZ[i] = -0.4f * radialCos * sinA[i];
+
+            outU[i] = baseU[i] + 0.1f * texU;
+            outV[i] = baseV[i] + 0.1f * texV;
+        }
+    }
+
+#ifdef __SSE__
+    // Lo mismo que evaluateScalar, de a cuatro vrtices. 'stride' es mltiplo
+    // de 4, as no queda cola.
+    void evaluateSSE(const float* st, const float* ct, float amplitude) {
+        const float* cosA = field(COS_ANGLE);
+        const float* sinA = field(SIN_ANGLE);
+        const float* depth = field(DEPTH);
+        const float* baseU = field(BASE_U);
+        const float* baseV = field(BASE_V);
+        const float* ps[WAVE_COUNT];
+        const float* pc[WAVE_COUNT];
+        __m128 vst[WAVE_COUNT];
+        __m128 vct[WAVE_COUNT];
+        for (int w = 0; w < WAVE_COUNT; w++) {
+            ps[w] = field(PHASE_SIN + w);
+            pc[w] = field(PHASE_COS + w);
+            vst[w] = _mm_set1_ps(st[w]);
+            vct[w] = _mm_set1_ps(ct[w]);
+        }
+        float* outY = field(OUT_Y);
+        float* outNX = field(OUT_NX);
+        float* outNZ = field(OUT_NZ);
+        float* outR = field(OUT_R);
+        float* outG = field(OUT_G);
+        float* outB = field(OUT_B);
+        float* outU = field(OUT_U);
+        float* outV = field(OUT_V);
+
+        const __m128 amp = _mm_set1_ps(amplitude);
+        const __m128 k06 = _mm_set1_ps(0.6f);
+        const __m128 k05 = _mm_set1_ps(0.5f);
+        const __m128 k03 = _mm_set1_ps(0.3f);
+        const __m128 k01 = _mm_set1_ps(0.1f);
+        const __m128 kNormal = _mm_set1_ps(-0.4f);
+
+        for (int i = 0; i < stride; i += 4) {
+            #define WAVE_SIN(w) _mm_add_ps(_mm_mul_ps(vst[w], _mm_loadu_ps(pc[w] + i)), \
+                                           _mm_mul_ps(vct[w], _mm_loadu_ps(ps[w] + i)))
+            #define WAVE_COS(w) _mm_sub_ps(_mm_mul_ps(vct[w], _mm_loadu_ps(pc[w] + i)), \
+                                           _mm_mul_ps(vst[w], _mm_loadu_ps(ps[w] + i)))
+            __m128 radial = WAVE_SIN(WAVE_RADIAL);
+            __m128 radialCos = WAVE_COS(WAVE_RADIAL);
+            __m128 angular = WAVE_SIN(WAVE_ANGULAR);
+            __m128 diagonal = WAVE_SIN(WAVE_DIAGONAL);
+            __m128 slow = WAVE_SIN(WAVE_SLOW);
+            __m128 bright = WAVE_SIN(WAVE_BRIGHT);
+            __m128 texU = WAVE_SIN(WAVE_TEX_U);
+            __m128 texV = WAVE_COS(WAVE_TEX_V);
+            #undef WAVE_SIN
+            #undef WAVE_COS
+
+            __m128 height = _mm_add_ps(_mm_add_ps(radial, _mm_mul_ps(k06, angular)),
+                                       _mm_add_ps(_mm_mul_ps(k05, diagonal), _mm_mul_ps(k03, slow)));
+            _mm_storeu_ps(outY + i, _mm_mul_ps(amp, height));
+
+            __m128 shade = _mm_mul_ps(_mm_loadu_ps(depth + i), _mm_add_ps(k05, _mm_mul_ps(k03, bright)));
+            _mm_storeu_ps(outR + i, _mm_add_ps(_mm_set1_ps(0.05f), _mm_mul_ps(_mm_set1_ps(0.15f), shade)));
+            _mm_storeu_ps(outG + i, _mm_add_ps(_mm_set1_ps(0.25f), _mm_mul_ps(_mm_set1_ps(0.35f), shade)));
+            _mm_storeu_ps(outB + i, _mm_add_ps(_mm_set1_ps(0.7f), _mm_mul_ps(_mm_set1_ps(0.2f), shade)));
+
+            __m128 normal = _mm_mul_ps(kNormal, radialCos);
+            _mm_storeu_ps(outNX + i, _mm_mul_ps(normal, _mm_loadu_ps(cosA + i)));
+            _mm_storeu_ps(outNZ + i, _mm_mul_ps(normal, _mm_loadu_ps(sinA + i)));
+
+            _mm_storeu_ps(outU + i, _mm_add_ps(_mm_loadu_ps(baseU + i), _mm_mul_ps(k01, texU)));
+            _mm_storeu_ps(outV + i, _mm_add_ps(_mm_loadu_ps(baseV + i), _mm_mul_ps(k01, texV)));
+        }
+    }
+#endif
+
+public:
+    WaterMesh() : rings(0), segments(0), vertexCount(0), stride(0),
+                  vertexBuffer(0), indexBuffer(0), useBuffers(false), built(false) {}
+
+    ~WaterMesh() {
+        release();
+    }
+
+    bool isBuilt() const {
+        return built;
+    }
+
+    // Malla de 'ringCount' anillos (el primero en el centro) por 'segmentCount'
+    // segmentos. Necesita el contexto de OpenGL activo.
+    void build(int ringCount, int segmentCount, float radius) {
+        release();
+
+        GLExtensions::load();
+        useBuffers = GLExtensions::hasVertexBuffers();
+
+        rings = ringCount;
+        segments = segmentCount;
+        vertexCount = rings * (segments + 1);
+        stride = (vertexCount + 3) & ~3;
+        fields.assign(FIELD_COUNT * stride, 0.0f);
+        vertices.resize(vertexCount);
+
+        float* cosA = field(COS_ANGLE);
+        float* sinA = field(SIN_ANGLE);
+        float* depth = field(DEPTH);
+        float* baseU = field(BASE_U);
+        float* baseV = field(BASE_V);
+
+        for (int i = 0; i < rings; i++) {
+            for (int j = 0; j <= segments; j++) {
+                int v = i * (segments + 1) + j;
+                float angle = 2.0f * (float)M_PI * j / segments;
+                float r = radius * i / (rings - 1);
+                float x = r * cosf(angle);
+                float z = r * sinf(angle);
+
+                cosA[v] = cosf(angle);
+                sinA[v] = sinf(angle);
+                depth[v] = 1.0f - r / radius;
+                baseU[v] = x * 0.5f + 0.5f;
+                baseV[v] = z * 0.5f + 0.5f;
+
+                float phase[WAVE_COUNT];
+                phase[WAVE_RADIAL] = r * 6.0f;
+                phase[WAVE_ANGULAR] = angle * 3.0f;
+                phase[WAVE_DIAGONAL] = x * 4.0f + z * 4.0f;
+                phase[WAVE_SLOW] = r * 2.0f;
+                phase[WAVE_BRIGHT] = r * 3.0f;
+                phase[WAVE_TEX_U] = r;
+                phase[WAVE_TEX_V] = angle;
+                for (int w = 0; w < WAVE_COUNT; w++) {
+                    field(PHASE_SIN + w)[v] = sinf(phase[w]);
+                    field(PHASE_COS + w)[v] = cosf(phase[w]);
+                }
+
+                // Lo que no se mueve queda escrito en el vrtice
+                MeshVertex& vertex = vertices[v];
+                vertex.position[0] = x;
+                vertex.position[2] = z;
+                vertex.normal[1] = 1.0f;
+                vertex.color[3] = 0.65f + 0.25f * depth[v];
+            }
+        }
+
+        // Cada par de anillos es una tira de tringulos; se guardan como
+        // tringulos sueltos con el mismo sentido que tena la tira
+        indices.clear();
+        for (int i = 0; i < rings - 1; i++) {
+            for (int j = 0; j < segments; j++) {
+                GLuint a = i * (segments + 1) + j;
+                GLuint b = a + segments + 1;
+                indices.push_back(a);
+                indices.push_back(b);
+                indices.push_back(a + 1);
+                indices.push_back(a + 1);
+                indices.push_back(b);
+                indices.push_back(b + 1);
+            }
+        }
+
+        if (useBuffers) {
+            GLExtensions::genBuffers(1, &vertexBuffer);
+            GLExtensions::genBuffers(1, &indexBuffer);
+            GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+            GLExtensions::bufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint),
+                                     &indices[0], GL_STATIC_DRAW);
+            GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+
+        built = true;
+    }
+
+    void release() {
+        if (vertexBuffer) GLExtensions::deleteBuffers(1, &vertexBuffer);
+        if (indexBuffer) GLExtensions::deleteBuffers(1, &indexBuffer);
+        vertexBuffer = 0;
+        indexBuffer = 0;
+        fields.clear();
+        vertices.clear();
+        indices.clear();
+        built = false;
+    }
+
+    // Alturas, normales, colores y coordenadas de textura para el tiempo 'time'
+    void update(float time, float amplitude) {
+        if (!built) return;
+
+        static const float frequency[WAVE_COUNT] = { 2.5f, 1.8f, 3.2f, 4.1f, 1.5f, 1.0f, 1.0f };
+        float st[WAVE_COUNT];
+        float ct[WAVE_COUNT];
+        for (int w = 0; w < WAVE_COUNT; w++) {
+            st[w] = sinf(time * frequency[w]);
+            ct[w] = cosf(time * frequency[w]);
+        }
+
+#ifdef __SSE__
+        evaluateSSE(st, ct, amplitude);
+#else
+        evaluateScalar(0, vertexCount, st, ct, amplitude);
+#endif
+
+        const float* outY = field(OUT_Y);
+        const float* outNX = field(OUT_NX);
+        const float* outNZ = field(OUT_NZ);
+        const float* outR = field(OUT_R);
+        const float* outG = field(OUT_G);
+        const float* outB = field(OUT_B);
+        const float* outU = field(OUT_U);
+        const float* outV = field(OUT_V);
+        for (int i = 0; i < vertexCount; i++) {
+            MeshVertex& vertex = vertices[i];
+            vertex.position[1] = outY[i];
+            vertex.normal[0] = outNX[i];
+            vertex.normal[2] = outNZ[i];
+            vertex.color[0] = outR[i];
+            vertex.color[1] = outG[i];
+            vertex.color[2] = outB[i];
+            vertex.texCoord[0] = outU[i];
+            vertex.texCoord[1] = outV[i];
+        }
+
+        if (useBuffers) {
+            // Subir el buffer entero: el driver puede descartar el anterior
+            // aunque el frame pasado todava lo est usando
+            GLExtensions::bindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+            GLExtensions::bufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(MeshVertex),
+                                     &vertices[0], GL_STREAM_DRAW);
+            GLExtensions::bindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+    }
+
+    // Una llamada con la matriz y el estado actuales (blending lo pone quien dibuja)
+    void draw() const {
+        if (!built || indices.empty()) return;
+
+        glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+        LightingShader::begin();
+        if (useBuffers) {
+            GLExtensions::bindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+            GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+            MeshBuilder::setVertexArrays(NULL, true);
+            glDrawElements(GL_TRIANGLES, (GLsizei)indices.size(), GL_UNSIGNED_INT, NULL);
+            GLExtensions::bindBuffer(GL_ARRAY_BUFFER, 0);
+            GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        } else {
+            MeshBuilder::setVertexArrays(&vertices[0], true);
+            glDrawElements(GL_TRIANGLES, (GLsizei)indices.size(), GL_UNSIGNED_INT, &indices[0]);
+        }
+        LightingShader::end();
+        glPopClientAttrib();
+        RenderState::invalidateColor();
+    }
+
+    int getVertexCount() const {
+        return vertexCount;
+    }
+};
+
+#endif // WATERMESH_H
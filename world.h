@@ -19,8 +19,14 @@
 #include "pista.h"
 #include "muros.h"
 #include "minigame.h" // NUEVA INCLUSIN!
-
-class World {
+#include "collision.h"
+#include "staticbatch.h"
+#include "frustum.h"
+#include "renderstate.h"
+#include "renderqueue.h"
+#include "texture.h"
+
+class World : public Drawable {
 private:
     CasaJaimito casa;
     CasaClotilde casaclotilde;
@@ -34,12 +40,25 @@ private:
 
     // Vector de carros animados
     AnimationCar miCarro;    
+    std::vector<int> carCollisionIds; // Cuerpos dinmicos de los carros en el CollisionSystem
     Pista pista;
     Muros muros;
     
     // Instancia del MiniGame
     MiniGame minigame; // NUEVA INSTANCIA!
     
+    // Casas, escalera, muros y pista horneados en coordenadas de mundo
+    StaticBatch staticBatch;
+    
+    // Terreno, su cara inferior y la grilla
+    StaticBatch terrainBatch;
+    
+    // Lo que se dibuja en el frame, ordenado por estado y profundidad
+    RenderQueue renderQueue;
+    
+    // Objetos que quedaron fuera de la cmara en el ltimo render()
+    int culledObjects;
+    
     GLuint terrainTexture;
     bool textureLoaded;
     
@@ -84,7 +103,7 @@ private:
         // Crear textura OpenGL
         GLuint textureID;
         glGenTextures(1, &textureID);
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        RenderState::bindTexture(textureID);
 
         // Los archivos BMP estn en formato BGR, necesitamos convertir a RGB
         for (unsigned int i = 0; i < imageSize; i += 3) {
@@ -93,11 +112,10 @@ private:
             data[i + 2] = temp;
         }
 
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+        // Con mipmaps: el terreno se repite hasta 500 unidades y de lejos se vea con ruido
+        TextureManager::uploadMipmapped(data, width, height);
 
         // Configurar parmetros de textura
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
@@ -108,7 +126,7 @@ private:
     void drawCube(float x, float y, float z, float size, float r, float g, float b) {
         glPushMatrix();
         glTranslatef(x, y + size * 0.5f, z);
-        glColor3f(r, g, b);
+        RenderState::color(r, g, b);
 
         float s = size * 0.5f;
 
@@ -160,23 +178,19 @@ private:
         glPopMatrix();
     }
 
-    void drawTerrainTile(float x, float z, float size, float r, float g, float b) {
-        glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);
-
-        glDisable(GL_CULL_FACE);
-        glDisable(GL_LIGHTING);
-
+    // Cara de arriba (con la textura del terreno si est cargada) y cara de abajo
+    void buildTerrainTile(MeshBuilder& mesh, float x, float z, float size, float r, float g, float b) {
         // Habilitar textura si est cargada
         if (textureLoaded) {
-            glEnable(GL_TEXTURE_2D);
-            glBindTexture(GL_TEXTURE_2D, terrainTexture);
-            glColor3f(1.0f, 1.0f, 1.0f); // Color blanco para que la textura se vea sin tinte
+            mesh.bindTexture(terrainTexture);
+            mesh.color(1.0f, 1.0f, 1.0f); // Color blanco para que la textura se vea sin tinte
         } else {
-            glColor3f(r, g, b);
+            mesh.bindTexture(0);
+            mesh.color(r, g, b);
         }
 
-        glBegin(GL_QUADS);
-        glNormal3f(0.0f, 1.0f, 0.0f);
+        mesh.begin(GL_QUADS);
+        mesh.normal(0.0f, 1.0f, 0.0f);
         
         // Coordenadas de textura que se repiten cada cierto nmero de tiles
         float texScale = 0.1f; // Ajusta este valor para controlar la repeticin de la textura
@@ -185,46 +199,37 @@ private:
         float u2 = (x + size) * texScale;
         float v2 = (z + size) * texScale;
         
-        if (textureLoaded) {
-            glTexCoord2f(u1, v1); glVertex3f(x, -0.1f, z);
-            glTexCoord2f(u2, v1); glVertex3f(x + size, -0.1f, z);
-            glTexCoord2f(u2, v2); glVertex3f(x + size, -0.1f, z + size);
-            glTexCoord2f(u1, v2); glVertex3f(x, -0.1f, z + size);
-        } else {
-            glVertex3f(x, -0.1f, z);
-            glVertex3f(x + size, -0.1f, z);
-            glVertex3f(x + size, -0.1f, z + size);
-            glVertex3f(x, -0.1f, z + size);
-        }
-        glEnd();
+        mesh.texCoord(u1, v1); mesh.vertex(x, -0.1f, z);
+        mesh.texCoord(u2, v1); mesh.vertex(x + size, -0.1f, z);
+        mesh.texCoord(u2, v2); mesh.vertex(x + size, -0.1f, z + size);
+        mesh.texCoord(u1, v2); mesh.vertex(x, -0.1f, z + size);
+        mesh.end();
 
         // Cara inferior sin textura
-        glDisable(GL_TEXTURE_2D);
-        glColor3f(r * 0.8f, g * 0.8f, b * 0.8f); // Un poco ms oscuro
-        glBegin(GL_QUADS);
-        glNormal3f(0.0f, -1.0f, 0.0f);
-        glVertex3f(x, -0.2f, z);
-        glVertex3f(x, -0.2f, z + size);
-        glVertex3f(x + size, -0.2f, z + size);
-        glVertex3f(x + size, -0.2f, z);
-        glEnd();
-
-        glPopAttrib();
+        mesh.bindTexture(0);
+        mesh.color(r * 0.8f, g * 0.8f, b * 0.8f); // Un poco ms oscuro
+        mesh.begin(GL_QUADS);
+        mesh.normal(0.0f, -1.0f, 0.0f);
+        mesh.vertex(x, -0.2f, z);
+        mesh.vertex(x, -0.2f, z + size);
+        mesh.vertex(x + size, -0.2f, z + size);
+        mesh.vertex(x + size, -0.2f, z);
+        mesh.end();
     }
 
     void drawSkybox() {
-        glPushAttrib(GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT);
+        RenderState::pushAttrib(GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT);
 
-        glDisable(GL_LIGHTING);
-        glDisable(GL_DEPTH_TEST);
-        glDisable(GL_CULL_FACE);
-        glDisable(GL_TEXTURE_2D);
+        RenderState::disable(GL_LIGHTING);
+        RenderState::disable(GL_DEPTH_TEST);
+        RenderState::disable(GL_CULL_FACE);
+        RenderState::disable(GL_TEXTURE_2D);
 
         glPushMatrix();
 
         float skySize = 200.0f;
 
-        glColor3f(0.5f, 0.7f, 1.0f);
+        RenderState::color(0.5f, 0.7f, 1.0f);
         glBegin(GL_QUADS);
         glVertex3f(-skySize, skySize, -skySize);
         glVertex3f(skySize, skySize, -skySize);
@@ -233,46 +238,49 @@ private:
         glEnd();
 
         glBegin(GL_QUADS);
-        glColor3f(0.7f, 0.8f, 1.0f);
+        RenderState::color(0.7f, 0.8f, 1.0f);
         glVertex3f(-skySize, -skySize, skySize);
         glVertex3f(skySize, -skySize, skySize);
-        glColor3f(0.5f, 0.7f, 1.0f);
+        RenderState::color(0.5f, 0.7f, 1.0f);
         glVertex3f(skySize, skySize, skySize);
         glVertex3f(-skySize, skySize, skySize);
 
-        glColor3f(0.7f, 0.8f, 1.0f);
+        RenderState::color(0.7f, 0.8f, 1.0f);
         glVertex3f(-skySize, -skySize, -skySize);
         glVertex3f(-skySize, skySize, -skySize);
-        glColor3f(0.5f, 0.7f, 1.0f);
+        RenderState::color(0.5f, 0.7f, 1.0f);
         glVertex3f(skySize, skySize, -skySize);
         glVertex3f(skySize, -skySize, -skySize);
 
-        glColor3f(0.7f, 0.8f, 1.0f);
+        RenderState::color(0.7f, 0.8f, 1.0f);
         glVertex3f(-skySize, -skySize, -skySize);
         glVertex3f(-skySize, -skySize, skySize);
-        glColor3f(0.5f, 0.7f, 1.0f);
+        RenderState::color(0.5f, 0.7f, 1.0f);
         glVertex3f(-skySize, skySize, skySize);
         glVertex3f(-skySize, skySize, -skySize);
 
-        glColor3f(0.7f, 0.8f, 1.0f);
+        RenderState::color(0.7f, 0.8f, 1.0f);
         glVertex3f(skySize, -skySize, -skySize);
         glVertex3f(skySize, skySize, -skySize);
-        glColor3f(0.5f, 0.7f, 1.0f);
+        RenderState::color(0.5f, 0.7f, 1.0f);
         glVertex3f(skySize, skySize, skySize);
         glVertex3f(skySize, -skySize, skySize);
         glEnd();
 
         glPopMatrix();
-        glPopAttrib();
+        RenderState::popAttrib();
     }
 
-    void drawExtendedTerrain() {
+    // Terreno de 20x20 tiles y su grilla, grabados una sola vez: queda un
+    // material para la cara de arriba, otro para la de abajo y otro para las lneas
+    void buildTerrain() {
         const float terrainSize = 500.0f;
         const float tileSize = 50.0f;
         const int tilesPerSide = (int)(terrainSize / tileSize);
 
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(GL_LEQUAL);
+        MeshBuilder mesh;
+        mesh.cullFace(false);
+        mesh.beginObject();
 
         for (int i = -tilesPerSide; i < tilesPerSide; i++) {
             for (int j = -tilesPerSide; j < tilesPerSide; j++) {
@@ -290,38 +298,121 @@ private:
                 g = fmaxf(0.0f, fminf(1.0f, g));
                 b = fmaxf(0.0f, fminf(1.0f, b));
 
-                drawTerrainTile(x, z, tileSize, r, g, b);
+                buildTerrainTile(mesh, x, z, tileSize, r, g, b);
             }
         }
 
-        // Deshabilitar texturas para las lneas de la grilla
-        glDisable(GL_TEXTURE_2D);
-        
-        glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_LINE_BIT);
-
-        glDisable(GL_LIGHTING);
-        glDisable(GL_CULL_FACE);
-        glColor3f(0.5f, 0.5f, 0.5f); // Color plomo/gris
-        glLineWidth(1.0f); // Lneas ms delgadas
+        // Grilla sin textura
+        mesh.bindTexture(0);
+        mesh.color(0.5f, 0.5f, 0.5f); // Color plomo/gris
+        mesh.lineWidth(1.0f); // Lneas ms delgadas
 
-        glBegin(GL_LINES);
+        mesh.begin(GL_LINES);
         for (int i = -tilesPerSide; i <= tilesPerSide; i++) {
             float x = i * tileSize;
-            glVertex3f(x, -0.25f, -terrainSize); // Ms abajo para que no interfieran
-            glVertex3f(x, -0.25f, terrainSize);
+            mesh.vertex(x, -0.25f, -terrainSize); // Ms abajo para que no interfieran
+            mesh.vertex(x, -0.25f, terrainSize);
         }
         for (int j = -tilesPerSide; j <= tilesPerSide; j++) {
             float z = j * tileSize;
-            glVertex3f(-terrainSize, -0.25f, z);
-            glVertex3f(terrainSize, -0.25f, z);
+            mesh.vertex(-terrainSize, -0.25f, z);
+            mesh.vertex(terrainSize, -0.25f, z);
         }
-        glEnd();
+        mesh.end();
+
+        mesh.endObject();
+        terrainBatch.build(mesh);
+        terrainBatch.setLighting(false); // El terreno y la grilla no se iluminan
+    }
+
+    // Grabar en coordenadas de mundo todo lo que nunca se mueve, con las mismas
+    // transformaciones con que se dibujaba cada objeto. Se graba en el orden en
+    // que se dibujaban: el color, la normal, el brillo y el culling se arrastran
+    // de un objeto al siguiente igual que en modo inmediato.
+    void buildStaticBatch() {
+        MeshBuilder mesh;
+
+        // Jaimito House
+        mesh.beginObject();
+        mesh.pushMatrix();
+        mesh.translate(8.0f, 3.0f, -3.3f);
+        casa.buildGeometry(mesh);
+        mesh.popMatrix();
+        mesh.endObject();
+
+        // Clotilde House
+        mesh.beginObject();
+        mesh.pushMatrix();
+        mesh.translate(25.0f, 0.0f, -6.0f);
+        mesh.scale(1.4f, 1.4f, 1.4f);
+        mesh.rotate(-90.0f, 0.0f, 1.0f, 0.0f);
+        casaclotilde.buildGeometry(mesh);
+        mesh.popMatrix();
+        mesh.endObject();
+
+        // Florinda House
+        mesh.beginObject();
+        mesh.pushMatrix();
+        mesh.translate(15.0f, 1.69f, -9.0f);
+        mesh.scale(0.9f, 0.9f, 0.9f);
+        casaflorinda.grabarGeometria(mesh);
+        mesh.popMatrix();
+        mesh.endObject();
+
+        // Ramon House
+        mesh.beginObject();
+        mesh.pushMatrix();
+        mesh.translate(26.0f, 0.0f, 7.9f);
+        mesh.rotate(-90.0f, 0.0f, 1.0f, 0.0f);
+        mesh.scale(0.9f, 0.9f, 0.9f);
+        casaramon.buildGeometry(mesh);
+        mesh.popMatrix();
+        mesh.endObject();
+
+        // Escalera
+        mesh.beginObject();
+        mesh.pushMatrix();
+        mesh.translate(8.0f, 0.0f, 4.0f);
+        mesh.scale(0.74f, 0.74f, 0.74f);
+        escalera.buildGeometry(mesh);
+        mesh.popMatrix();
+        mesh.endObject();
+
+        // Muros. No tienen normales propias: usaban la (0, 0, 1) que quedaba de la pileta
+        mesh.normal(0.0f, 0.0f, 1.0f);
+        mesh.beginObject();
+        mesh.pushMatrix();
+        mesh.translate(32.0f, -0.1f, 0.0f);
+        mesh.rotate(-90.0f, 0.0f, 1.0f, 0.0f);
+        mesh.scale(1.34f, 1.34f, 1.34f);
+        muros.buildGeometry(mesh);
+        mesh.popMatrix();
+        mesh.endObject();
+
+        // Pista
+        mesh.beginObject();
+        mesh.pushMatrix();
+        mesh.translate(38.0f, 0.0f, 0.0f);
+        pista.buildGeometry(mesh);
+        mesh.popMatrix();
+        mesh.endObject();
+
+        staticBatch.build(mesh);
+        printf("Batch estatico: %d objetos en %d materiales\n",
+               staticBatch.getObjectCount(), (int)mesh.getBuckets().size());
+    }
 
-        glPopAttrib();
+    // Esfera envolvente contra la cmara; si no se ve, cuenta como descartado
+    bool isVisible(const Frustum& frustum, float x, float y, float z, float radius) {
+        if (frustum.sphereVisible(x, y, z, radius)) {
+            return true;
+        }
+        culledObjects++;
+        return false;
     }
 
 public:
-    World() : textureLoaded(false) {
+    World() : culledObjects(0), textureLoaded(false) {
         // Inicializar semilla aleatoria
         srand(static_cast<unsigned>(time(0)));
         
@@ -344,7 +435,7 @@ public:
     ~World() {
         // Liberar la textura si fue cargada
         if (textureLoaded) {
-            glDeleteTextures(1, &terrainTexture);
+            TextureManager::deleteTexture(terrainTexture);
         }
     }
     
@@ -356,112 +447,153 @@ public:
         miCarro.update(); // Actualizar el carro tambin
     }
 
+    // Mover las cajas de colisin de los carros a su posicin actual. La primera
+    // vez se registran como cuerpos dinmicos; el BVH esttico no se reconstruye.
+    void syncCarCollisions(CollisionSystem* collisionSystem) {
+        if (!collisionSystem) return;
+
+        // Medidas del modelo de Car (ruedas incluidas) y la misma traslacin que en render()
+        const float CAR_WIDTH = 2.0f;
+        const float CAR_HEIGHT = 1.8f;
+        const float CAR_LENGTH = 3.8f;
+        const float CAR_CENTER_Y = -0.1f;
+        const float TRACK_OFFSET_X = 38.0f;
+        const float CAR_OFFSET_Y = 0.9f;
+
+        if (carCollisionIds.empty()) {
+            for (int i = 0; i < miCarro.getNumCars(); i++) {
+                carCollisionIds.push_back(collisionSystem->addDynamicBox(0.0f, 0.0f, 0.0f,
+                                                                         CAR_WIDTH, CAR_HEIGHT, CAR_LENGTH));
+            }
+        }
+
+        for (int i = 0; i < miCarro.getNumCars(); i++) {
+            // Los carros solo giran en mltiplos de 90 grados: a 90 y 270 el largo queda en X
+            bool sideways = fmod(miCarro.getCarAngle(i), 180.0f) != 0.0f;
+            collisionSystem->setDynamicExtents(carCollisionIds[i],
+                                               sideways ? CAR_LENGTH : CAR_WIDTH,
+                                               CAR_HEIGHT,
+                                               sideways ? CAR_WIDTH : CAR_LENGTH);
+            collisionSystem->setDynamicPosition(carCollisionIds[i],
+                                                TRACK_OFFSET_X + miCarro.getCarPosX(i),
+                                                CAR_OFFSET_Y + CAR_CENTER_Y,
+                                                miCarro.getCarPosZ(i));
+        }
+    }
+
+    // Piezas propias de World en la cola
+    enum Part {
+        PART_MINIGAME
+    };
+
+    virtual void drawPart(int part) {
+        if (part == PART_MINIGAME) {
+            // El minijuego no debe ser afectado por la luz
+            RenderState::disable(GL_LIGHTING);
+            minigame.render();
+            RenderState::enable(GL_LIGHTING);
+        }
+    }
+
+    // El cielo va primero y limpia la profundidad; todo lo dems se anota en
+    // la cola y se dibuja ordenado: terreno sin luz, opacos por textura y de
+    // adelante hacia atrs, el agua de la pileta de atrs hacia adelante y al
+    // final el minijuego. Cada pieza deja el estado como lo encontr.
     void render() {
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(GL_LESS);
+        // La modelview todava es la de la cmara: los planos quedan en coordenadas de mundo
+        Frustum frustum;
+        culledObjects = 0;
+
+        RenderState::enable(GL_DEPTH_TEST);
+        RenderState::depthFunc(GL_LESS);
 
         drawSkybox();
 
         glClear(GL_DEPTH_BUFFER_BIT);
 
-        drawExtendedTerrain();
-
-        // Deshabilitar texturas para los objetos que no las usan
-        glDisable(GL_TEXTURE_2D);
-
-        // Enable lighting for lit objects like cubes and the house
-        glEnable(GL_LIGHTING);
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
+        // Terreno y grilla
+        if (!terrainBatch.isBuilt()) {
+            buildTerrain();
+        }
+        terrainBatch.submit(renderQueue);
 
-        // Draw Jaimito House
-        glPushMatrix();
-        glTranslatef(8.0f, 3.0f, -3.3f);
-        
-        casa.render();
-        glPopMatrix();
-        
-        // Draw Clotilde House
-        glPushMatrix();
-        glTranslatef(25.0f, 0.0f, -6.0f);
-        glScalef(1.4f, 1.4f,1.4f);
-        glRotatef(-90.0f, 0.0f, 1.0f, 0.0f);
-        casaclotilde.render();
-        glPopMatrix();
-        
-        // Draw Florinda House
-        glPushMatrix();
-        glTranslatef(15.0f, 1.69f, -9.0f);
-        glScalef(0.9f, 0.9f, 0.9f);
-        casaflorinda.render();
-        glPopMatrix();
-        
-        // Draw Ramon House
-        glPushMatrix();
-        glTranslatef(26.0f, 0.0f, 7.9f);
-        glRotatef(-90.0f, 0.0f, 1.0f, 0.0f);
-        glScalef(0.9f, 0.9f, 0.9f);
-        casaramon.render();
-        glPopMatrix();
-        
-        // Draw Barril
-        glPushMatrix();
-        glTranslatef(10.0f, 0.5f, 2.0f);
-        glScalef(0.64f, 0.64f, 0.64f);
-        barril.render();
-        glPopMatrix();
-        
-        // Draw Pelota
-        glPushMatrix();
-        glTranslatef(14.0f, 0.3f, 0.0f);
-        glScalef(0.34f, 0.34f, 0.34f);
-        pelota.render();
-        glPopMatrix();
+        // Casas, escalera, muros y pista: una pieza por material
+        if (!staticBatch.isBuilt()) {
+            buildStaticBatch();
+        }
+        for (int i = 0; i < staticBatch.getObjectCount(); i++) {
+            const MeshObject& object = staticBatch.getObject(i);
+            bool visible = frustum.boxVisible(object.minX, object.minY, object.minZ,
+                                              object.maxX, object.maxY, object.maxZ);
+            staticBatch.setObjectVisible(i, visible);
+            if (!visible) culledObjects++;
+        }
+        staticBatch.submit(renderQueue);
         
-        // Draw Escalera
-        glPushMatrix();
-        glTranslatef(8.0f, 0.0f, 4.0f);
-        glScalef(0.74f, 0.74f, 0.74f);
-        escalera.render();
-        glPopMatrix();
+        // Barril (alto 2 y radio 0.8 a escala 0.64)
+        if (isVisible(frustum, 10.0f, 0.5f, 2.0f, 0.83f)) {
+            glPushMatrix();
+            glTranslatef(10.0f, 0.5f, 2.0f);
+            glScalef(0.64f, 0.64f, 0.64f);
+            renderQueue.submit(&barril, 0, RenderQueue::PASS_OPAQUE, true, barril.getTextureID(), 0,
+                               0.0f, 0.0f, 0.0f);
+            glPopMatrix();
+        }
         
-        // Draw Pileta
-        glPushMatrix();
-        glTranslatef(40.0f, 0.3f, 0.0f);
-        glScalef(1.34f, 1.34f, 1.34f);
-        pileta.render();
-        glPopMatrix();
+        // Pelota
+        if (isVisible(frustum, 14.0f, 0.3f, 0.0f, 0.34f)) {
+            glPushMatrix();
+            glTranslatef(14.0f, 0.3f, 0.0f);
+            glScalef(0.34f, 0.34f, 0.34f);
+            renderQueue.submit(&pelota, 0, RenderQueue::PASS_OPAQUE, true, pelota.getTextureID(), 0,
+                               0.0f, 0.0f, 0.0f);
+            glPopMatrix();
+        }
         
-        // Draw MUro
+        // Pileta (base de radio 2.8 a escala 1.34): la base es opaca, el agua transparente
+        if (isVisible(frustum, 40.0f, 0.3f, 0.0f, 4.0f)) {
+            glPushMatrix();
+            glTranslatef(40.0f, 0.3f, 0.0f);
+            glScalef(1.34f, 1.34f, 1.34f);
+            renderQueue.submit(&pileta, Pileta::PARTE_BASE, RenderQueue::PASS_OPAQUE, true,
+                               pileta.getTexturaAzulejos(), 0, 0.0f, 0.0f, 0.0f);
+            renderQueue.submit(&pileta, Pileta::PARTE_AGUA, RenderQueue::PASS_TRANSPARENT, true,
+                               0, 0, 0.0f, 0.6f, 0.0f);
+            glPopMatrix();
+        }
+
+        // Carros sobre la pista (descartan los que no se ven al dibujarse)
         glPushMatrix();
-        glTranslatef(32.0f, -0.1f, 0.0f);
-        glRotatef(-90.0f, 0.0f, 1.0f, 0.0f);
-        glScalef(1.34f, 1.34f, 1.34f);
-        muros.render();
+        glTranslatef(38.0f, 0.9f, 0.0f);
+        renderQueue.submit(&miCarro, 0, RenderQueue::PASS_OPAQUE, true, 0, 0, 0.0f, 0.0f, 0.0f);
         glPopMatrix();
 
-        glPushMatrix();
-        glTranslatef(38.0f, 0.0f, 0.0f);
-        pista.draw();
+        // Minijuego encima de todo
+        renderQueue.submit(this, PART_MINIGAME, RenderQueue::PASS_OVERLAY, false, 0, 0, 0.0f, 0.0f, 0.0f);
+
+        // Estado con el que cuenta cada pieza: el terreno dejaba la profundidad
+        // en GL_LEQUAL y la casa de Ramn dejaba el culling apagado y el brillo
+        // en 10 para todo lo que se dibujaba despus
+        RenderState::enable(GL_DEPTH_TEST);
+        RenderState::depthFunc(GL_LEQUAL);
+        RenderState::disable(GL_TEXTURE_2D);
+        RenderState::enable(GL_LIGHTING);
+        RenderState::disable(GL_CULL_FACE);
+        glCullFace(GL_BACK);
+        GLfloat shininess[] = {10.0f};
+        glMaterialfv(GL_FRONT_AND_BACK, GL_SHININESS, shininess);
 
-        // En tu loop de renderizado:
-        glPushMatrix();
-        glTranslatef(0.0f, 0.9f, 0.0f);
-        // miCarro.update(); // Mover esta actualizacin al mtodo update(playerPos, playerRadius)
-        miCarro.draw();  // Dibujar carro
+        renderQueue.execute();
+
+        culledObjects += miCarro.getCulledCount();
         miCarro.setSeparationRange(10.0f, 30.0f);
         miCarro.setSpeedRange(0.08f);
         miCarro.randomizeNow();
-        glPopMatrix();
-
-        glPopMatrix();
+    }
 
-        // Renderizar el MiniGame
-        // Es importante deshabilitar la iluminacin antes de renderizar el texto del minijuego
-        // y habilitarla de nuevo despus, ya que el texto no debe ser afectado por la luz.
-        glDisable(GL_LIGHTING); // Deshabilitar iluminacin para el UI del minijuego
-        minigame.render();      // NUEVA LNEA!
-        glEnable(GL_LIGHTING);  // Habilitar iluminacin de nuevo para el resto del mundo
+    // Cuntos objetos se saltearon en el ltimo frame por estar fuera de la cmara
+    int getCulledObjectCount() const {
+        return culledObjects;
     }
 
     // Puedes agregar getters para la informacin del minijuego si es necesario fuera de World